@@ -0,0 +1,442 @@
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+#include "Log_Filter.h"
+#include "Task_Scheduler.h"
+
+/**
+ * @brief printf-style logger that formats when the log is drained, not when it is written
+ *
+ * LOG_DEFERRED_INFO("Moving from %d to %d", from, to) copies the format
+ * string pointer and the raw argument values into a ring buffer, which costs
+ * a few dozen bytes copied and no heap. The "log" task formats and prints the
+ * buffered records at low priority, so request handlers and motion code never
+ * wait for String building or the serial port.
+ *
+ * Drained output never blocks either: a formatted line is written only as far
+ * as the output's availableForWrite() allows (on the ESP8266 UART, the free
+ * space in its 128-byte FIFO), and the rest goes out on the next drain. The
+ * output must therefore report availableForWrite(), as HardwareSerial does.
+ *
+ * - The format string must outlive the record (a string literal).
+ * - Arguments: integers, float/double, const char* and String. Strings are
+ *   copied, truncated to DEFERRED_LOG_MAX_STRING characters.
+ * - Conversions: %d %i %u %x %X %o %c %s %f %e %g and %% with flags, width
+ *   and precision; length modifiers in the format are ignored, the stored
+ *   argument type decides.
+ * - When the buffer is full new records are dropped and counted; the next
+ *   drain reports how many.
+ *
+ * The level macros follow LOG_FILTER_LEVEL like the DebugLog ones, and are
+ * not evaluated at all below it.
+ */
+
+#ifndef DEFERRED_LOG_BUFFER_BYTES
+#define DEFERRED_LOG_BUFFER_BYTES 1024
+#endif
+
+#ifndef DEFERRED_LOG_MAX_RECORD
+#define DEFERRED_LOG_MAX_RECORD 128
+#endif
+
+#ifndef DEFERRED_LOG_MAX_STRING
+#define DEFERRED_LOG_MAX_STRING 32
+#endif
+
+#ifndef DEFERRED_LOG_DRAIN_MS
+#define DEFERRED_LOG_DRAIN_MS 20
+#endif
+
+#ifndef DEFERRED_LOG_DRAIN_RECORDS
+#define DEFERRED_LOG_DRAIN_RECORDS 4
+#endif
+
+class DeferredLog {
+private:
+    enum ArgType : uint8_t {
+        ARG_INT = 0,
+        ARG_UINT = 1,
+        ARG_INT64 = 2,
+        ARG_UINT64 = 3,
+        ARG_DOUBLE = 4,
+        ARG_STRING = 5,
+    };
+
+    // Record layout: size (2), level (1), argc (1), millis (4), line (2),
+    // format pointer, file pointer, then per argument a type byte and its value
+    static const size_t HEADER_BYTES = 10 + 2 * sizeof(const char *);
+
+    /**
+     * @brief Builds one record in a stack buffer
+     */
+    struct Encoder {
+        uint8_t data[DEFERRED_LOG_MAX_RECORD];
+        size_t length = HEADER_BYTES;
+        uint8_t argc = 0;
+        bool overflow = false;
+
+        void put(const void *value, size_t size) {
+            if (length + size > sizeof(data)) {
+                overflow = true;
+                return;
+            }
+            memcpy(data + length, value, size);
+            length += size;
+        }
+
+        void type(ArgType argType) {
+            uint8_t tag = argType;
+            put(&tag, 1);
+            argc++;
+        }
+
+        void string(const char *value) {
+            size_t size = value != nullptr ? strnlen(value, DEFERRED_LOG_MAX_STRING) : 0;
+            uint8_t length8 = (uint8_t)size;
+            type(ARG_STRING);
+            put(&length8, 1);
+            put(value, size);
+        }
+    };
+
+    uint8_t Buffer[DEFERRED_LOG_BUFFER_BYTES];
+    size_t Head = 0; // oldest record
+    size_t Used = 0;
+    uint32_t Written = 0;
+    uint32_t Dropped = 0;
+    uint32_t DroppedReported = 0;
+    Print *Out = nullptr;
+    char Pending[208];       // formatted line being written
+    size_t PendingLength = 0;
+    size_t PendingSent = 0;
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    encode(Encoder &encoder, T value) {
+        typedef typename std::conditional<std::is_enum<T>::value, int, T>::type Integral;
+        if (sizeof(Integral) > 4) {
+            if (std::is_signed<Integral>::value) {
+                int64_t wide = (int64_t)value;
+                encoder.type(ARG_INT64);
+                encoder.put(&wide, sizeof(wide));
+            } else {
+                uint64_t wide = (uint64_t)value;
+                encoder.type(ARG_UINT64);
+                encoder.put(&wide, sizeof(wide));
+            }
+        } else if (std::is_signed<Integral>::value) {
+            int32_t narrow = (int32_t)value;
+            encoder.type(ARG_INT);
+            encoder.put(&narrow, sizeof(narrow));
+        } else {
+            uint32_t narrow = (uint32_t)value;
+            encoder.type(ARG_UINT);
+            encoder.put(&narrow, sizeof(narrow));
+        }
+    }
+
+    static void encode(Encoder &encoder, double value) {
+        encoder.type(ARG_DOUBLE);
+        encoder.put(&value, sizeof(value));
+    }
+
+    static void encode(Encoder &encoder, const char *value) { encoder.string(value); }
+    static void encode(Encoder &encoder, const String &value) { encoder.string(value.c_str()); }
+
+    static void encodeAll(Encoder &) {}
+
+    template <typename T, typename... Rest>
+    static void encodeAll(Encoder &encoder, const T &value, const Rest &...rest) {
+        encode(encoder, value);
+        encodeAll(encoder, rest...);
+    }
+
+    void push(const uint8_t *data, size_t length) {
+        size_t tail = (Head + Used) % DEFERRED_LOG_BUFFER_BYTES;
+        size_t first = std::min(length, DEFERRED_LOG_BUFFER_BYTES - tail);
+        memcpy(Buffer + tail, data, first);
+        memcpy(Buffer, data + first, length - first);
+        Used += length;
+    }
+
+    void pop(uint8_t *data, size_t length) {
+        size_t first = std::min(length, DEFERRED_LOG_BUFFER_BYTES - Head);
+        memcpy(data, Buffer + Head, first);
+        memcpy(data + first, Buffer, length - first);
+        Head = (Head + length) % DEFERRED_LOG_BUFFER_BYTES;
+        Used -= length;
+    }
+
+    static const char *levelName(uint8_t level) {
+        static const char *const names[] = {"", "ERROR", "WARN", "INFO", "DEBUG", "TRACE"};
+        return level < sizeof(names) / sizeof(names[0]) ? names[level] : "";
+    }
+
+    /**
+     * @brief Format the record's message into @p line
+     */
+    static void format(const uint8_t *record, size_t length, char *line, size_t size) {
+        const char *fmt;
+        memcpy(&fmt, record + 10, sizeof(fmt));
+        size_t offset = HEADER_BYTES;
+        size_t out = 0;
+        char spec[16];
+
+        while (*fmt != '\0' && out + 1 < size) {
+            if (*fmt != '%') {
+                line[out++] = *fmt++;
+                continue;
+            }
+            if (fmt[1] == '%') {
+                line[out++] = '%';
+                fmt += 2;
+                continue;
+            }
+
+            // Copy flags, width and precision, skip length modifiers
+            size_t specLength = 0;
+            spec[specLength++] = *fmt++;
+            while (*fmt != '\0' && strchr("-+ #0123456789.", *fmt) != nullptr) {
+                if (specLength < sizeof(spec) - 4) {
+                    spec[specLength++] = *fmt;
+                }
+                fmt++;
+            }
+            while (*fmt != '\0' && strchr("hlLqjzt", *fmt) != nullptr) {
+                fmt++;
+            }
+            if (*fmt == '\0') {
+                break;
+            }
+            char conversion = *fmt++;
+
+            if (offset >= length) {
+                out += snprintf(line + out, size - out, "?");
+                continue;
+            }
+            uint8_t type = record[offset++];
+            int written = 0;
+            if (type == ARG_STRING) {
+                uint8_t stringLength = record[offset++];
+                int shown = stringLength;
+                spec[specLength] = '\0';
+                // Strings are not NUL terminated in the record: pass the
+                // length as precision, capped by the format's own precision
+                const char *dot = (const char *)memchr(spec, '.', specLength);
+                if (dot != nullptr) {
+                    int precision = atoi(dot + 1);
+                    shown = std::min(shown, precision);
+                    specLength = dot - spec;
+                }
+                spec[specLength++] = '.';
+                spec[specLength++] = '*';
+                spec[specLength++] = 's';
+                spec[specLength] = '\0';
+                written = snprintf(line + out, size - out, spec, shown, (const char *)record + offset);
+                offset += stringLength;
+            } else if (type == ARG_DOUBLE) {
+                double value;
+                memcpy(&value, record + offset, sizeof(value));
+                offset += sizeof(value);
+                spec[specLength++] = strchr("eEgG", conversion) != nullptr ? conversion : 'f';
+                spec[specLength] = '\0';
+                written = snprintf(line + out, size - out, spec, value);
+            } else {
+                bool wide = type == ARG_INT64 || type == ARG_UINT64;
+                long long value;
+                if (wide) {
+                    int64_t raw;
+                    memcpy(&raw, record + offset, sizeof(raw));
+                    offset += sizeof(raw);
+                    value = raw;
+                } else {
+                    uint32_t raw;
+                    memcpy(&raw, record + offset, sizeof(raw));
+                    offset += sizeof(raw);
+                    value = type == ARG_INT ? (long long)(int32_t)raw : (long long)raw;
+                }
+                if (strchr("fFeEgG", conversion) != nullptr) {
+                    spec[specLength++] = conversion;
+                    spec[specLength] = '\0';
+                    written = snprintf(line + out, size - out, spec, (double)value);
+                } else if (conversion == 'c') {
+                    spec[specLength++] = 'c';
+                    spec[specLength] = '\0';
+                    written = snprintf(line + out, size - out, spec, (int)value);
+                } else {
+                    // 32-bit values print as long, only 64-bit ones need %ll
+                    spec[specLength++] = 'l';
+                    if (wide) {
+                        spec[specLength++] = 'l';
+                    }
+                    spec[specLength++] = strchr("uxXo", conversion) != nullptr ? conversion : 'd';
+                    spec[specLength] = '\0';
+                    if (wide) {
+                        written = snprintf(line + out, size - out, spec, value);
+                    } else if (type == ARG_INT) {
+                        written = snprintf(line + out, size - out, spec, (long)value);
+                    } else {
+                        written = snprintf(line + out, size - out, spec, (unsigned long)value);
+                    }
+                }
+            }
+            if (written > 0) {
+                out = std::min(out + (size_t)written, size - 1);
+            }
+        }
+        line[out] = '\0';
+    }
+
+public:
+    /**
+     * @brief Start printing drained records to @p out (records written before are kept)
+     */
+    void begin(Print &out) {
+        Out = &out;
+    }
+
+    /**
+     * @brief Drain the buffer from the scheduler at low priority
+     */
+    void registerTasks(TaskScheduler &scheduler) {
+        scheduler.every("log", DEFERRED_LOG_DRAIN_MS * 1000UL, TASK_PRIORITY_LOW,
+                        [this]() { drain(DEFERRED_LOG_DRAIN_RECORDS); });
+    }
+
+    /**
+     * @brief Buffer one record, use the LOG_DEFERRED_* macros instead
+     * @param fmt printf-style format, must be a string literal
+     */
+    template <typename... Args>
+    void log(uint8_t level, const char *file, uint16_t line, const char *fmt, const Args &...args) {
+        Encoder encoder;
+        encodeAll(encoder, args...);
+        if (encoder.overflow || encoder.length > DEFERRED_LOG_BUFFER_BYTES - Used) {
+            Dropped++;
+            return;
+        }
+
+        uint16_t size = (uint16_t)encoder.length;
+        uint32_t now = millis();
+        memcpy(encoder.data, &size, 2);
+        encoder.data[2] = level;
+        encoder.data[3] = encoder.argc;
+        memcpy(encoder.data + 4, &now, 4);
+        memcpy(encoder.data + 8, &line, 2);
+        memcpy(encoder.data + 10, &fmt, sizeof(fmt));
+        memcpy(encoder.data + 10 + sizeof(fmt), &file, sizeof(file));
+        push(encoder.data, encoder.length);
+        Written++;
+    }
+
+    /**
+     * @brief Format the next line to print into Pending
+     * @return false if there is nothing to print
+     */
+    bool formatNext() {
+        int length;
+        if (Dropped != DroppedReported) {
+            length = snprintf(Pending, sizeof(Pending), "[WARN] deferred log full, dropped %lu\r\n",
+                              (unsigned long)(Dropped - DroppedReported));
+            DroppedReported = Dropped;
+        } else if (Used > 0) {
+            uint8_t record[DEFERRED_LOG_MAX_RECORD];
+            uint16_t size;
+            size_t first = std::min<size_t>(2, DEFERRED_LOG_BUFFER_BYTES - Head);
+            memcpy(&size, Buffer + Head, first);
+            memcpy((uint8_t *)&size + first, Buffer, 2 - first);
+            pop(record, size);
+
+            uint32_t timestamp;
+            uint16_t lineNumber;
+            const char *file;
+            memcpy(&timestamp, record + 4, 4);
+            memcpy(&lineNumber, record + 8, 2);
+            memcpy(&file, record + 10 + sizeof(const char *), sizeof(file));
+            const char *slash = strrchr(file, '/');
+
+            char line[160];
+            format(record, size, line, sizeof(line));
+            length = snprintf(Pending, sizeof(Pending), "[%s] %lu ms %s L.%u : %s\r\n", levelName(record[2]),
+                              (unsigned long)timestamp, slash != nullptr ? slash + 1 : file, (unsigned)lineNumber, line);
+        } else {
+            return false;
+        }
+        PendingLength = std::min<size_t>(length > 0 ? length : 0, sizeof(Pending) - 1);
+        if (PendingLength > 0 && PendingLength == sizeof(Pending) - 1) {
+            memcpy(Pending + PendingLength - 2, "\r\n", 2); // truncated, still end the line
+        }
+        PendingSent = 0;
+        return true;
+    }
+
+    /**
+     * @brief Write buffered records without blocking on the output
+     * @param maxRecords Lines to start at most
+     * @return Lines completed
+     */
+    size_t drain(size_t maxRecords) {
+        if (Out == nullptr) {
+            return 0;
+        }
+        size_t printed = 0;
+        size_t started = 0;
+        while (true) {
+            if (PendingSent == PendingLength) {
+                if (started >= maxRecords || !formatNext()) {
+                    break;
+                }
+                started++;
+            }
+            int room = Out->availableForWrite();
+            if (room <= 0) {
+                break; // the rest of the line goes out on the next drain
+            }
+            size_t chunk = std::min<size_t>(room, PendingLength - PendingSent);
+            PendingSent += Out->write((const uint8_t *)Pending + PendingSent, chunk);
+            if (PendingSent == PendingLength) {
+                printed++;
+            }
+        }
+        return printed;
+    }
+
+    size_t pending() const { return Used + PendingLength - PendingSent; }
+    uint32_t writtenCount() const { return Written; }
+    uint32_t droppedCount() const { return Dropped; }
+};
+
+extern DeferredLog deferredLog;
+
+#define LOG_DEFERRED(level, ...) deferredLog.log(level, __FILE__, __LINE__, __VA_ARGS__)
+
+#if LOG_FILTER_LEVEL >= LOG_FILTER_LEVEL_ERROR
+#define LOG_DEFERRED_ERROR(...) LOG_DEFERRED(LOG_FILTER_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_DEFERRED_ERROR(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#if LOG_FILTER_LEVEL >= LOG_FILTER_LEVEL_WARN
+#define LOG_DEFERRED_WARN(...) LOG_DEFERRED(LOG_FILTER_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_DEFERRED_WARN(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#if LOG_FILTER_LEVEL >= LOG_FILTER_LEVEL_INFO
+#define LOG_DEFERRED_INFO(...) LOG_DEFERRED(LOG_FILTER_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_DEFERRED_INFO(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#if LOG_FILTER_LEVEL >= LOG_FILTER_LEVEL_DEBUG
+#define LOG_DEFERRED_DEBUG(...) LOG_DEFERRED(LOG_FILTER_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEFERRED_DEBUG(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#endif // DEFERRED_LOG_H
@@ -0,0 +1,82 @@
+#ifndef LOG_FILTER_H
+#define LOG_FILTER_H
+
+#include "DebugLog.h"
+
+/**
+ * @file Log_Filter.h
+ * @brief Compile-time level threshold for the DebugLog macros
+ *
+ * DebugLog checks the log level at run time, after the arguments have been
+ * built, so LOG_DEBUG("position " + String(p)) allocates and concatenates
+ * Strings on every call even when only INFO is printed. Include this header
+ * instead of DebugLog.h: LOG_* macros above LOG_FILTER_LEVEL are replaced by
+ * a no-op that still type-checks its arguments but never evaluates them.
+ *
+ * LOG_FILTER_LEVEL follows the DEBUGLOG_DEFAULT_LOG_LEVEL_* macro defined
+ * before the first include (INFO if none is), so the existing
+ *
+ * @code
+ * #define DEBUGLOG_DEFAULT_LOG_LEVEL_TRACE
+ * #include "Log_Filter.h"
+ * @endcode
+ *
+ * still turns everything on. LOG_SET_LEVEL() can lower the level at run time
+ * but not raise it above LOG_FILTER_LEVEL.
+ */
+
+#define LOG_FILTER_LEVEL_NONE 0
+#define LOG_FILTER_LEVEL_ERROR 1
+#define LOG_FILTER_LEVEL_WARN 2
+#define LOG_FILTER_LEVEL_INFO 3
+#define LOG_FILTER_LEVEL_DEBUG 4
+#define LOG_FILTER_LEVEL_TRACE 5
+
+#ifndef LOG_FILTER_LEVEL
+#if defined(DEBUGLOG_DEFAULT_LOG_LEVEL_TRACE)
+#define LOG_FILTER_LEVEL LOG_FILTER_LEVEL_TRACE
+#elif defined(DEBUGLOG_DEFAULT_LOG_LEVEL_DEBUG)
+#define LOG_FILTER_LEVEL LOG_FILTER_LEVEL_DEBUG
+#elif defined(DEBUGLOG_DEFAULT_LOG_LEVEL_WARN)
+#define LOG_FILTER_LEVEL LOG_FILTER_LEVEL_WARN
+#elif defined(DEBUGLOG_DEFAULT_LOG_LEVEL_ERROR)
+#define LOG_FILTER_LEVEL LOG_FILTER_LEVEL_ERROR
+#elif defined(DEBUGLOG_DEFAULT_LOG_LEVEL_NONE)
+#define LOG_FILTER_LEVEL LOG_FILTER_LEVEL_NONE
+#else
+#define LOG_FILTER_LEVEL LOG_FILTER_LEVEL_INFO // DebugLog's default
+#endif
+#endif
+
+template <typename... Args>
+inline void logFilterDiscard(const Args &...) {}
+
+// Arguments are type-checked in the dead branch but never evaluated
+#define LOG_FILTER_DISCARD(...) (true ? (void)0 : logFilterDiscard(__VA_ARGS__))
+
+#if LOG_FILTER_LEVEL < LOG_FILTER_LEVEL_TRACE
+#undef LOG_TRACE
+#define LOG_TRACE(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#if LOG_FILTER_LEVEL < LOG_FILTER_LEVEL_DEBUG
+#undef LOG_DEBUG
+#define LOG_DEBUG(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#if LOG_FILTER_LEVEL < LOG_FILTER_LEVEL_INFO
+#undef LOG_INFO
+#define LOG_INFO(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#if LOG_FILTER_LEVEL < LOG_FILTER_LEVEL_WARN
+#undef LOG_WARN
+#define LOG_WARN(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#if LOG_FILTER_LEVEL < LOG_FILTER_LEVEL_ERROR
+#undef LOG_ERROR
+#define LOG_ERROR(...) LOG_FILTER_DISCARD(__VA_ARGS__)
+#endif
+
+#endif // LOG_FILTER_H
@@ -0,0 +1,254 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <string.h>
+
+/**
+ * @brief CPU cycle accounting per loop subsystem
+ *
+ * Sections are named code paths timed with ESP.getCycleCount(): every
+ * scheduler task (stepper, focuser.temperature, store.flush, mqtt,
+ * ...) gets one automatically, the Alpaca router adds "http" for the device
+ * API handlers and main.cpp adds "loop" for the whole iteration. So a spike
+ * in "loop" can be matched with the DS18B20 poll, a flash commit or an HTTP
+ * callback.
+ *
+ * Each section keeps min/avg/max/p99 over a window of LOOP_PROFILER_WINDOW
+ * samples in fixed storage: the p99 comes from the largest
+ * LOOP_PROFILER_WINDOW / 100 + 1 samples of the window, kept sorted as they
+ * arrive. Reports show the last complete window (or the current one until
+ * the first completes) plus the largest sample since the last reset.
+ *
+ * Reports: GET /debug/profile (JSON, `?reset=1` starts over) and, for
+ * debugging builds with LOOP_PROFILER_REPORT_SECONDS set, report() on Serial.
+ */
+
+#ifndef LOOP_PROFILER_MAX_SECTIONS
+#define LOOP_PROFILER_MAX_SECTIONS 16
+#endif
+
+#ifndef LOOP_PROFILER_WINDOW
+#define LOOP_PROFILER_WINDOW 1000
+#endif
+
+// Interval of the serial report task registered by main.cpp. report() writes
+// all sections to Serial in one go, which stalls the loop it measures, so the
+// default 0 leaves reports to GET /debug/profile.
+#ifndef LOOP_PROFILER_REPORT_SECONDS
+#define LOOP_PROFILER_REPORT_SECONDS 0
+#endif
+
+#define LOOP_PROFILER_TOP (LOOP_PROFILER_WINDOW / 100 + 1)
+
+/**
+ * @brief Statistics of one window, in CPU cycles
+ */
+struct ProfilerWindow {
+    uint32_t count = 0;
+    uint32_t minCycles = 0;
+    uint32_t maxCycles = 0;
+    uint64_t totalCycles = 0;
+    uint32_t p99Cycles = 0;
+};
+
+/**
+ * @brief One timed code path
+ */
+struct ProfilerSection {
+    const char *name; // string literal, not copied
+    ProfilerWindow current;
+    uint32_t top[LOOP_PROFILER_TOP]; // largest samples of the current window, descending
+    uint8_t topCount;
+    ProfilerWindow last;             // last complete window
+    uint32_t maxEverCycles;
+    uint32_t totalCount;
+
+    /**
+     * @brief p99 of the current window (nearest rank)
+     */
+    uint32_t currentP99() const {
+        if (current.count == 0) {
+            return 0;
+        }
+        // Samples at or above the p99: n - ceil(0.99 n) + 1, at most LOOP_PROFILER_TOP
+        uint32_t fromTop = current.count - (99 * current.count + 99) / 100 + 1;
+        return top[(fromTop < topCount ? fromTop : topCount) - 1];
+    }
+};
+
+class LoopProfiler {
+private:
+    ProfilerSection Sections[LOOP_PROFILER_MAX_SECTIONS];
+    uint8_t Count = 0;
+
+    static void resetWindow(ProfilerSection &section) {
+        section.current = ProfilerWindow();
+        section.topCount = 0;
+    }
+
+    static float toMicros(uint64_t cycles) { return (float)cycles / ESP.getCpuFreqMHz(); }
+
+public:
+    /**
+     * @brief Id of the section called @p name, added on first use
+     * @param name Section name, must be a string literal
+     * @return Section id, -1 if all LOOP_PROFILER_MAX_SECTIONS are taken
+     */
+    int section(const char *name) {
+        for (uint8_t i = 0; i < Count; i++) {
+            if (strcmp(Sections[i].name, name) == 0) {
+                return i;
+            }
+        }
+        if (Count >= LOOP_PROFILER_MAX_SECTIONS) {
+            return -1;
+        }
+        ProfilerSection &section = Sections[Count];
+        section = ProfilerSection();
+        section.name = name;
+        return Count++;
+    }
+
+    /**
+     * @brief Add one sample of @p cycles to section @p id (ignored if negative)
+     */
+    void record(int id, uint32_t cycles) {
+        if (id < 0 || id >= Count) {
+            return;
+        }
+        ProfilerSection &section = Sections[id];
+        ProfilerWindow &window = section.current;
+        if (window.count == 0 || cycles < window.minCycles) {
+            window.minCycles = cycles;
+        }
+        if (cycles > window.maxCycles) {
+            window.maxCycles = cycles;
+        }
+        if (cycles > section.maxEverCycles) {
+            section.maxEverCycles = cycles;
+        }
+        window.count++;
+        window.totalCycles += cycles;
+        section.totalCount++;
+
+        // Insert into the descending top list, dropping the smallest when full
+        if (section.topCount < LOOP_PROFILER_TOP || cycles > section.top[section.topCount - 1]) {
+            uint8_t i = section.topCount < LOOP_PROFILER_TOP ? section.topCount++ : LOOP_PROFILER_TOP - 1;
+            while (i > 0 && section.top[i - 1] < cycles) {
+                section.top[i] = section.top[i - 1];
+                i--;
+            }
+            section.top[i] = cycles;
+        }
+
+        if (window.count >= LOOP_PROFILER_WINDOW) {
+            window.p99Cycles = section.currentP99();
+            section.last = window;
+            resetWindow(section);
+        }
+    }
+
+    /**
+     * @brief Forget all samples, keep the sections
+     */
+    void reset() {
+        for (uint8_t i = 0; i < Count; i++) {
+            resetWindow(Sections[i]);
+            Sections[i].last = ProfilerWindow();
+            Sections[i].maxEverCycles = 0;
+            Sections[i].totalCount = 0;
+        }
+    }
+
+    size_t size() const { return Count; }
+    const ProfilerSection &at(size_t index) const { return Sections[index]; }
+
+    /**
+     * @brief Statistics to report for section @p index: the last complete window, else the current one
+     */
+    ProfilerWindow window(size_t index) const {
+        const ProfilerSection &section = Sections[index];
+        if (section.last.count > 0) {
+            return section.last;
+        }
+        ProfilerWindow current = section.current;
+        current.p99Cycles = section.currentP99();
+        return current;
+    }
+
+    /**
+     * @brief Print one line per section (times in microseconds)
+     */
+    void report(Print &out) const {
+        char line[112];
+        snprintf(line, sizeof(line), "%-20s %10s %9s %9s %9s %9s %9s", "section", "samples", "min_us", "avg_us",
+                 "max_us", "p99_us", "peak_us");
+        out.println(line);
+        for (uint8_t i = 0; i < Count; i++) {
+            ProfilerWindow stats = window(i);
+            snprintf(line, sizeof(line), "%-20s %10lu %9.1f %9.1f %9.1f %9.1f %9.1f", Sections[i].name,
+                     (unsigned long)Sections[i].totalCount, toMicros(stats.minCycles),
+                     stats.count > 0 ? toMicros(stats.totalCycles) / stats.count : 0.0f, toMicros(stats.maxCycles),
+                     toMicros(stats.p99Cycles), toMicros(Sections[i].maxEverCycles));
+            out.println(line);
+        }
+    }
+
+    /**
+     * @brief Answer GET /debug/profile[?reset=1] with the statistics as JSON
+     */
+    void handle(AsyncWebServerRequest *request) {
+        AsyncResponseStream *response = request->beginResponseStream("application/json");
+        response->addHeader("Cache-Control", "no-store");
+        response->print("{\"cpu_mhz\":");
+        response->print((unsigned)ESP.getCpuFreqMHz());
+        response->print(",\"window\":");
+        response->print((unsigned long)LOOP_PROFILER_WINDOW);
+        response->print(",\"sections\":[");
+        for (uint8_t i = 0; i < Count; i++) {
+            ProfilerWindow stats = window(i);
+            response->print(i > 0 ? ",{\"name\":\"" : "{\"name\":\"");
+            response->print(Sections[i].name);
+            response->print("\",\"samples\":");
+            response->print((unsigned long)Sections[i].totalCount);
+            response->print(",\"window_samples\":");
+            response->print((unsigned long)stats.count);
+            response->print(",\"min_us\":");
+            response->print(toMicros(stats.minCycles), 1);
+            response->print(",\"avg_us\":");
+            response->print(stats.count > 0 ? toMicros(stats.totalCycles) / stats.count : 0.0f, 1);
+            response->print(",\"max_us\":");
+            response->print(toMicros(stats.maxCycles), 1);
+            response->print(",\"p99_us\":");
+            response->print(toMicros(stats.p99Cycles), 1);
+            response->print(",\"peak_us\":");
+            response->print(toMicros(Sections[i].maxEverCycles), 1);
+            response->print('}');
+        }
+        response->print("]}");
+        request->send(response);
+
+        if (request->hasParam("reset")) {
+            reset();
+        }
+    }
+};
+
+extern LoopProfiler loopProfiler;
+
+/**
+ * @brief Times the enclosing scope into a profiler section
+ */
+class LoopProfilerScope {
+private:
+    int Section;
+    uint32_t Start;
+
+public:
+    explicit LoopProfilerScope(int section) : Section(section), Start(ESP.getCycleCount()) {}
+    ~LoopProfilerScope() { loopProfiler.record(Section, ESP.getCycleCount() - Start); }
+};
+
+#endif // LOOP_PROFILER_H
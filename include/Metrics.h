@@ -0,0 +1,300 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <functional>
+#include <new>
+#include <vector>
+#include "Persistent_Store.h"
+#include "Task_Scheduler.h"
+
+/**
+ * @brief Counters and histograms served at /metrics in Prometheus text format
+ *
+ * Recording is a few integer operations and never allocates after the first
+ * request of an endpoint:
+ *
+ * - The Alpaca router times every handler it dispatches into the route's
+ *   MetricsEndpoint (request count, latency histogram, response bytes), so
+ *   every AplacaDevice is covered without touching its handlers. Response
+ *   bytes are reported by the shared Alpaca response writers through
+ *   noteResponseBytes().
+ * - main.cpp reports loop() iteration times, ArduinoStepper the position
+ *   steps it issues.
+ * - Heap, persistent store and scheduler figures are read when /metrics is
+ *   scraped; other components add their own families with addCollector().
+ *
+ * Histograms use fixed power-of-two buckets: the first ends at
+ * 2^METRICS_HISTOGRAM_MIN_SHIFT microseconds (64 us), each next one doubles,
+ * the last holds everything above. Times are exported in seconds.
+ */
+
+#ifndef METRICS_HISTOGRAM_BUCKETS
+#define METRICS_HISTOGRAM_BUCKETS 12
+#endif
+
+#ifndef METRICS_HISTOGRAM_MIN_SHIFT
+#define METRICS_HISTOGRAM_MIN_SHIFT 6
+#endif
+
+/**
+ * @brief Log-scale histogram of microsecond durations
+ */
+struct MetricsHistogram {
+    uint32_t buckets[METRICS_HISTOGRAM_BUCKETS] = {}; // per bucket, not cumulative
+    uint32_t count = 0;
+    uint64_t sum = 0;
+
+    static uint8_t bucketFor(uint32_t value) {
+        if (value <= (1UL << METRICS_HISTOGRAM_MIN_SHIFT)) {
+            return 0;
+        }
+        int bits = 32 - __builtin_clz(value - 1); // ceil(log2(value))
+        int index = bits - METRICS_HISTOGRAM_MIN_SHIFT;
+        return index < METRICS_HISTOGRAM_BUCKETS - 1 ? (uint8_t)index : METRICS_HISTOGRAM_BUCKETS - 1;
+    }
+
+    static uint32_t upperBound(uint8_t index) { return 1UL << (METRICS_HISTOGRAM_MIN_SHIFT + index); }
+
+    void observe(uint32_t value) {
+        buckets[bucketFor(value)]++;
+        count++;
+        sum += value;
+    }
+};
+
+/**
+ * @brief Statistics of one device API endpoint, allocated on its first request
+ */
+struct MetricsEndpoint {
+    MetricsHistogram latency;
+    uint64_t responseBytes = 0;
+};
+
+/**
+ * @brief Writes metric families in the Prometheus text exposition format
+ *
+ * Label sets are passed preformatted, e.g. `task="mqtt",id="3"`, or nullptr.
+ * All samples of a family must follow its family() line.
+ */
+class MetricsWriter {
+private:
+    Print &Out;
+
+    void series(const char *name, const char *suffix, const char *labels) {
+        Out.write(name);
+        if (suffix != nullptr) {
+            Out.write(suffix);
+        }
+        if (labels != nullptr && labels[0] != '\0') {
+            Out.write('{');
+            Out.write(labels);
+            Out.write('}');
+        }
+        Out.write(' ');
+    }
+
+    void number(uint64_t value) {
+        char digits[21];
+        size_t length = 0;
+        do {
+            digits[length++] = '0' + (char)(value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (length > 0) {
+            Out.write(digits[--length]);
+        }
+    }
+
+public:
+    explicit MetricsWriter(Print &out) : Out(out) {}
+
+    void family(const char *name, const char *type, const char *help) {
+        Out.write("# HELP ");
+        Out.write(name);
+        Out.write(' ');
+        Out.write(help);
+        Out.write("\n# TYPE ");
+        Out.write(name);
+        Out.write(' ');
+        Out.write(type);
+        Out.write('\n');
+    }
+
+    void sample(const char *name, const char *labels, uint64_t value) {
+        series(name, nullptr, labels);
+        number(value);
+        Out.write('\n');
+    }
+
+    void sample(const char *name, const char *labels, double value) {
+        series(name, nullptr, labels);
+        Out.print(value, 6);
+        Out.write('\n');
+    }
+
+    /**
+     * @brief Write the _bucket, _sum and _count series of a microsecond histogram in seconds
+     */
+    void histogram(const char *name, const char *labels, const MetricsHistogram &histogram) {
+        bool hasLabels = labels != nullptr && labels[0] != '\0';
+        uint64_t cumulative = 0;
+        for (uint8_t i = 0; i < METRICS_HISTOGRAM_BUCKETS; i++) {
+            cumulative += histogram.buckets[i];
+            Out.write(name);
+            Out.write("_bucket{");
+            if (hasLabels) {
+                Out.write(labels);
+                Out.write(',');
+            }
+            Out.write("le=\"");
+            if (i < METRICS_HISTOGRAM_BUCKETS - 1) {
+                Out.print(MetricsHistogram::upperBound(i) / 1e6, 6);
+            } else {
+                Out.write("+Inf");
+            }
+            Out.write("\"} ");
+            number(cumulative);
+            Out.write('\n');
+        }
+        series(name, "_sum", labels);
+        Out.print(histogram.sum / 1e6, 6);
+        Out.write('\n');
+        series(name, "_count", labels);
+        number(histogram.count);
+        Out.write('\n');
+    }
+};
+
+typedef std::function<void(MetricsWriter &out)> MetricsCollector;
+
+class Metrics {
+private:
+    uint32_t PendingResponseBytes = 0;
+    MetricsHistogram Loop;
+    uint32_t Steps = 0;
+    uint32_t Unrouted = 0;
+    std::vector<MetricsCollector> Collectors;
+
+    void writeScheduler(MetricsWriter &out) {
+        char labels[48];
+        out.family("scheduler_ticks_total", "counter", "Scheduler ticks");
+        out.sample("scheduler_ticks_total", nullptr, (uint64_t)taskScheduler.tickCount());
+        out.family("scheduler_over_budget_ticks_total", "counter", "Ticks that deferred a task");
+        out.sample("scheduler_over_budget_ticks_total", nullptr, (uint64_t)taskScheduler.overBudgetCount());
+
+        out.family("scheduler_task_runs_total", "counter", "Runs per periodic task");
+        for (size_t i = 0; i < taskScheduler.taskCount(); i++) {
+            const SchedulerTask &task = taskScheduler.task(i);
+            if (task.periodic) {
+                snprintf(labels, sizeof(labels), "task=\"%s\",id=\"%u\"", task.name, (unsigned)task.id);
+                out.sample("scheduler_task_runs_total", labels, (uint64_t)task.runs);
+            }
+        }
+        out.family("scheduler_task_deferrals_total", "counter", "Ticks a periodic task was due but over budget");
+        for (size_t i = 0; i < taskScheduler.taskCount(); i++) {
+            const SchedulerTask &task = taskScheduler.task(i);
+            if (task.periodic) {
+                snprintf(labels, sizeof(labels), "task=\"%s\",id=\"%u\"", task.name, (unsigned)task.id);
+                out.sample("scheduler_task_deferrals_total", labels, (uint64_t)task.deferrals);
+            }
+        }
+        out.family("scheduler_task_max_duration_seconds", "gauge", "Longest single run per periodic task");
+        for (size_t i = 0; i < taskScheduler.taskCount(); i++) {
+            const SchedulerTask &task = taskScheduler.task(i);
+            if (task.periodic) {
+                snprintf(labels, sizeof(labels), "task=\"%s\",id=\"%u\"", task.name, (unsigned)task.id);
+                out.sample("scheduler_task_max_duration_seconds", labels, task.maxMicros / 1e6);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Add a response body size to the request being timed
+     */
+    void noteResponseBytes(size_t bytes) { PendingResponseBytes += bytes; }
+
+    /**
+     * @brief Start timing a handler
+     * @return Start time for endRequest()
+     */
+    uint32_t beginRequest() {
+        PendingResponseBytes = 0;
+        return micros();
+    }
+
+    /**
+     * @brief Record a handler started with beginRequest() into @p endpoint, allocated on first use
+     */
+    void endRequest(MetricsEndpoint *&endpoint, uint32_t started) {
+        uint32_t elapsed = micros() - started;
+        if (endpoint == nullptr) {
+            endpoint = new (std::nothrow) MetricsEndpoint();
+            if (endpoint == nullptr) {
+                return;
+            }
+        }
+        endpoint->latency.observe(elapsed);
+        endpoint->responseBytes += PendingResponseBytes;
+    }
+
+    void observeLoop(uint32_t elapsedMicros) { Loop.observe(elapsedMicros); }
+    void countSteps(uint32_t steps) { Steps += steps; }
+    void countUnrouted() { Unrouted++; }
+    uint32_t unroutedCount() const { return Unrouted; }
+
+    /**
+     * @brief Add families written on every scrape, after the built-in ones
+     */
+    void addCollector(MetricsCollector collector) { Collectors.push_back(collector); }
+
+    /**
+     * @brief Write all metric families
+     */
+    void write(Print &print) {
+        MetricsWriter out(print);
+        out.family("uptime_seconds", "gauge", "Time since boot");
+        out.sample("uptime_seconds", nullptr, millis() / 1e3);
+
+        out.family("heap_free_bytes", "gauge", "Free heap");
+        out.sample("heap_free_bytes", nullptr, (uint64_t)ESP.getFreeHeap());
+        out.family("heap_max_free_block_bytes", "gauge", "Largest allocatable block");
+        out.sample("heap_max_free_block_bytes", nullptr, (uint64_t)ESP.getMaxFreeBlockSize());
+        out.family("heap_fragmentation_percent", "gauge", "Heap fragmentation");
+        out.sample("heap_fragmentation_percent", nullptr, (uint64_t)ESP.getHeapFragmentation());
+
+        out.family("loop_duration_seconds", "histogram", "loop() iteration time");
+        out.histogram("loop_duration_seconds", nullptr, Loop);
+
+        out.family("stepper_steps_total", "counter", "Position steps issued to stepper motors");
+        out.sample("stepper_steps_total", nullptr, (uint64_t)Steps);
+
+        out.family("store_commits_total", "counter", "Persistent store commits");
+        out.sample("store_commits_total", nullptr, (uint64_t)persistentStore.commitCount());
+        out.family("store_erases_total", "counter", "Persistent store flash sector erases");
+        out.sample("store_erases_total", nullptr, (uint64_t)persistentStore.eraseCount());
+        out.family("store_log_bytes", "gauge", "Bytes used in the persistent store sector");
+        out.sample("store_log_bytes", nullptr, (uint64_t)persistentStore.logBytes());
+
+        writeScheduler(out);
+
+        for (const MetricsCollector &collector : Collectors) {
+            collector(out);
+        }
+    }
+
+    /**
+     * @brief Answer a scrape
+     */
+    void handle(AsyncWebServerRequest *request) {
+        AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+        write(*response);
+        request->send(response);
+    }
+};
+
+extern Metrics metrics;
+
+#endif // METRICS_H
@@ -0,0 +1,620 @@
+#ifndef MQTT_BRIDGE_H
+#define MQTT_BRIDGE_H
+
+#include <Arduino.h>
+#include <ESPAsyncTCP.h>
+#include <lwip/dns.h>
+#include <vector>
+#include "Log_Filter.h"
+#include "Persistent_Store.h"
+#include "Task_Scheduler.h"
+#include "Metrics.h"
+#include "alpaca_api/Aplaca_Device.h"
+
+/**
+ * @brief MQTT telemetry publisher for the registered Alpaca devices
+ *
+ * Publishes the DeviceState of every added device (for the focuser:
+ * Position, IsMoving, Temperature) to a broker, so that automation can
+ * subscribe instead of polling each board over HTTP.
+ *
+ * Topics, below a configurable prefix (default "alpaca/<client id>"):
+ *
+ * - {prefix}/status: "online" / "offline", retained; "offline" is the last
+ *   will, so the broker publishes it when the board drops off.
+ * - {prefix}/state: one JSON object per publish interval holding only the
+ *   properties that changed since the last publish, grouped by device:
+ *
+ *     {"focuser/0":{"Position":1210,"IsMoving":true}}
+ *
+ *   Nothing is sent when nothing changed. After every (re)connect the first
+ *   payload carries the full state of all devices.
+ *
+ * The broker is disabled while no host is configured. The bridge speaks the
+ * few MQTT 3.1.1 packets it needs (CONNECT, PUBLISH at QoS 0, PINGREQ,
+ * DISCONNECT) over an ESPAsyncTCP connection, and nothing in it waits on the
+ * network: poll() steps a state machine from the scheduler task.
+ *
+ * - Resolving: the name goes to lwIP's asynchronous resolver; the answer
+ *   arrives in a callback. Addresses are cached by lwIP, and the result is
+ *   reused until the connection is lost or the settings change.
+ * - Connecting: the TCP connect runs in the background; CONNECT is sent
+ *   once it is up.
+ * - Handshake: waiting for the CONNACK.
+ * - Connected: publishes, and pings the broker when idle.
+ *
+ * Resolving takes at most MQTT_BRIDGE_DNS_TIMEOUT_MS, connecting plus the
+ * handshake at most MQTT_BRIDGE_CONNECT_TIMEOUT_MS; then the attempt is
+ * dropped and retried with exponential backoff (MQTT_BRIDGE_RETRY_MIN_MS up
+ * to MQTT_BRIDGE_RETRY_MAX_MS). A publish that does not fit the TCP send
+ * buffer is skipped and its state sent in full with the next one.
+ *
+ * Settings are persisted under STORE_KEY_MQTT_HOST, STORE_KEY_MQTT_PREFIX and
+ * STORE_KEY_MQTT_SETTINGS.
+ */
+
+#ifndef MQTT_BRIDGE_DEFAULT_HOST
+#define MQTT_BRIDGE_DEFAULT_HOST ""
+#endif
+
+#ifndef MQTT_BRIDGE_DEFAULT_PORT
+#define MQTT_BRIDGE_DEFAULT_PORT 1883
+#endif
+
+#ifndef MQTT_BRIDGE_INTERVAL_MS
+#define MQTT_BRIDGE_INTERVAL_MS 1000
+#endif
+
+#ifndef MQTT_BRIDGE_POLL_MS
+#define MQTT_BRIDGE_POLL_MS 50
+#endif
+
+#ifndef MQTT_BRIDGE_DNS_TIMEOUT_MS
+#define MQTT_BRIDGE_DNS_TIMEOUT_MS 5000
+#endif
+
+// TCP connect plus CONNACK
+#ifndef MQTT_BRIDGE_CONNECT_TIMEOUT_MS
+#define MQTT_BRIDGE_CONNECT_TIMEOUT_MS 5000
+#endif
+
+#ifndef MQTT_BRIDGE_RETRY_MIN_MS
+#define MQTT_BRIDGE_RETRY_MIN_MS 2000
+#endif
+
+#ifndef MQTT_BRIDGE_RETRY_MAX_MS
+#define MQTT_BRIDGE_RETRY_MAX_MS 60000
+#endif
+
+#ifndef MQTT_BRIDGE_KEEPALIVE_S
+#define MQTT_BRIDGE_KEEPALIVE_S 30
+#endif
+
+enum eMQTTSTATE {
+    MqttIdle = 0,      // waiting for the next attempt
+    MqttResolving = 1,
+    MqttConnecting = 2,
+    MqttHandshake = 3,
+    MqttConnected = 4
+};
+
+class MqttBridge {
+private:
+    static const int MQTT_HOST_LENGTH = 63;
+    static const int MQTT_PREFIX_LENGTH = 63;
+    static const uint32_t MQTT_INTERVAL_MIN_MS = 100;
+    static const uint32_t MQTT_INTERVAL_MAX_MS = 3600000;
+
+    // MQTT 3.1.1 control packet types (high nibble of the first byte)
+    static const uint8_t MQTT_CONNECT = 0x10;
+    static const uint8_t MQTT_CONNACK = 0x20;
+    static const uint8_t MQTT_PUBLISH = 0x30;
+    static const uint8_t MQTT_PINGREQ = 0xC0;
+    static const uint8_t MQTT_PINGRESP = 0xD0;
+    static const uint8_t MQTT_DISCONNECT = 0xE0;
+
+    struct Source {
+        AplacaDevice *device;
+        String key;                     // "focuser/0"
+        std::vector<String> published;  // last published value per DeviceState entry
+        bool full;                      // publish every entry next time
+    };
+
+    AsyncClient Net;
+    std::vector<Source> Sources;
+
+    String ClientId;
+    String Host;
+    uint16_t Port = MQTT_BRIDGE_DEFAULT_PORT;
+    String Prefix;
+    uint32_t IntervalMs = MQTT_BRIDGE_INTERVAL_MS;
+    String StatusTopic;
+    String StateTopic;
+
+    eMQTTSTATE State = MqttIdle;
+    unsigned long StateSince = 0;
+    bool Resolved = false;          // BrokerIP holds the address of Host
+    IPAddress BrokerIP;
+    unsigned long NextAttempt = 0;
+    uint32_t RetryMs = MQTT_BRIDGE_RETRY_MIN_MS;
+    unsigned long LastPublish = 0;
+    unsigned long LastSent = 0;
+    unsigned long LastReceived = 0;
+    bool PingOutstanding = false;
+    uint32_t Publishes = 0;
+    uint32_t Connects = 0;
+    String Payload;
+
+    // Set by the network callbacks, handled by poll()
+    bool DnsAnswered = false;
+    bool TcpUp = false;
+    bool TcpDown = false;
+    int ConnackCode = -1;           // return code of the CONNACK, -1 until one arrives
+
+    // Incoming packet parser: only CONNACK and PINGRESP are of interest
+    uint8_t RxHeader = 0;
+    uint32_t RxLength = 0;
+    uint32_t RxRead = 0;
+    uint8_t RxShift = 0;
+    uint8_t RxStage = 0;            // 0: header byte, 1: remaining length, 2: body
+    uint8_t RxBody[2];
+
+    void enter(eMQTTSTATE state) {
+        State = state;
+        StateSince = millis();
+    }
+
+    // Close the connection without treating it as lost
+    void drop() {
+        enter(MqttIdle);
+        Net.close(true);
+        TcpUp = TcpDown = false;
+    }
+
+    void retryLater(const String &reason) {
+        drop();
+        LOG_WARN("MQTT " + reason + ", retry in " + String(RetryMs) + " ms");
+        NextAttempt = millis() + RetryMs;
+        RetryMs = std::min<uint32_t>(RetryMs * 2, MQTT_BRIDGE_RETRY_MAX_MS);
+    }
+
+    void applySettings() {
+        if (State == MqttConnected) {
+            const uint8_t disconnect[2] = {MQTT_DISCONNECT, 0};
+            Net.write((const char *)disconnect, sizeof(disconnect));
+        }
+        drop();
+        StatusTopic = Prefix + "/status";
+        StateTopic = Prefix + "/state";
+        Resolved = false;
+        NextAttempt = millis();
+        RetryMs = MQTT_BRIDGE_RETRY_MIN_MS;
+    }
+
+    static void dnsFound(const char *name, const ip_addr_t *ipaddr, void *arg) {
+        MqttBridge *bridge = (MqttBridge *)arg;
+        // A late answer for an attempt that timed out or a host since changed is ignored
+        if (bridge->State != MqttResolving || bridge->Host != name) {
+            return;
+        }
+        if (ipaddr != nullptr) {
+            bridge->BrokerIP = IPAddress(ip4_addr_get_u32(ip_2_ip4(ipaddr)));
+            bridge->Resolved = true;
+        }
+        bridge->DnsAnswered = true;
+    }
+
+    void resolve() {
+        enter(MqttResolving);
+        DnsAnswered = false;
+        ip_addr_t address;
+        err_t err = dns_gethostbyname(Host.c_str(), &address, &MqttBridge::dnsFound, this);
+        if (err == ERR_OK) {
+            BrokerIP = IPAddress(ip4_addr_get_u32(ip_2_ip4(&address)));
+            Resolved = true;
+            DnsAnswered = true;
+        } else if (err != ERR_INPROGRESS) {
+            DnsAnswered = true;
+        }
+    }
+
+    void startConnect() {
+        LOG_DEBUG("MQTT connecting to " + Host + " (" + BrokerIP.toString() + "):" + String(Port));
+        enter(MqttConnecting);
+        TcpUp = TcpDown = false;
+        if (!Net.connect(BrokerIP, Port)) {
+            retryLater("cannot start a connection to " + BrokerIP.toString());
+        }
+    }
+
+    static size_t putLength(uint8_t *out, uint32_t length) {
+        size_t n = 0;
+        do {
+            uint8_t digit = length % 128;
+            length /= 128;
+            out[n++] = length > 0 ? (digit | 0x80) : digit;
+        } while (length > 0);
+        return n;
+    }
+
+    static size_t putString(uint8_t *out, const char *text, size_t length) {
+        out[0] = (uint8_t)(length >> 8);
+        out[1] = (uint8_t)length;
+        memcpy(out + 2, text, length);
+        return length + 2;
+    }
+
+    // Queue a whole packet, or nothing if the send buffer cannot take it
+    bool sendPacket(uint8_t header, const String &topic, const char *payload, size_t payloadLength) {
+        uint8_t head[5 + 2];
+        uint32_t remaining = 2 + topic.length() + payloadLength;
+        size_t headLength = 1 + putLength(head + 1, remaining);
+        head[0] = header;
+        head[headLength] = (uint8_t)(topic.length() >> 8);
+        head[headLength + 1] = (uint8_t)topic.length();
+        headLength += 2;
+        if (Net.space() < headLength + topic.length() + payloadLength) {
+            return false;
+        }
+        Net.add((const char *)head, headLength);
+        Net.add(topic.c_str(), topic.length());
+        Net.add(payload, payloadLength);
+        LastSent = millis();
+        return Net.send();
+    }
+
+    void sendConnect() {
+        static const char will[] = "offline";
+        uint8_t packet[5 + 10 + 3 * 2 + 255];
+        size_t bodyLength = 10 + 2 + ClientId.length() + 2 + StatusTopic.length() + 2 + (sizeof(will) - 1);
+        if (bodyLength > sizeof(packet) - 5) {
+            retryLater("client id or topic prefix too long");
+            return;
+        }
+        size_t n = 0;
+        packet[n++] = MQTT_CONNECT;
+        n += putLength(packet + n, bodyLength);
+        n += putString(packet + n, "MQTT", 4);
+        packet[n++] = 4;                // protocol level 3.1.1
+        packet[n++] = 0x02 | 0x04 | 0x20; // clean session, will, will retained (QoS 0)
+        packet[n++] = (uint8_t)(MQTT_BRIDGE_KEEPALIVE_S >> 8);
+        packet[n++] = (uint8_t)MQTT_BRIDGE_KEEPALIVE_S;
+        n += putString(packet + n, ClientId.c_str(), ClientId.length());
+        n += putString(packet + n, StatusTopic.c_str(), StatusTopic.length());
+        n += putString(packet + n, will, sizeof(will) - 1);
+        if (Net.space() < n) {
+            retryLater("send buffer too small for CONNECT");
+            return;
+        }
+        Net.add((const char *)packet, n);
+        Net.send();
+        LastSent = millis();
+        ConnackCode = -1;
+        RxStage = 0;
+        enter(MqttHandshake);
+    }
+
+    void handshakeDone() {
+        enter(MqttConnected);
+        LOG_INFO("MQTT connected to " + Host + ":" + String(Port) + " as " + ClientId);
+        Connects++;
+        RetryMs = MQTT_BRIDGE_RETRY_MIN_MS;
+        PingOutstanding = false;
+        LastReceived = millis();
+        const char online[] = "online";
+        sendPacket(MQTT_PUBLISH | 0x01, StatusTopic, online, sizeof(online) - 1);
+        for (auto &source : Sources) {
+            source.full = true;
+        }
+        LastPublish = millis() - IntervalMs; // full state right away
+    }
+
+    // Runs in the network callback: record what arrived, poll() acts on it
+    void receive(const uint8_t *data, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            uint8_t byte = data[i];
+            if (RxStage == 0) {
+                RxHeader = byte;
+                RxLength = 0;
+                RxShift = 0;
+                RxStage = 1;
+                continue;
+            }
+            if (RxStage == 1) {
+                RxLength |= (uint32_t)(byte & 0x7F) << RxShift;
+                RxShift += 7;
+                if (byte & 0x80) {
+                    continue;
+                }
+                RxRead = 0;
+                RxStage = 2;
+                if (RxLength > 0) {
+                    continue;
+                }
+            } else {
+                if (RxRead < sizeof(RxBody)) {
+                    RxBody[RxRead] = byte;
+                }
+                if (++RxRead < RxLength) {
+                    continue;
+                }
+            }
+            RxStage = 0;
+            LastReceived = millis();
+            if ((RxHeader & 0xF0) == MQTT_CONNACK) {
+                ConnackCode = RxLength >= 2 ? RxBody[1] : 255;
+            } else if ((RxHeader & 0xF0) == MQTT_PINGRESP) {
+                PingOutstanding = false;
+            }
+        }
+    }
+
+    void keepAlive(unsigned long now) {
+        const unsigned long keepAliveMs = MQTT_BRIDGE_KEEPALIVE_S * 1000UL;
+        if (PingOutstanding) {
+            if (now - LastSent >= keepAliveMs) {
+                Resolved = false; // the broker may have moved
+                retryLater("broker stopped answering");
+            }
+            return;
+        }
+        if (now - LastSent >= keepAliveMs || now - LastReceived >= keepAliveMs) {
+            const uint8_t ping[2] = {MQTT_PINGREQ, 0};
+            if (Net.space() >= sizeof(ping)) {
+                Net.add((const char *)ping, sizeof(ping));
+                Net.send();
+                LastSent = now;
+                PingOutstanding = true;
+            }
+        }
+    }
+
+    // Append the entries of @p source that differ from what was last published and remember them
+    bool renderChanges(Source &source, bool &first) {
+        const AlpacaDeviceState &state = source.device->currentDeviceState();
+        if (source.published.size() != state.size()) {
+            source.published.resize(state.size());
+            source.full = true;
+        }
+        bool any = false;
+        for (size_t i = 0; i < state.size(); i++) {
+            const StateValue &entry = state.at(i);
+            if (!source.full && source.published[i] == entry.value) {
+                continue;
+            }
+            source.published[i] = entry.value.c_str();
+            if (!any) {
+                Payload.concat(first ? "{\"" : ",\"");
+                Payload.concat(source.key);
+                Payload.concat("\":{");
+                first = false;
+            } else {
+                Payload.concat(',');
+            }
+            any = true;
+            Payload.concat('"');
+            Payload.concat(entry.name.c_str());
+            Payload.concat("\":");
+            Payload.concat(entry.value.c_str());
+        }
+        if (any) {
+            Payload.concat('}');
+        }
+        return any;
+    }
+
+    void publishChanges() {
+        Payload = "";
+        bool first = true;
+        for (auto &source : Sources) {
+            renderChanges(source, first);
+        }
+        if (first) {
+            return; // nothing changed
+        }
+        Payload.concat('}');
+
+        bool sent = sendPacket(MQTT_PUBLISH, StateTopic, Payload.c_str(), Payload.length());
+        if (sent) {
+            Publishes++;
+        } else {
+            LOG_DEBUG("MQTT send buffer full, publish skipped");
+        }
+        for (auto &source : Sources) {
+            source.full = !sent; // resend everything after a failed publish
+        }
+    }
+
+public:
+    MqttBridge() {
+        Net.onConnect([](void *arg, AsyncClient *) { ((MqttBridge *)arg)->TcpUp = true; }, this);
+        Net.onDisconnect([](void *arg, AsyncClient *) { ((MqttBridge *)arg)->TcpDown = true; }, this);
+        Net.onData([](void *arg, AsyncClient *, void *data, size_t length) {
+            ((MqttBridge *)arg)->receive((const uint8_t *)data, length);
+        }, this);
+        Net.setNoDelay(true);
+    }
+
+    /**
+     * @brief Load the settings and start connecting
+     * @param clientId MQTT client id, also the default topic prefix "alpaca/<clientId>"
+     */
+    void begin(const String &clientId) {
+        ClientId = clientId;
+        Host = MQTT_BRIDGE_DEFAULT_HOST;
+        Prefix = "alpaca/" + clientId;
+        load();
+        applySettings();
+        if (enabled()) {
+            LOG_INFO("MQTT bridge publishing to " + Host + ":" + String(Port) + " under " + Prefix);
+        } else {
+            LOG_INFO("MQTT bridge disabled (no broker configured)");
+        }
+        metrics.addCollector([this](MetricsWriter &out) { writeMetrics(out); });
+    }
+
+    /**
+     * @brief Write the connection state and publish counters
+     */
+    void writeMetrics(MetricsWriter &out) {
+        out.family("mqtt_connected", "gauge", "1 while connected to the MQTT broker");
+        out.sample("mqtt_connected", nullptr, (uint64_t)(connected() ? 1 : 0));
+        out.family("mqtt_connects_total", "counter", "Successful MQTT connects");
+        out.sample("mqtt_connects_total", nullptr, (uint64_t)Connects);
+        out.family("mqtt_publishes_total", "counter", "State payloads published");
+        out.sample("mqtt_publishes_total", nullptr, (uint64_t)Publishes);
+    }
+
+    /**
+     * @brief Load the settings from the persistent store
+     * @return true if a broker host is stored
+     */
+    bool load() {
+        String value;
+        if (persistentStore.getString(STORE_KEY_MQTT_HOST, value)) {
+            Host = value;
+        }
+        if (persistentStore.getString(STORE_KEY_MQTT_PREFIX, value) && value.length() > 0) {
+            Prefix = value;
+        }
+        uint32_t settings[2];
+        if (persistentStore.get(STORE_KEY_MQTT_SETTINGS, settings, sizeof(settings)) &&
+            settings[0] > 0 && settings[0] <= 65535 &&
+            settings[1] >= MQTT_INTERVAL_MIN_MS && settings[1] <= MQTT_INTERVAL_MAX_MS) {
+            Port = (uint16_t)settings[0];
+            IntervalMs = settings[1];
+        }
+        return Host.length() > 0;
+    }
+
+    /**
+     * @brief Validate, persist and apply new broker settings
+     * @param host Broker host name or IP, empty to disable publishing
+     * @param port Broker port
+     * @param prefix Topic prefix without trailing '/'
+     * @param intervalMs Publish interval in milliseconds
+     * @return true if the settings were valid and saved
+     */
+    bool configure(const String &host, int port, const String &prefix, long intervalMs) {
+        if (host.length() > MQTT_HOST_LENGTH || prefix.length() == 0 || prefix.length() > MQTT_PREFIX_LENGTH ||
+            prefix.endsWith("/") || prefix.indexOf('+') >= 0 || prefix.indexOf('#') >= 0) {
+            LOG_ERROR("Invalid MQTT host or topic prefix");
+            return false;
+        }
+        if (port <= 0 || port > 65535 || intervalMs < (long)MQTT_INTERVAL_MIN_MS || intervalMs > (long)MQTT_INTERVAL_MAX_MS) {
+            LOG_ERROR("Invalid MQTT port or publish interval");
+            return false;
+        }
+        Host = host;
+        Port = (uint16_t)port;
+        Prefix = prefix;
+        IntervalMs = (uint32_t)intervalMs;
+
+        uint32_t settings[2] = {Port, IntervalMs};
+        persistentStore.putString(STORE_KEY_MQTT_HOST, Host);
+        persistentStore.putString(STORE_KEY_MQTT_PREFIX, Prefix);
+        persistentStore.put(STORE_KEY_MQTT_SETTINGS, settings, sizeof(settings));
+        applySettings();
+        LOG_INFO("MQTT settings saved - broker: " + Host + ":" + String(Port) + " prefix: " + Prefix);
+        return true;
+    }
+
+    /**
+     * @brief Publish the DeviceState of @p device under @p key (default "{devicetype}/{devicenumber}")
+     */
+    void addDevice(AplacaDevice *device, const String &key = "") {
+        String name = key.length() > 0 ? key : device->GetDeviceType() + "/" + String(device->GetDeviceNumber());
+        Sources.push_back(Source{device, name, std::vector<String>(), true});
+    }
+
+    /**
+     * @brief Register the connection/publish task
+     */
+    void registerTasks(TaskScheduler &scheduler) {
+        scheduler.every("mqtt", MQTT_BRIDGE_POLL_MS * 1000UL, TASK_PRIORITY_NORMAL, [this]() { poll(); });
+    }
+
+    /**
+     * @brief Advance the connection, keep it alive and publish changes once per interval
+     * Never waits on the network.
+     */
+    void poll() {
+        if (!enabled()) {
+            return;
+        }
+        unsigned long now = millis();
+        if (TcpDown && State != MqttIdle) {
+            bool wasConnected = State == MqttConnected;
+            TcpDown = false;
+            if (wasConnected) {
+                LOG_WARN("MQTT connection lost");
+                drop();
+                Resolved = false; // the broker may have moved
+                NextAttempt = now;
+            } else {
+                retryLater("connection to " + Host + ":" + String(Port) + " failed");
+            }
+            return;
+        }
+
+        switch (State) {
+        case MqttIdle:
+            if ((long)(now - NextAttempt) >= 0) {
+                if (Resolved) {
+                    startConnect();
+                } else {
+                    resolve();
+                }
+            }
+            break;
+        case MqttResolving:
+            if (DnsAnswered) {
+                if (Resolved) {
+                    startConnect();
+                } else {
+                    retryLater("cannot resolve " + Host);
+                }
+            } else if (now - StateSince >= MQTT_BRIDGE_DNS_TIMEOUT_MS) {
+                retryLater("timeout resolving " + Host);
+            }
+            break;
+        case MqttConnecting:
+            if (TcpUp) {
+                sendConnect();
+            } else if (now - StateSince >= MQTT_BRIDGE_CONNECT_TIMEOUT_MS) {
+                retryLater("timeout connecting to " + Host + ":" + String(Port));
+            }
+            break;
+        case MqttHandshake:
+            if (ConnackCode == 0) {
+                handshakeDone();
+            } else if (ConnackCode > 0) {
+                retryLater("broker refused the connection, code " + String(ConnackCode));
+            } else if (now - StateSince >= MQTT_BRIDGE_CONNECT_TIMEOUT_MS) {
+                retryLater("no CONNACK from " + Host);
+            }
+            break;
+        case MqttConnected:
+            if (now - LastPublish >= IntervalMs) {
+                LastPublish = now;
+                publishChanges();
+            }
+            keepAlive(now);
+            break;
+        }
+    }
+
+    bool enabled() const { return Host.length() > 0; }
+    bool connected() const { return State == MqttConnected; }
+    eMQTTSTATE state() const { return State; }
+    const String &getHost() const { return Host; }
+    uint16_t getPort() const { return Port; }
+    const String &getPrefix() const { return Prefix; }
+    uint32_t getInterval() const { return IntervalMs; }
+    uint32_t publishCount() const { return Publishes; }
+    uint32_t connectCount() const { return Connects; }
+};
+
+extern MqttBridge mqttBridge;
+
+#endif // MQTT_BRIDGE_H
@@ -0,0 +1,499 @@
+#ifndef PERSISTENT_STORE_H
+#define PERSISTENT_STORE_H
+
+#include <Arduino.h>
+#include "Log_Filter.h"
+
+/**
+ * @brief Log-structured key/value store in a ring of flash sectors
+ *
+ * The ESP8266 EEPROM library erases and rewrites its whole flash sector on
+ * every commit(). This store keeps an append-only log in one sector of a
+ * ring of PERSISTENT_STORE_SECTORS instead:
+ *
+ * - Sector layout: 4-byte magic, 4-byte generation, then records until the
+ *   first erased word. The valid sector with the highest generation is the
+ *   current one.
+ * - Record: key (1 byte), length (1 byte), CRC-16 (2 bytes) over key, length
+ *   and data, then the data padded to 4 bytes. The last valid record of a key
+ *   wins, a zero-length record removes the key.
+ * - put() only updates the RAM copy. loop() appends all changed keys in one
+ *   commit, at most once per PERSISTENT_STORE_COMMIT_DELAY_MS, and unchanged
+ *   values are not written at all. Appending programs erased flash and needs
+ *   no erase.
+ * - When the log is full, the live values are compacted into the next sector
+ *   of the ring: it is erased, the records are written and the header with
+ *   the next generation goes last. Until that header is written the current
+ *   sector stays the valid one, so power loss during compaction loses
+ *   nothing, and erases are spread over the whole ring.
+ * - A record that fails its CRC (power loss during a write) ends the log; the
+ *   next commit compacts from RAM.
+ *
+ * The ring ends at the EEPROM sector; the sectors below it are taken from the
+ * end of the filesystem area, which this firmware does not use (a filesystem
+ * added later must be PERSISTENT_STORE_SECTORS - 1 sectors smaller).
+ *
+ * On first start the EEPROM sector still holds the old fixed-offset EEPROM
+ * layout, or the single-sector log of earlier firmware; either is imported
+ * once (see importLegacyLayout()).
+ */
+
+#ifndef PERSISTENT_STORE_COMMIT_DELAY_MS
+#define PERSISTENT_STORE_COMMIT_DELAY_MS 2000
+#endif
+
+#define PERSISTENT_STORE_MAX_KEYS 32
+
+#ifndef PERSISTENT_STORE_SECTORS
+#define PERSISTENT_STORE_SECTORS 2
+#endif
+#if PERSISTENT_STORE_SECTORS < 2
+#error "PERSISTENT_STORE_SECTORS must be at least 2: compaction writes to a spare sector"
+#endif
+
+/**
+ * @brief Keys of all persisted values
+ *
+ * Never renumber a key: the number is what is stored in flash.
+ */
+enum PersistentStoreKey : uint8_t {
+    STORE_KEY_STEPPER_POSITION = 1,   // int32_t
+    STORE_KEY_STEPPER_MODE = 2,       // uint8_t eSTEPMODE
+    STORE_KEY_STEPPER_PINS = 3,       // uint8_t[4]
+    STORE_KEY_STEPPER_MOTION = 4,     // int32_t max speed, int32_t acceleration
+    STORE_KEY_FOCUSER_TEMPOFFSET = 5, // double
+    STORE_KEY_FOCUSER_TEMP_PIN = 6,   // uint8_t
+    STORE_KEY_DEVICE_UNIQUEID = 7,    // 36 characters
+    STORE_KEY_WIFI_SSID = 8,          // up to 32 characters
+    STORE_KEY_WIFI_PASSWORD = 9,      // up to 63 characters
+    STORE_KEY_FOCUSER_TEMP_RESOLUTION = 10, // uint8_t, 9..12 bits
+    STORE_KEY_MQTT_HOST = 11,         // up to 63 characters, empty = disabled
+    STORE_KEY_MQTT_PREFIX = 12,       // up to 63 characters
+    STORE_KEY_MQTT_SETTINGS = 13,     // uint32_t port, uint32_t publish interval (ms)
+    STORE_KEY_FOCUSER_BACKLASH = 14,  // int32_t mode, steps, approach direction
+    STORE_KEY_FOCUSER_TEMPCOMP = 15,  // uint8_t count, 3 reserved, {float temperature, int32_t position}[16]
+    STORE_KEY_FOCUSER_TEMP_PROBES = 16, // uint8_t[3][8] DS18B20 ROM per probe role, zero = none
+    // New keys go here, below STORE_KEY_STEPPER_AXIS1; update the static_assert below
+    // Stepper axes 1..: the four STEPPER keys above (axis 0) again, in the
+    // same order, four keys per axis (see ArduinoStepper::storeKey())
+    STORE_KEY_STEPPER_AXIS1 = 32,
+};
+
+// The stepper axis block must start after the last single key
+static_assert(STORE_KEY_FOCUSER_TEMP_PROBES < STORE_KEY_STEPPER_AXIS1,
+              "PersistentStoreKey: keys overlap the stepper axis block");
+
+// Last sector of the ring: the EEPROM sector, which holds the legacy layout
+#if defined(ARDUINO_ARCH_ESP8266)
+extern "C" uint32_t _EEPROM_start;
+#define PERSISTENT_STORE_LAST_SECTOR ((((uint32_t)&_EEPROM_start - 0x40200000) / SPI_FLASH_SEC_SIZE))
+#else
+#define PERSISTENT_STORE_LAST_SECTOR (PERSISTENT_STORE_SECTORS - 1)
+#endif
+#define PERSISTENT_STORE_FIRST_SECTOR (PERSISTENT_STORE_LAST_SECTOR - (PERSISTENT_STORE_SECTORS - 1))
+
+class PersistentStore {
+private:
+    static const uint32_t MAGIC = 0x32535041;        // "APS2"
+    static const uint32_t MAGIC_SINGLE = 0x31535041; // "APS1", single-sector log without generation
+    static const size_t HEADER_SIZE = 8;
+
+    struct Entry {
+        uint8_t key;
+        uint8_t length;
+        bool dirty;
+        uint8_t *data;
+    };
+
+    Entry Entries[PERSISTENT_STORE_MAX_KEYS];
+    int EntryCount = 0;
+    uint32_t Sector = PERSISTENT_STORE_LAST_SECTOR;
+    uint32_t Generation = 0;
+    size_t WriteOffset = HEADER_SIZE;
+    bool Started = false;
+    bool Dirty = false;
+    unsigned long DirtySince = 0;
+    unsigned long Commits = 0;
+    unsigned long Erases = 0;
+
+    static size_t padded(size_t length) {
+        return (length + 3) & ~(size_t)3;
+    }
+
+    static uint16_t crc16(uint16_t crc, const uint8_t *data, size_t length) {
+        // CRC-16/CCITT-FALSE
+        while (length--) {
+            crc ^= (uint16_t)(*data++) << 8;
+            for (int i = 0; i < 8; i++) {
+                crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+            }
+        }
+        return crc;
+    }
+
+    static uint16_t recordCrc(uint8_t key, uint8_t length, const uint8_t *data) {
+        uint8_t head[2] = {key, length};
+        return crc16(crc16(0xFFFF, head, 2), data, length);
+    }
+
+    uint32_t address(size_t offset) const {
+        return Sector * SPI_FLASH_SEC_SIZE + offset;
+    }
+
+    static uint32_t nextSector(uint32_t sector) {
+        return PERSISTENT_STORE_FIRST_SECTOR + (sector - PERSISTENT_STORE_FIRST_SECTOR + 1) % PERSISTENT_STORE_SECTORS;
+    }
+
+    /**
+     * @brief Read the header of @p sector
+     * @return false if it does not start a log
+     */
+    static bool readHeader(uint32_t sector, uint32_t &generation) {
+        uint32_t header[2];
+        if (!ESP.flashRead(sector * SPI_FLASH_SEC_SIZE, header, sizeof(header)) || header[0] != MAGIC) {
+            return false;
+        }
+        generation = header[1];
+        return true;
+    }
+
+    Entry *find(uint8_t key) {
+        for (int i = 0; i < EntryCount; i++) {
+            if (Entries[i].key == key) {
+                return &Entries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const Entry *find(uint8_t key) const {
+        return const_cast<PersistentStore *>(this)->find(key);
+    }
+
+    /**
+     * @brief Set the RAM copy of a key
+     * @return false if the value was unchanged
+     */
+    bool store(uint8_t key, const void *data, size_t length) {
+        if (length > 255) {
+            LOG_ERROR("PersistentStore: value too long for key " + String(key));
+            return false;
+        }
+        Entry *entry = find(key);
+        if (entry != nullptr && entry->length == length && memcmp(entry->data, data, length) == 0) {
+            return false;
+        }
+        if (entry == nullptr) {
+            if (length == 0) {
+                return false;
+            }
+            if (EntryCount >= PERSISTENT_STORE_MAX_KEYS) {
+                LOG_ERROR("PersistentStore: too many keys");
+                return false;
+            }
+            entry = &Entries[EntryCount++];
+            entry->key = key;
+            entry->length = 0;
+            entry->data = nullptr;
+        }
+        if (entry->length != length) {
+            delete[] entry->data;
+            entry->data = length > 0 ? new uint8_t[length] : nullptr;
+            entry->length = (uint8_t)length;
+        }
+        if (length > 0) {
+            memcpy(entry->data, data, length);
+        }
+        entry->dirty = true;
+        return true;
+    }
+
+    bool appendRecord(const Entry &entry) {
+        size_t size = 4 + padded(entry.length);
+        if (WriteOffset + size > SPI_FLASH_SEC_SIZE) {
+            return false;
+        }
+        uint32_t buffer[(4 + 256) / 4];
+        uint8_t *bytes = reinterpret_cast<uint8_t *>(buffer);
+        uint16_t crc = recordCrc(entry.key, entry.length, entry.data);
+        bytes[0] = entry.key;
+        bytes[1] = entry.length;
+        bytes[2] = crc & 0xFF;
+        bytes[3] = crc >> 8;
+        memset(bytes + 4, 0xFF, size - 4);
+        if (entry.length > 0) {
+            memcpy(bytes + 4, entry.data, entry.length);
+        }
+        if (!ESP.flashWrite(address(WriteOffset), buffer, size)) {
+            return false;
+        }
+        WriteOffset += size;
+        return true;
+    }
+
+    /**
+     * @brief Write the live values to the next sector of the ring and make it current
+     * The current sector is left as it is until the ring comes back to it.
+     */
+    bool compact() {
+        uint32_t previous = Sector;
+        Sector = nextSector(previous);
+        bool written = ESP.flashEraseSector(Sector);
+        if (written) {
+            Erases++;
+        }
+        WriteOffset = HEADER_SIZE;
+        for (int i = 0; i < EntryCount && written; i++) {
+            // A removed key has no record, it is simply not carried over
+            written = Entries[i].length == 0 || appendRecord(Entries[i]);
+        }
+        // The header goes last: a sector without one is ignored by begin()
+        uint32_t header[2] = {MAGIC, Generation + 1};
+        if (!written || !ESP.flashWrite(address(0), header, sizeof(header))) {
+            LOG_ERROR("PersistentStore: compaction into sector " + String((unsigned long)Sector) + " failed");
+            // Keep the previous sector current and retry on the next commit
+            Sector = previous;
+            WriteOffset = SPI_FLASH_SEC_SIZE;
+            Dirty = true;
+            DirtySince = millis();
+            return false;
+        }
+        Generation++;
+        int kept = 0;
+        for (int i = 0; i < EntryCount; i++) {
+            if (Entries[i].length > 0) {
+                Entries[kept] = Entries[i];
+                Entries[kept++].dirty = false;
+            }
+        }
+        EntryCount = kept;
+        return true;
+    }
+
+    /**
+     * @brief Replay the log of the current sector into RAM
+     * @param start Offset of the first record
+     */
+    void replay(size_t start) {
+        uint32_t word;
+        size_t offset = start;
+        uint32_t buffer[256 / 4];
+        while (offset + 4 <= SPI_FLASH_SEC_SIZE) {
+            if (!ESP.flashRead(address(offset), &word, 4)) {
+                break;
+            }
+            if (word == 0xFFFFFFFF) {
+                WriteOffset = offset;
+                for (int i = 0; i < EntryCount; i++) {
+                    Entries[i].dirty = false;
+                }
+                return;
+            }
+            uint8_t key = word & 0xFF;
+            uint8_t length = (word >> 8) & 0xFF;
+            uint16_t crc = word >> 16;
+            size_t size = padded(length);
+            if (offset + 4 + size > SPI_FLASH_SEC_SIZE ||
+                (size > 0 && !ESP.flashRead(address(offset + 4), buffer, size)) ||
+                recordCrc(key, length, reinterpret_cast<uint8_t *>(buffer)) != crc) {
+                LOG_WARN("PersistentStore: corrupt record at offset " + String((unsigned long)offset) + ", compacting on next commit");
+                break;
+            }
+            store(key, buffer, length);
+            offset += 4 + size;
+        }
+        // Log is full or damaged: rewrite it from RAM on the next commit
+        WriteOffset = SPI_FLASH_SEC_SIZE;
+        Dirty = true;
+        DirtySince = millis();
+    }
+
+    /**
+     * @brief Import the fixed-offset layout used before this store existed
+     *
+     * 0: position (int32), 4: step mode (int32), 8: temperature offset (double),
+     * 16: UniqueID (36 chars), 52: SSID (32), 84: password (63),
+     * 147: WiFi marker 0xAA55, 149: pins (4), 153: pins marker 0xAA,
+     * 154: temperature pin, 156: max speed (int32), 160: acceleration (int32),
+     * 164: motion marker 0xAA. Values are copied as they are; each module
+     * still validates what it loads.
+     */
+    void importLegacyLayout(const uint8_t *image) {
+        int32_t position;
+        memcpy(&position, image + 0, 4);
+        if (position >= 0 && position <= 20000) {
+            store(STORE_KEY_STEPPER_POSITION, &position, 4);
+        }
+        int32_t mode;
+        memcpy(&mode, image + 4, 4);
+        if (mode >= 0 && mode <= 255) {
+            uint8_t mode8 = (uint8_t)mode;
+            store(STORE_KEY_STEPPER_MODE, &mode8, 1);
+        }
+        double tempOffset;
+        memcpy(&tempOffset, image + 8, sizeof(double));
+        if (!isnan(tempOffset) && !isinf(tempOffset)) {
+            store(STORE_KEY_FOCUSER_TEMPOFFSET, &tempOffset, sizeof(double));
+        }
+        if (image[16] != 0xFF && image[16] != 0) {
+            store(STORE_KEY_DEVICE_UNIQUEID, image + 16, 36);
+        }
+        if (image[147] == 0xAA && image[148] == 0x55) {
+            store(STORE_KEY_WIFI_SSID, image + 52, strnlen((const char *)image + 52, 32));
+            store(STORE_KEY_WIFI_PASSWORD, image + 84, strnlen((const char *)image + 84, 63));
+        }
+        if (image[153] == 0xAA) {
+            store(STORE_KEY_STEPPER_PINS, image + 149, 4);
+        }
+        if (image[154] <= 16) {
+            store(STORE_KEY_FOCUSER_TEMP_PIN, image + 154, 1);
+        }
+        if (image[164] == 0xAA) {
+            store(STORE_KEY_STEPPER_MOTION, image + 156, 8);
+        }
+    }
+
+public:
+    PersistentStore() {}
+
+    /**
+     * @brief Load the store from flash; safe to call more than once
+     */
+    void begin() {
+        if (Started) {
+            return;
+        }
+        Started = true;
+        bool found = false;
+        for (uint32_t sector = PERSISTENT_STORE_FIRST_SECTOR; sector <= PERSISTENT_STORE_LAST_SECTOR; sector++) {
+            uint32_t generation;
+            if (readHeader(sector, generation) && (!found || (int32_t)(generation - Generation) > 0)) {
+                found = true;
+                Sector = sector;
+                Generation = generation;
+            }
+        }
+        if (found) {
+            replay(HEADER_SIZE);
+            LOG_INFO("PersistentStore: loaded " + String(EntryCount) + " values from sector " + String((unsigned long)Sector) +
+                     ", log at " + String((unsigned long)WriteOffset) + " bytes");
+            return;
+        }
+
+        // Nothing in the ring yet: import what the EEPROM sector holds
+        Sector = PERSISTENT_STORE_LAST_SECTOR;
+        uint32_t image[512 / 4];
+        if (ESP.flashRead(address(0), image, sizeof(image))) {
+            if (image[0] == MAGIC_SINGLE) {
+                replay(4);
+            } else {
+                importLegacyLayout(reinterpret_cast<const uint8_t *>(image));
+            }
+        }
+        LOG_INFO("PersistentStore: initialized sector ring, imported " + String(EntryCount) + " values");
+        compact();
+    }
+
+    /**
+     * @brief Read a value
+     * @param key Key of the value
+     * @param data Destination
+     * @param length Expected length; the stored value must match it exactly
+     * @return false if the key is missing or has a different length
+     */
+    bool get(uint8_t key, void *data, size_t length) const {
+        const Entry *entry = find(key);
+        if (entry == nullptr || entry->length == 0 || entry->length != length) {
+            return false;
+        }
+        memcpy(data, entry->data, length);
+        return true;
+    }
+
+    template <typename T>
+    bool get(uint8_t key, T &value) const {
+        return get(key, &value, sizeof(T));
+    }
+
+    /**
+     * @brief Read a string value
+     * @return false if the key is missing
+     */
+    bool getString(uint8_t key, String &value) const {
+        const Entry *entry = find(key);
+        if (entry == nullptr || entry->length == 0) {
+            return false;
+        }
+        value = String((const char *)entry->data, entry->length);
+        return true;
+    }
+
+    /**
+     * @brief Change a value; it is written by the next commit
+     */
+    void put(uint8_t key, const void *data, size_t length) {
+        if (store(key, data, length) && !Dirty) {
+            Dirty = true;
+            DirtySince = millis();
+        }
+    }
+
+    template <typename T>
+    void put(uint8_t key, const T &value) {
+        put(key, &value, sizeof(T));
+    }
+
+    void putString(uint8_t key, const String &value) {
+        put(key, value.c_str(), value.length());
+    }
+
+    /**
+     * @brief Delete a value
+     */
+    void remove(uint8_t key) {
+        put(key, nullptr, 0);
+    }
+
+    /**
+     * @brief Commit pending changes once the coalescing window has passed
+     * Call this from loop().
+     */
+    void loop() {
+        if (Dirty && millis() - DirtySince >= PERSISTENT_STORE_COMMIT_DELAY_MS) {
+            commit();
+        }
+    }
+
+    /**
+     * @brief Write all pending changes now (e.g. before a restart)
+     * @return true on success
+     */
+    bool commit() {
+        if (!Dirty) {
+            return true;
+        }
+        Dirty = false;
+        Commits++;
+        if (WriteOffset >= SPI_FLASH_SEC_SIZE) {
+            return compact(); // log full or damaged
+        }
+        for (int i = 0; i < EntryCount; i++) {
+            if (Entries[i].dirty) {
+                if (!appendRecord(Entries[i])) {
+                    return compact();
+                }
+                Entries[i].dirty = false;
+            }
+        }
+        return true;
+    }
+
+    bool isDirty() const { return Dirty; }
+    unsigned long commitCount() const { return Commits; }
+    unsigned long eraseCount() const { return Erases; }
+    size_t logBytes() const { return WriteOffset; }
+};
+
+extern PersistentStore persistentStore;
+
+#endif // PERSISTENT_STORE_H
@@ -0,0 +1,237 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include "Log_Filter.h"
+#include "Loop_Profiler.h"
+
+/**
+ * @brief Cooperative scheduler for everything loop() has to do
+ *
+ * Devices and main.cpp register short, non-blocking tasks instead of being
+ * called unconditionally from loop():
+ *
+ * - every(): periodic task, run again @p intervalMicros after its last due
+ *   time (0 = on every tick).
+ * - after(): one-shot deadline task, run once when the delay has passed.
+ *
+ * tick() runs the due tasks in priority order. TASK_PRIORITY_CRITICAL tasks
+ * (stepper phases) always run. The other tasks share a per-tick budget: once
+ * it is spent, the remaining due tasks are deferred to the next tick. At
+ * least one non-critical task runs on every tick, picking the one deferred
+ * most often, so a slow or always-due task cannot starve a lower priority
+ * one forever.
+ *
+ * Times are in microseconds and compared with wrap-around safe arithmetic.
+ * Every periodic task is also a loopProfiler section of the same name.
+ */
+
+#ifndef TASK_SCHEDULER_BUDGET_US
+#define TASK_SCHEDULER_BUDGET_US 2000
+#endif
+
+enum TaskPriority : uint8_t {
+    TASK_PRIORITY_LOW = 0,      // housekeeping: persistence, statistics
+    TASK_PRIORITY_NORMAL = 1,   // sensor polls, network services
+    TASK_PRIORITY_HIGH = 2,     // simulated motion, user visible state
+    TASK_PRIORITY_CRITICAL = 3, // motion control, never deferred
+};
+
+typedef std::function<void()> TaskCallback;
+
+/**
+ * @brief One registered task and its run statistics
+ */
+struct SchedulerTask {
+    uint16_t id;
+    const char *name;           // string literal, not copied
+    TaskPriority priority;
+    bool periodic;
+    bool active;
+    uint32_t intervalMicros;
+    uint32_t dueMicros;
+    TaskCallback callback;
+
+    uint32_t runs;
+    uint32_t deferrals;         // total ticks the task was due but over budget
+    uint16_t pendingDeferrals;  // consecutive deferrals, reset when it runs
+    uint32_t maxMicros;         // longest single run
+    int8_t profile;             // loopProfiler section, -1 if none
+};
+
+class TaskScheduler {
+private:
+    std::vector<SchedulerTask> Tasks; // sorted by priority, highest first
+    std::vector<SchedulerTask> Added; // registered during tick(), merged afterwards
+    uint32_t BudgetMicros = TASK_SCHEDULER_BUDGET_US;
+    uint16_t NextId = 1;
+    uint32_t Ticks = 0;
+    uint32_t OverBudgetTicks = 0;
+    bool Running = false;
+    bool HasFinished = false;
+
+    static bool isDue(const SchedulerTask &task, uint32_t now) {
+        return task.active && (int32_t)(now - task.dueMicros) >= 0;
+    }
+
+    int add(const char *name, uint32_t delayMicros, uint32_t intervalMicros, bool periodic,
+            TaskPriority priority, TaskCallback callback) {
+        SchedulerTask task = {NextId++, name, priority, periodic, true, intervalMicros,
+                              (uint32_t)(micros() + delayMicros), callback, 0, 0, 0, 0,
+                              (int8_t)(periodic ? loopProfiler.section(name) : -1)};
+        if (Running) {
+            Added.push_back(task);
+        } else {
+            insert(task);
+        }
+        LOG_DEBUG("Task registered: " + String(name));
+        return task.id;
+    }
+
+    void insert(const SchedulerTask &task) {
+        auto pos = std::upper_bound(Tasks.begin(), Tasks.end(), task,
+                                    [](const SchedulerTask &a, const SchedulerTask &b) { return a.priority > b.priority; });
+        Tasks.insert(pos, task);
+    }
+
+    void run(SchedulerTask &task, uint32_t now) {
+        uint32_t start = micros();
+        uint32_t startCycles = ESP.getCycleCount();
+        task.callback();
+        loopProfiler.record(task.profile, ESP.getCycleCount() - startCycles);
+        uint32_t elapsed = micros() - start;
+
+        task.runs++;
+        task.pendingDeferrals = 0;
+        if (elapsed > task.maxMicros) {
+            task.maxMicros = elapsed;
+        }
+        if (!task.periodic) {
+            task.active = false;
+            HasFinished = true;
+            return;
+        }
+        // Keep the cadence, but do not replay missed runs after a stall
+        task.dueMicros += task.intervalMicros;
+        if ((int32_t)(now - task.dueMicros) > (int32_t)task.intervalMicros) {
+            task.dueMicros = now + task.intervalMicros;
+        }
+    }
+
+public:
+    /**
+     * @brief Register a periodic task
+     * @param name Task name for statistics, must be a string literal
+     * @param intervalMicros Period in microseconds, 0 to run on every tick
+     * @param priority Scheduling priority
+     * @param callback Work to do, must return quickly
+     * @return Task id for cancel()
+     */
+    int every(const char *name, uint32_t intervalMicros, TaskPriority priority, TaskCallback callback) {
+        return add(name, 0, intervalMicros, true, priority, callback);
+    }
+
+    /**
+     * @brief Register a one-shot task
+     * @param name Task name for statistics, must be a string literal
+     * @param delayMicros Delay from now in microseconds
+     * @param priority Scheduling priority
+     * @param callback Work to do, must return quickly
+     * @return Task id for cancel()
+     */
+    int after(const char *name, uint32_t delayMicros, TaskPriority priority, TaskCallback callback) {
+        return add(name, delayMicros, 0, false, priority, callback);
+    }
+
+    /**
+     * @brief Stop a task; safe to call from inside a task
+     */
+    void cancel(int id) {
+        for (auto &task : Tasks) {
+            if (task.id == id) {
+                task.active = false;
+                HasFinished = true;
+            }
+        }
+        for (auto &task : Added) {
+            if (task.id == id) {
+                task.active = false;
+            }
+        }
+    }
+
+    /**
+     * @brief Set the time non-critical tasks may use per tick
+     */
+    void setBudget(uint32_t budgetMicros) { BudgetMicros = budgetMicros; }
+    uint32_t getBudget() const { return BudgetMicros; }
+
+    /**
+     * @brief Run the due tasks once. Call this from loop().
+     */
+    void tick() {
+        if (Running) {
+            return; // a task called tick() (e.g. from a yield loop)
+        }
+        Running = true;
+        Ticks++;
+
+        uint32_t now = micros();
+        uint32_t start = now;
+        bool overBudget = false;
+
+        // The most deferred non-critical task gets the guaranteed slot
+        int guaranteed = -1;
+        for (size_t i = 0; i < Tasks.size(); i++) {
+            SchedulerTask &task = Tasks[i];
+            if (task.priority != TASK_PRIORITY_CRITICAL && isDue(task, now) &&
+                (guaranteed < 0 || task.pendingDeferrals > Tasks[guaranteed].pendingDeferrals)) {
+                guaranteed = (int)i;
+            }
+        }
+
+        for (size_t i = 0; i < Tasks.size(); i++) {
+            SchedulerTask &task = Tasks[i];
+            if (!isDue(task, now)) {
+                continue;
+            }
+            if (task.priority != TASK_PRIORITY_CRITICAL && (int)i != guaranteed &&
+                micros() - start >= BudgetMicros) {
+                task.deferrals++;
+                task.pendingDeferrals++;
+                overBudget = true;
+                continue;
+            }
+            run(task, now);
+        }
+
+        if (overBudget) {
+            OverBudgetTicks++;
+        }
+        if (HasFinished) {
+            Tasks.erase(std::remove_if(Tasks.begin(), Tasks.end(),
+                                       [](const SchedulerTask &task) { return !task.active; }),
+                        Tasks.end());
+            HasFinished = false;
+        }
+        for (const auto &task : Added) {
+            if (task.active) {
+                insert(task);
+            }
+        }
+        Added.clear();
+        Running = false;
+    }
+
+    size_t taskCount() const { return Tasks.size(); }
+    const SchedulerTask &task(size_t index) const { return Tasks[index]; }
+    uint32_t tickCount() const { return Ticks; }
+    uint32_t overBudgetCount() const { return OverBudgetTicks; }
+};
+
+extern TaskScheduler taskScheduler;
+
+#endif // TASK_SCHEDULER_H
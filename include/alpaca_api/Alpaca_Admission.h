@@ -0,0 +1,194 @@
+#ifndef ALPACA_ADMISSION_H
+#define ALPACA_ADMISSION_H
+
+#include <ESPAsyncWebServer.h>
+#include <string.h>
+#include "Log_Filter.h"
+
+/**
+ * @file Alpaca_Admission.h
+ * @brief Per-client token buckets in front of the device API
+ *
+ * A client is a remote IP. The Alpaca ClientID is not used: a client can
+ * send any ClientID it likes, so a poller changing it per request would get a
+ * fresh bucket each time. Each client gets a bucket of ALPACA_ADMISSION_BURST
+ * tokens refilled at ALPACA_ADMISSION_RATE tokens per second; every device
+ * API request costs one token. Requests are admitted by class:
+ *
+ * - control verbs (halt, abortslew, haltcover): always admitted and not
+ *   charged, so a stop is never queued behind a polling flood.
+ * - commands (other PUTs): admitted while at least one token is left.
+ * - reads (GETs): admitted only while more than ALPACA_ADMISSION_COMMAND_RESERVE
+ *   tokens are left, so a client polling at full speed still has tokens for
+ *   its own commands.
+ *
+ * A throttled read whose method is also a DeviceState property (position,
+ * ismoving, temperature, ...) is answered from the device's DeviceState
+ * snapshot without running the handler; anything else gets
+ * 429 Too Many Requests with a Retry-After header.
+ *
+ * Up to ALPACA_ADMISSION_MAX_CLIENTS buckets are kept; the least recently
+ * seen client is forgotten first. A client starts with a full bucket only
+ * while the table has room: a bucket that replaces an evicted one starts with
+ * the command reserve, so clients taking turns evicting each other cannot
+ * read on fresh budgets. ALPACA_ADMISSION_RATE 0 disables limiting.
+ */
+
+#ifndef ALPACA_ADMISSION_RATE
+#define ALPACA_ADMISSION_RATE 20
+#endif
+
+#ifndef ALPACA_ADMISSION_BURST
+#define ALPACA_ADMISSION_BURST 40
+#endif
+
+#ifndef ALPACA_ADMISSION_COMMAND_RESERVE
+#define ALPACA_ADMISSION_COMMAND_RESERVE 10
+#endif
+
+#ifndef ALPACA_ADMISSION_MAX_CLIENTS
+#define ALPACA_ADMISSION_MAX_CLIENTS 8
+#endif
+
+enum AlpacaRequestClass : uint8_t {
+  ALPACA_REQUEST_READ = 0,
+  ALPACA_REQUEST_COMMAND = 1,
+  ALPACA_REQUEST_CONTROL = 2,
+};
+
+class AlpacaAdmission
+{
+private:
+  static const uint32_t TOKEN = 1000; // buckets count milli-tokens
+
+  struct Bucket
+  {
+    uint32_t ip;
+    uint32_t tokens;
+    unsigned long refilled; // millis() of the last refill
+  };
+
+  Bucket Buckets[ALPACA_ADMISSION_MAX_CLIENTS];
+  size_t Count = 0;
+  uint32_t Rate = ALPACA_ADMISSION_RATE;
+  uint32_t Burst = ALPACA_ADMISSION_BURST;
+  uint32_t Reserve = ALPACA_ADMISSION_COMMAND_RESERVE;
+
+  uint32_t Admitted = 0;
+  uint32_t Throttled = 0;
+  uint32_t Controls = 0;
+  uint32_t Evicted = 0;
+
+  // Bucket of the request's client, the least recently used one is reused
+  Bucket &bucketFor(AsyncWebServerRequest *request, unsigned long now)
+  {
+    uint32_t ip = (uint32_t)request->client()->remoteIP();
+    size_t oldest = 0;
+    for (size_t i = 0; i < Count; i++) {
+      if (Buckets[i].ip == ip) {
+        return Buckets[i];
+      }
+      if (now - Buckets[i].refilled > now - Buckets[oldest].refilled) {
+        oldest = i;
+      }
+    }
+    if (Count < ALPACA_ADMISSION_MAX_CLIENTS) {
+      Buckets[Count] = Bucket{ip, Burst * TOKEN, now};
+      return Buckets[Count++];
+    }
+    Evicted++;
+    Buckets[oldest] = Bucket{ip, Reserve * TOKEN, now};
+    return Buckets[oldest];
+  }
+
+  void refill(Bucket &bucket, unsigned long now)
+  {
+    uint32_t elapsed = now - bucket.refilled;
+    bucket.refilled = now;
+    uint32_t limit = Burst * TOKEN;
+    // Rate tokens per second = Rate milli-tokens per millisecond
+    uint32_t added = elapsed >= limit / (Rate > 0 ? Rate : 1) ? limit : elapsed * Rate;
+    bucket.tokens = std::min(limit, bucket.tokens + added);
+  }
+
+public:
+  /**
+   * @brief Class of the device API method @p method (not NUL terminated)
+   */
+  static AlpacaRequestClass classify(const char *method, size_t length, WebRequestMethodComposite verb)
+  {
+    static const char *const controls[] = {"halt", "abortslew", "haltcover"};
+    if (verb != HTTP_PUT) {
+      return ALPACA_REQUEST_READ;
+    }
+    for (const char *control : controls) {
+      if (strlen(control) == length && strncmp(control, method, length) == 0) {
+        return ALPACA_REQUEST_CONTROL;
+      }
+    }
+    return ALPACA_REQUEST_COMMAND;
+  }
+
+  /**
+   * @brief Set the limits
+   * @param rate Tokens per second per client, 0 to disable limiting
+   * @param burst Bucket size
+   * @param reserve Tokens only commands may use
+   */
+  void configure(uint32_t rate, uint32_t burst, uint32_t reserve)
+  {
+    Rate = rate;
+    Burst = std::max<uint32_t>(burst, 1);
+    Reserve = std::min(reserve, Burst - 1);
+    Count = 0;
+  }
+
+  bool enabled() const { return Rate > 0; }
+
+  /**
+   * @brief Charge the request to its client's bucket
+   * @return false if the client is over its budget for this class of request
+   */
+  bool admit(AsyncWebServerRequest *request, const char *method, size_t length)
+  {
+    if (!enabled()) {
+      return true;
+    }
+    AlpacaRequestClass requestClass = classify(method, length, request->method());
+    if (requestClass == ALPACA_REQUEST_CONTROL) {
+      Controls++;
+      return true;
+    }
+
+    unsigned long now = millis();
+    Bucket &bucket = bucketFor(request, now);
+    refill(bucket, now);
+    uint32_t needed = (requestClass == ALPACA_REQUEST_READ ? Reserve + 1 : 1) * TOKEN;
+    if (bucket.tokens < needed) {
+      Throttled++;
+      return false;
+    }
+    bucket.tokens -= TOKEN;
+    Admitted++;
+    return true;
+  }
+
+  /**
+   * @brief Answer a throttled request with 429 and the time until it would be admitted
+   */
+  void reject(AsyncWebServerRequest *request)
+  {
+    AsyncWebServerResponse *response = request->beginResponse(429, "text/plain", "Too many requests");
+    uint32_t retry = Rate > 0 ? (Reserve + 1 + Rate - 1) / Rate : 1;
+    response->addHeader("Retry-After", String(retry > 0 ? retry : 1));
+    request->send(response);
+  }
+
+  uint32_t admittedCount() const { return Admitted; }
+  uint32_t throttledCount() const { return Throttled; }
+  uint32_t controlCount() const { return Controls; }
+  uint32_t evictedCount() const { return Evicted; }
+  size_t clientCount() const { return Count; }
+};
+
+#endif // ALPACA_ADMISSION_H
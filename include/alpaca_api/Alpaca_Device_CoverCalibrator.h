@@ -3,8 +3,9 @@
 
 #include "Aplaca_Device.h"
 #include "ascom_interfaces/ICoverCalibrator.h"
-#include "DebugLog.h"
+#include "Log_Filter.h"
 #include "Alpaca_Response_Builder.h"
+#include "Alpaca_Response_Writer.h"
 #include "Alpaca_Errors.h"
 #include "Alpaca_Driver_Settings.h"
 #include "Alpaca_Request_Helper.h"
@@ -35,7 +36,6 @@
 class AlpacaDeviceCoverCalibrator : public AplacaDevice, public ICoverCalibrator {
 private:
   String Description;
-  uint32_t serverTransID = 0;
 
 public:
   /**
@@ -57,74 +57,52 @@ public:
 
   // ==================== Device-specific endpoint registration ====================
   
-  void registerHandlers(AsyncWebServer &server) override {
+  void registerHandlers(AsyncWebServer &) override {
     LOG_DEBUG("Registering CoverCalibrator specific handlers");
     
     // GET /api/v1/covercalibrator/{device_number}/brightness
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/brightness").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->brightnessHandler(request); });
+    addRoute("brightness", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->brightnessHandler(request); });
     
     // GET /api/v1/covercalibrator/{device_number}/calibratorchanging
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/calibratorchanging").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->calibratorChangingHandler(request); });
+    addRoute("calibratorchanging", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->calibratorChangingHandler(request); });
     
     // GET /api/v1/covercalibrator/{device_number}/calibratorstate
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/calibratorstate").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->calibratorStateHandler(request); });
+    addRoute("calibratorstate", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->calibratorStateHandler(request); });
     
     // GET /api/v1/covercalibrator/{device_number}/covermoving
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/covermoving").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->coverMovingHandler(request); });
+    addRoute("covermoving", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->coverMovingHandler(request); });
     
     // GET /api/v1/covercalibrator/{device_number}/coverstate
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/coverstate").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->coverStateHandler(request); });
+    addRoute("coverstate", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->coverStateHandler(request); });
     
     // GET /api/v1/covercalibrator/{device_number}/maxbrightness
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/maxbrightness").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->maxBrightnessHandler(request); });
+    addRoute("maxbrightness", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->maxBrightnessHandler(request); });
     
     // PUT /api/v1/covercalibrator/{device_number}/calibratoroff
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/calibratoroff").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->calibratorOffHandler(request); });
+    addRoute("calibratoroff", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->calibratorOffHandler(request); });
     
     // PUT /api/v1/covercalibrator/{device_number}/calibratoron
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/calibratoron").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->calibratorOnHandler(request); });
+    addRoute("calibratoron", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->calibratorOnHandler(request); });
     
     // PUT /api/v1/covercalibrator/{device_number}/closecover
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/closecover").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->closeCoverHandler(request); });
+    addRoute("closecover", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->closeCoverHandler(request); });
     
     // PUT /api/v1/covercalibrator/{device_number}/haltcover
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/haltcover").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->haltCoverHandler(request); });
+    addRoute("haltcover", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->haltCoverHandler(request); });
     
     // PUT /api/v1/covercalibrator/{device_number}/opencover
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/opencover").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->openCoverHandler(request); });
+    addRoute("opencover", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->openCoverHandler(request); });
     
     LOG_DEBUG("CoverCalibrator handlers registered!");
   }
@@ -143,29 +121,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     int brightness = GetBrightness();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  brightness, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("brightnessHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, brightness);
   }
 
   void calibratorChangingHandler(AsyncWebServerRequest *request) {
@@ -180,29 +143,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool calibratorChanging = GetCalibratorChanging();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              calibratorChanging, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("calibratorChangingHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, calibratorChanging);
   }
 
   void calibratorStateHandler(AsyncWebServerRequest *request) {
@@ -217,29 +165,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     CalibratorStatus calibratorState = GetCalibratorState();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              String((int)calibratorState), AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("calibratorStateHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, String((int)calibratorState));
   }
 
   void coverMovingHandler(AsyncWebServerRequest *request) {
@@ -254,29 +187,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool coverMoving = GetCoverMoving();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              coverMoving, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("coverMovingHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, coverMoving);
   }
 
   void coverStateHandler(AsyncWebServerRequest *request) {
@@ -291,29 +209,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     CoverStatus coverState = GetCoverState();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              String((int)coverState), AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("coverStateHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, String((int)coverState));
   }
 
   void maxBrightnessHandler(AsyncWebServerRequest *request) {
@@ -328,29 +231,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     int maxBrightness = GetMaxBrightness();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              String(maxBrightness), AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("maxBrightnessHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, String(maxBrightness));
   }
 
   void calibratorOffHandler(AsyncWebServerRequest *request) {
@@ -365,13 +253,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -379,15 +262,7 @@ public:
 
     CalibratorOff();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "calibratoroff", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("calibratorOffHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void calibratorOnHandler(AsyncWebServerRequest *request) {
@@ -402,13 +277,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -422,15 +292,7 @@ public:
 
     CalibratorOn(brightness);
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "calibratoron", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("calibratorOnHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void closeCoverHandler(AsyncWebServerRequest *request) {
@@ -445,13 +307,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -459,15 +316,7 @@ public:
 
     CloseCover();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "closecover", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("closeCoverHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void haltCoverHandler(AsyncWebServerRequest *request) {
@@ -482,13 +331,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -496,15 +340,7 @@ public:
 
     HaltCover();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "haltcover", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("haltCoverHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void openCoverHandler(AsyncWebServerRequest *request) {
@@ -519,13 +355,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -533,41 +364,210 @@ public:
 
     OpenCover();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "opencover", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("openCoverHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   // ==================== Common Device Handlers ====================
 
+  void actionHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (request->method() != HTTP_PUT) {
+      request->send(405, "application/json", "{\"ErrorMessage\": \"Method Not Allowed\"}");
+      return;
+    }
+
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::ActionNotImplemented, "Action not implemented");
+  }
+
+  void commandblindHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    String command;
+    bool raw = false;
+    if (!tryGetStringParam(request, "Command", true, command)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandblind", "Command");
+      return;
+    }
+    if (!tryGetBoolParam(request, "Raw", true, raw)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandblind", "Raw");
+      return;
+    }
+
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBlind not implemented");
+  }
+
+  void commandboolHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    String command;
+    bool raw = false;
+    if (!tryGetStringParam(request, "Command", true, command)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandbool", "Command");
+      return;
+    }
+    if (!tryGetBoolParam(request, "Raw", true, raw)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandbool", "Raw");
+      return;
+    }
+
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBool not implemented");
+  }
+
+  void commandstringHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    String command;
+    bool raw = false;
+    if (!tryGetStringParam(request, "Command", true, command)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandstring", "Command");
+      return;
+    }
+    if (!tryGetBoolParam(request, "Raw", true, raw)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandstring", "Raw");
+      return;
+    }
+
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandString not implemented");
+  }
+
+  void connectHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
+  }
+
+  void connectedHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    bool isGet = (request->method() == HTTP_GET);
+    bool isPut = (request->method() == HTTP_PUT);
+
+    if (!isGet && !isPut) {
+      request->send(405, "application/json", "{\"ErrorMessage\": \"Method Not Allowed\"}");
+      return;
+    }
+    
+    if (!extractClientIDAndTransactionID(request, !isGet, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (isPut) {
+      bool connected = false;
+      if (!tryGetBoolParam(request, "Connected", true, connected)) {
+        sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "connected", "Connected");
+        return;
+      }
+    }
+
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, true);
+  }
+
+  void connectingHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, false);
+  }
+
+  /**
+   * @brief Operational properties reported by DeviceState
+   */
+  void collectDeviceState(AlpacaDeviceState &state) override {
+    state.add("Brightness", GetBrightness());
+    state.add("CalibratorChanging", GetCalibratorChanging());
+    state.add("CalibratorState", (int)GetCalibratorState());
+    state.add("CoverMoving", GetCoverMoving());
+    state.add("CoverState", (int)GetCoverState());
+  }
+
+  void deviceStateHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendDeviceState(request, clientTransID, ++serverTransID);
+  }
+
+  void disconnectHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
+  }
+
   void driverInfoHandler(AsyncWebServerRequest *request) override {
     int clientIDInt = 0;
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              "ASCOM Alpaca CoverCalibrator Driver", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DriverInfoResponse.ready()) {
+      DriverInfoResponse.set("ASCOM Alpaca CoverCalibrator Driver");
+    }
+    DriverInfoResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void descriptionHandler(AsyncWebServerRequest *request) override {
@@ -575,23 +575,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              Description, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DescriptionResponse.ready()) {
+      DescriptionResponse.set(Description);
+    }
+    DescriptionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void driverVersionHandler(AsyncWebServerRequest *request) override {
@@ -599,23 +591,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              DRIVER_VERSION, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DriverVersionResponse.ready()) {
+      DriverVersionResponse.set(String(instanceVersion));
+    }
+    DriverVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void interfaceVersionHandler(AsyncWebServerRequest *request) override {
@@ -623,23 +607,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              1, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!InterfaceVersionResponse.ready()) {
+      InterfaceVersionResponse.set(1);
+    }
+    InterfaceVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void nameHandler(AsyncWebServerRequest *request) override {
@@ -647,23 +623,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              GetDeviceName(), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!NameResponse.ready()) {
+      NameResponse.set(GetDeviceName());
+    }
+    NameResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void supportedActionsHandler(AsyncWebServerRequest *request) override {
@@ -671,26 +639,20 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    root["ClientTransactionID"] = clientTransID;
-    root["ServerTransactionID"] = ++serverTransID;
-    root["ErrorNumber"] = static_cast<int>(AlpacaError::Success);
-    root["ErrorMessage"] = "";
-    JsonArray &values = root.createNestedArray("Value");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!SupportedActionsResponse.ready()) {
+      SupportedActionsResponse.setRaw("[]");
+    }
+    SupportedActionsResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void setupHandler(AsyncWebServerRequest *request) override {
+    // Default implementation - can be overridden in derived classes
+    request->send(200, "text/html", "<html><body><h1>CoverCalibrator Setup</h1><p>No configuration required.</p></body></html>");
   }
 };
 
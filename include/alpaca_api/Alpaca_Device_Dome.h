@@ -3,8 +3,9 @@
 
 #include "Aplaca_Device.h"
 #include "ascom_interfaces/IDome.h"
-#include "DebugLog.h"
+#include "Log_Filter.h"
 #include "Alpaca_Response_Builder.h"
+#include "Alpaca_Response_Writer.h"
 #include "Alpaca_Errors.h"
 #include "Alpaca_Driver_Settings.h"
 #include "Alpaca_Request_Helper.h"
@@ -49,7 +50,6 @@
 class AlpacaDeviceDome : public AplacaDevice, public IDome {
 private:
   String Description;
-  uint32_t serverTransID = 0;
 
 public:
   /**
@@ -71,158 +71,108 @@ public:
 
   // ==================== Device-specific endpoint registration ====================
   
-  void registerHandlers(AsyncWebServer &server) override {
+  void registerHandlers(AsyncWebServer &) override {
     LOG_DEBUG("Registering Dome specific handlers");
     
     // GET /api/v1/dome/{device_number}/altitude
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/altitude").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->altitudeHandler(request); });
+    addRoute("altitude", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->altitudeHandler(request); });
     
     // GET /api/v1/dome/{device_number}/athome
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/athome").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->atHomeHandler(request); });
+    addRoute("athome", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->atHomeHandler(request); });
     
     // GET /api/v1/dome/{device_number}/atpark
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/atpark").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->atParkHandler(request); });
+    addRoute("atpark", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->atParkHandler(request); });
     
     // GET /api/v1/dome/{device_number}/azimuth
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/azimuth").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->azimuthHandler(request); });
+    addRoute("azimuth", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->azimuthHandler(request); });
     
     // GET /api/v1/dome/{device_number}/canfindome
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/canfindhome").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->canFindHomeHandler(request); });
+    addRoute("canfindhome", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->canFindHomeHandler(request); });
     
     // GET /api/v1/dome/{device_number}/canpark
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/canpark").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->canParkHandler(request); });
+    addRoute("canpark", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->canParkHandler(request); });
     
     // GET /api/v1/dome/{device_number}/cansetaltitude
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/cansetaltitude").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->canSetAltitudeHandler(request); });
+    addRoute("cansetaltitude", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->canSetAltitudeHandler(request); });
     
     // GET /api/v1/dome/{device_number}/cansetazimuth
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/cansetazimuth").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->canSetAzimuthHandler(request); });
+    addRoute("cansetazimuth", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->canSetAzimuthHandler(request); });
     
     // GET /api/v1/dome/{device_number}/cansetpark
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/cansetpark").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->canSetParkHandler(request); });
+    addRoute("cansetpark", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->canSetParkHandler(request); });
     
     // GET /api/v1/dome/{device_number}/cansetshutter
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/cansetshutter").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->canSetShutterHandler(request); });
+    addRoute("cansetshutter", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->canSetShutterHandler(request); });
     
     // GET /api/v1/dome/{device_number}/canslave
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/canslave").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->canSlaveHandler(request); });
+    addRoute("canslave", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->canSlaveHandler(request); });
     
     // GET /api/v1/dome/{device_number}/cansyncazimuth
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/cansyncazimuth").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->canSyncAzimuthHandler(request); });
+    addRoute("cansyncazimuth", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->canSyncAzimuthHandler(request); });
     
     // GET /api/v1/dome/{device_number}/shutterstatus
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/shutterstatus").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->shutterStatusHandler(request); });
+    addRoute("shutterstatus", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->shutterStatusHandler(request); });
     
     // GET /api/v1/dome/{device_number}/slaved
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/slaved").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->slavedGetHandler(request); });
+    addRoute("slaved", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->slavedGetHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/slaved
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/slaved").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->slavedPutHandler(request); });
+    addRoute("slaved", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->slavedPutHandler(request); });
     
     // GET /api/v1/dome/{device_number}/slewing
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/slewing").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->slewingHandler(request); });
+    addRoute("slewing", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->slewingHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/abortslew
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/abortslew").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->abortSlewHandler(request); });
+    addRoute("abortslew", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->abortSlewHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/closeshutter
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/closeshutter").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->closeShutterHandler(request); });
+    addRoute("closeshutter", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->closeShutterHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/findhome
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/findhome").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->findHomeHandler(request); });
+    addRoute("findhome", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->findHomeHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/openshutter
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/openshutter").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->openShutterHandler(request); });
+    addRoute("openshutter", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->openShutterHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/park
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/park").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->parkHandler(request); });
+    addRoute("park", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->parkHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/setpark
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/setpark").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->setParkHandler(request); });
+    addRoute("setpark", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->setParkHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/slewtoaltitude
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/slewtoaltitude").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->slewToAltitudeHandler(request); });
+    addRoute("slewtoaltitude", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->slewToAltitudeHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/slewtoazimuth
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/slewtoazimuth").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->slewToAzimuthHandler(request); });
+    addRoute("slewtoazimuth", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->slewToAzimuthHandler(request); });
     
     // PUT /api/v1/dome/{device_number}/synctoazimuth
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/synctoazimuth").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->syncToAzimuthHandler(request); });
+    addRoute("synctoazimuth", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->syncToAzimuthHandler(request); });
     
     LOG_DEBUG("Dome handlers registered!");
   }
@@ -241,29 +191,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double altitude = GetAltitude();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  altitude, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("altitudeHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, altitude);
   }
 
   void atHomeHandler(AsyncWebServerRequest *request) {
@@ -278,29 +213,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool atHome = GetAtHome();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              atHome, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("atHomeHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, atHome);
   }
 
   void atParkHandler(AsyncWebServerRequest *request) {
@@ -315,29 +235,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool atPark = GetAtPark();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              atPark, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("atParkHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, atPark);
   }
 
   void azimuthHandler(AsyncWebServerRequest *request) {
@@ -352,29 +257,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double azimuth = GetAzimuth();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  azimuth, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("azimuthHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, azimuth);
   }
 
   void canFindHomeHandler(AsyncWebServerRequest *request) {
@@ -389,29 +279,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool canFindHome = GetCanFindHome();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              canFindHome, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("canFindHomeHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, canFindHome);
   }
 
   void canParkHandler(AsyncWebServerRequest *request) {
@@ -426,29 +301,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool canPark = GetCanPark();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              canPark, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("canParkHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, canPark);
   }
 
   void canSetAltitudeHandler(AsyncWebServerRequest *request) {
@@ -463,29 +323,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool canSetAltitude = GetCanSetAltitude();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              canSetAltitude, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("canSetAltitudeHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, canSetAltitude);
   }
 
   void canSetAzimuthHandler(AsyncWebServerRequest *request) {
@@ -500,29 +345,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool canSetAzimuth = GetCanSetAzimuth();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              canSetAzimuth, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("canSetAzimuthHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, canSetAzimuth);
   }
 
   void canSetParkHandler(AsyncWebServerRequest *request) {
@@ -537,29 +367,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool canSetPark = GetCanSetPark();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              canSetPark, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("canSetParkHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, canSetPark);
   }
 
   void canSetShutterHandler(AsyncWebServerRequest *request) {
@@ -574,29 +389,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool canSetShutter = GetCanSetShutter();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              canSetShutter, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("canSetShutterHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, canSetShutter);
   }
 
   void canSlaveHandler(AsyncWebServerRequest *request) {
@@ -611,29 +411,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool canSlave = GetCanSlave();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              canSlave, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("canSlaveHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, canSlave);
   }
 
   void canSyncAzimuthHandler(AsyncWebServerRequest *request) {
@@ -648,29 +433,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool canSyncAzimuth = GetCanSyncAzimuth();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              canSyncAzimuth, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("canSyncAzimuthHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, canSyncAzimuth);
   }
 
   void shutterStatusHandler(AsyncWebServerRequest *request) {
@@ -685,29 +455,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     ShutterState shutterStatus = GetShutterStatus();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              shutterStatus, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("shutterStatusHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, shutterStatus);
   }
 
   void slavedGetHandler(AsyncWebServerRequest *request) {
@@ -722,29 +477,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool slaved = GetSlaved();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              slaved, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("slavedGetHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, slaved);
   }
 
   void slavedPutHandler(AsyncWebServerRequest *request) {
@@ -759,13 +499,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -779,15 +514,7 @@ public:
 
     SetSlaved(slaved);
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "slaved", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("slavedPutHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void slewingHandler(AsyncWebServerRequest *request) {
@@ -802,29 +529,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     bool slewing = GetSlewing();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  slewing, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("slewingHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, slewing);
   }
 
   void abortSlewHandler(AsyncWebServerRequest *request) {
@@ -839,13 +551,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -853,15 +560,7 @@ public:
 
     AbortSlew();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "abortslew", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("abortSlewHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void closeShutterHandler(AsyncWebServerRequest *request) {
@@ -876,13 +575,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -890,15 +584,7 @@ public:
 
     CloseShutter();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "closeshutter", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("closeShutterHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void findHomeHandler(AsyncWebServerRequest *request) {
@@ -913,13 +599,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -927,15 +608,7 @@ public:
 
     FindHome();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "findhome", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("findHomeHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void openShutterHandler(AsyncWebServerRequest *request) {
@@ -950,13 +623,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -964,15 +632,7 @@ public:
 
     OpenShutter();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "openshutter", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("openShutterHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void parkHandler(AsyncWebServerRequest *request) {
@@ -987,13 +647,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1001,15 +656,7 @@ public:
 
     Park();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "park", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("parkHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void setParkHandler(AsyncWebServerRequest *request) {
@@ -1024,13 +671,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1038,15 +680,7 @@ public:
 
     SetPark();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "setpark", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("setParkHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void slewToAltitudeHandler(AsyncWebServerRequest *request) {
@@ -1061,13 +695,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1081,15 +710,7 @@ public:
 
     SlewToAltitude(altitude);
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "slewtoaltitude", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("slewToAltitudeHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void slewToAzimuthHandler(AsyncWebServerRequest *request) {
@@ -1104,13 +725,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1124,15 +740,7 @@ public:
 
     SlewToAzimuth(azimuth);
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "slewtoazimuth", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("slewToAzimuthHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void syncToAzimuthHandler(AsyncWebServerRequest *request) {
@@ -1147,13 +755,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1167,15 +770,7 @@ public:
 
     SyncToAzimuth(azimuth);
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "synctoazimuth", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("syncToAzimuthHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   // ==================== Common Device Handlers ====================
@@ -1190,13 +785,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1212,14 +802,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "action", AlpacaError::ActionNotImplemented,
-                         "Action not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::ActionNotImplemented, "Action not implemented");
   }
 
   void commandblindHandler(AsyncWebServerRequest *request) override {
@@ -1227,13 +811,8 @@ public:
     int clientTransID = 0;
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1248,14 +827,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandblind", AlpacaError::NotImplemented,
-                         "CommandBlind not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBlind not implemented");
   }
 
   void commandboolHandler(AsyncWebServerRequest *request) override {
@@ -1263,13 +836,8 @@ public:
     int clientTransID = 0;
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1284,14 +852,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandbool", AlpacaError::NotImplemented,
-                         "CommandBool not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBool not implemented");
   }
 
   void commandstringHandler(AsyncWebServerRequest *request) override {
@@ -1299,13 +861,8 @@ public:
     int clientTransID = 0;
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1320,14 +877,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandstring", AlpacaError::NotImplemented,
-                         "CommandString not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandString not implemented");
   }
 
   void connectHandler(AsyncWebServerRequest *request) override {
@@ -1335,23 +886,12 @@ public:
     int clientTransID = 0;
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "connect", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void connectedHandler(AsyncWebServerRequest *request) override {
@@ -1366,13 +906,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, !isGet, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -1384,13 +919,7 @@ public:
       }
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              true, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, true);
   }
 
   void connectingHandler(AsyncWebServerRequest *request) override {
@@ -1398,23 +927,24 @@ public:
     int clientTransID = 0;
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              false, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, false);
+  }
+
+  /**
+   * @brief Operational properties reported by DeviceState
+   */
+  void collectDeviceState(AlpacaDeviceState &state) override {
+    state.add("Altitude", GetAltitude());
+    state.add("AtHome", GetAtHome());
+    state.add("AtPark", GetAtPark());
+    state.add("Azimuth", GetAzimuth());
+    state.add("ShutterStatus", (int)GetShutterStatus());
+    state.add("Slewing", GetSlewing());
   }
 
   void deviceStateHandler(AsyncWebServerRequest *request) override {
@@ -1422,24 +952,12 @@ public:
     int clientTransID = 0;
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "devicestate", AlpacaError::NotImplemented,
-                         "DeviceState not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendDeviceState(request, clientTransID, ++serverTransID);
   }
 
   void disconnectHandler(AsyncWebServerRequest *request) override {
@@ -1447,23 +965,12 @@ public:
     int clientTransID = 0;
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "disconnect", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void driverInfoHandler(AsyncWebServerRequest *request) override {
@@ -1471,23 +978,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              "ASCOM Alpaca Dome Driver", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DriverInfoResponse.ready()) {
+      DriverInfoResponse.set("ASCOM Alpaca Dome Driver");
+    }
+    DriverInfoResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void descriptionHandler(AsyncWebServerRequest *request) override {
@@ -1495,23 +994,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              Description, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DescriptionResponse.ready()) {
+      DescriptionResponse.set(Description);
+    }
+    DescriptionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void driverVersionHandler(AsyncWebServerRequest *request) override {
@@ -1519,23 +1010,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              String(instanceVersion), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DriverVersionResponse.ready()) {
+      DriverVersionResponse.set(String(instanceVersion));
+    }
+    DriverVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void interfaceVersionHandler(AsyncWebServerRequest *request) override {
@@ -1543,23 +1026,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              2, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!InterfaceVersionResponse.ready()) {
+      InterfaceVersionResponse.set(2);
+    }
+    InterfaceVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void nameHandler(AsyncWebServerRequest *request) override {
@@ -1567,23 +1042,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              GetDeviceName(), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!NameResponse.ready()) {
+      NameResponse.set(GetDeviceName());
+    }
+    NameResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void supportedActionsHandler(AsyncWebServerRequest *request) override {
@@ -1591,26 +1058,20 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
-      return;
-    }
-
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    root["ClientTransactionID"] = clientTransID;
-    root["ServerTransactionID"] = ++serverTransID;
-    root["ErrorNumber"] = static_cast<int>(AlpacaError::Success);
-    root["ErrorMessage"] = "";
-    JsonArray &values = root.createNestedArray("Value");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!SupportedActionsResponse.ready()) {
+      SupportedActionsResponse.setRaw("[]");
+    }
+    SupportedActionsResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void setupHandler(AsyncWebServerRequest *request) override {
+    // Default implementation - can be overridden in derived classes
+    request->send(200, "text/html", "<html><body><h1>Dome Setup</h1><p>No configuration required.</p></body></html>");
   }
 };
 
@@ -3,8 +3,9 @@
 
 #include "Aplaca_Device.h"
 #include "ascom_interfaces/IFilterWheel.h"
-#include "DebugLog.h"
+#include "Log_Filter.h"
 #include "Alpaca_Response_Builder.h"
+#include "Alpaca_Response_Writer.h"
 #include "Alpaca_Errors.h"
 #include "Alpaca_Driver_Settings.h"
 #include "Alpaca_Request_Helper.h"
@@ -28,7 +29,6 @@
 class AlpacaDeviceFilterWheel : public AplacaDevice, public IFilterWheel {
 private:
   String Description;
-  uint32_t serverTransID = 0;
 
 public:
   /**
@@ -50,32 +50,24 @@ public:
 
   // ==================== Device-specific endpoint registration ====================
   
-  void registerHandlers(AsyncWebServer &server) override {
+  void registerHandlers(AsyncWebServer &) override {
     LOG_DEBUG("Registering FilterWheel specific handlers");
     
     // GET /api/v1/filterwheel/{device_number}/focusoffsets
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/focusoffsets").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->focusOffsetsHandler(request); });
+    addRoute("focusoffsets", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->focusOffsetsHandler(request); });
     
     // GET /api/v1/filterwheel/{device_number}/names
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/names").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->namesHandler(request); });
+    addRoute("names", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->namesHandler(request); });
     
     // GET /api/v1/filterwheel/{device_number}/position
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/position").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->positionGetHandler(request); });
+    addRoute("position", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->positionGetHandler(request); });
     
     // PUT /api/v1/filterwheel/{device_number}/position
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/position").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->positionPutHandler(request); });
+    addRoute("position", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->positionPutHandler(request); });
     
     LOG_DEBUG("FilterWheel handlers registered!");
   }
@@ -99,13 +91,8 @@ public:
 
     // Extract ClientID and ClientTransactionID
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -130,6 +117,7 @@ public:
     root.printTo(message);
     LOG_DEBUG("focusOffsetsHandler response:", message.c_str());
 
+    metrics.noteResponseBytes(message.length());
     request->send(200, "application/json", message);
   }
 
@@ -150,13 +138,8 @@ public:
 
     // Extract ClientID and ClientTransactionID
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -181,6 +164,7 @@ public:
     root.printTo(message);
     LOG_DEBUG("namesHandler response:", message.c_str());
 
+    metrics.noteResponseBytes(message.length());
     request->send(200, "application/json", message);
   }
 
@@ -201,13 +185,8 @@ public:
 
     // Extract ClientID and ClientTransactionID
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -215,17 +194,7 @@ public:
     int position = GetPosition();
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  position, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("positionGetHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, position);
   }
 
   /**
@@ -245,13 +214,8 @@ public:
 
     // Extract ClientID and ClientTransactionID from form data (PUT request)
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -279,15 +243,7 @@ public:
     SetPosition(position);
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "position", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("positionPutHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   // ==================== Common Device Handlers ====================
@@ -302,24 +258,13 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "action", AlpacaError::ActionNotImplemented, 
-                         "Action not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::ActionNotImplemented, "Action not implemented");
   }
 
   void commandblindHandler(AsyncWebServerRequest *request) override {
@@ -327,13 +272,8 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -348,14 +288,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandblind", AlpacaError::NotImplemented, 
-                         "CommandBlind not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBlind not implemented");
   }
 
   void commandboolHandler(AsyncWebServerRequest *request) override {
@@ -363,13 +297,8 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -384,14 +313,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandbool", AlpacaError::NotImplemented, 
-                         "CommandBool not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBool not implemented");
   }
 
   void commandstringHandler(AsyncWebServerRequest *request) override {
@@ -399,13 +322,8 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -420,14 +338,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandstring", AlpacaError::NotImplemented, 
-                         "CommandString not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandString not implemented");
   }
 
   void connectHandler(AsyncWebServerRequest *request) override {
@@ -435,23 +347,12 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "connect", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void connectedHandler(AsyncWebServerRequest *request) override {
@@ -466,13 +367,8 @@ public:
     }
     
     if (!extractClientIDAndTransactionID(request, !isGet, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -484,13 +380,7 @@ public:
       }
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              true, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, true);
   }
 
   void connectingHandler(AsyncWebServerRequest *request) override {
@@ -498,23 +388,12 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              false, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, false);
   }
 
   void descriptionHandler(AsyncWebServerRequest *request) override {
@@ -522,23 +401,22 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              Description, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DescriptionResponse.ready()) {
+      DescriptionResponse.set(Description);
+    }
+    DescriptionResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  /**
+   * @brief Operational properties reported by DeviceState
+   */
+  void collectDeviceState(AlpacaDeviceState &state) override {
+    state.add("Position", GetPosition());
   }
 
   void deviceStateHandler(AsyncWebServerRequest *request) override {
@@ -546,24 +424,12 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "devicestate", AlpacaError::NotImplemented, 
-                         "DeviceState not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendDeviceState(request, clientTransID, ++serverTransID);
   }
 
   void disconnectHandler(AsyncWebServerRequest *request) override {
@@ -571,23 +437,12 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "disconnect", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void driverInfoHandler(AsyncWebServerRequest *request) override {
@@ -595,23 +450,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              "ASCOM Alpaca FilterWheel Driver", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DriverInfoResponse.ready()) {
+      DriverInfoResponse.set("ASCOM Alpaca FilterWheel Driver");
+    }
+    DriverInfoResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void driverVersionHandler(AsyncWebServerRequest *request) override {
@@ -619,23 +466,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              String(instanceVersion), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DriverVersionResponse.ready()) {
+      DriverVersionResponse.set(String(instanceVersion));
+    }
+    DriverVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void interfaceVersionHandler(AsyncWebServerRequest *request) override {
@@ -643,23 +482,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              2, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!InterfaceVersionResponse.ready()) {
+      InterfaceVersionResponse.set(2);
+    }
+    InterfaceVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void nameHandler(AsyncWebServerRequest *request) override {
@@ -667,23 +498,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              GetDeviceName(), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!NameResponse.ready()) {
+      NameResponse.set(GetDeviceName());
+    }
+    NameResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void supportedActionsHandler(AsyncWebServerRequest *request) override {
@@ -691,26 +514,20 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    root["ClientTransactionID"] = clientTransID;
-    root["ServerTransactionID"] = ++serverTransID;
-    root["ErrorNumber"] = static_cast<int>(AlpacaError::Success);
-    root["ErrorMessage"] = "";
-    JsonArray &values = root.createNestedArray("Value");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!SupportedActionsResponse.ready()) {
+      SupportedActionsResponse.setRaw("[]");
+    }
+    SupportedActionsResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void setupHandler(AsyncWebServerRequest *request) override {
+    // Default implementation - can be overridden in derived classes
+    request->send(200, "text/html", "<html><body><h1>FilterWheel Setup</h1><p>No configuration required.</p></body></html>");
   }
 };
 
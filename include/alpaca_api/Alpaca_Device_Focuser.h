@@ -3,8 +3,10 @@
 
 #include "Aplaca_Device.h"
 #include "ascom_interfaces/IFocuser.h"
-#include "DebugLog.h"
+#include "Log_Filter.h"
+#include "Deferred_Log.h"
 #include "Alpaca_Response_Builder.h"
+#include "Alpaca_Response_Writer.h"
 #include "Alpaca_Errors.h"
 #include "Alpaca_Driver_Settings.h"
 #include "Alpaca_Request_Helper.h"
@@ -36,7 +38,26 @@
 class AlpacaDeviceFocuser : public AplacaDevice, public IFocuser {
 private:
   String Description;
-  uint32_t serverTransID = 0;
+
+  // Pre-rendered responses of the focuser's static properties
+  AlpacaResponseTemplate AbsoluteResponse;
+  AlpacaResponseTemplate MaxIncrementResponse;
+  AlpacaResponseTemplate MaxStepResponse;
+  AlpacaResponseTemplate StepSizeResponse;
+  AlpacaResponseTemplate TempCompAvailableResponse;
+
+protected:
+  /**
+   * @brief Also drop the focuser property responses, e.g. after a configuration change
+   */
+  void invalidateResponseTemplates() override {
+    AplacaDevice::invalidateResponseTemplates();
+    AbsoluteResponse.reset();
+    MaxIncrementResponse.reset();
+    MaxStepResponse.reset();
+    StepSizeResponse.reset();
+    TempCompAvailableResponse.reset();
+  }
 
 public:
   /**
@@ -59,80 +80,56 @@ public:
 
   // ==================== Device-specific endpoint registration ====================
   
-  void registerHandlers(AsyncWebServer &server) override {
+  void registerHandlers(AsyncWebServer &) override {
     LOG_DEBUG("Registering Focuser specific handlers");
     
     // GET /api/v1/focuser/{device_number}/absolute
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/absolute").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->absoluteHandler(request); });
+    addRoute("absolute", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->absoluteHandler(request); });
     
     // GET /api/v1/focuser/{device_number}/ismoving
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/ismoving").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->isMovingHandler(request); });
+    addRoute("ismoving", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->isMovingHandler(request); });
     
     // GET /api/v1/focuser/{device_number}/maxincrement
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/maxincrement").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->maxIncrementHandler(request); });
+    addRoute("maxincrement", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->maxIncrementHandler(request); });
     
     // GET /api/v1/focuser/{device_number}/maxstep
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/maxstep").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->maxStepHandler(request); });
+    addRoute("maxstep", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->maxStepHandler(request); });
     
     // GET /api/v1/focuser/{device_number}/position
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/position").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->positionHandler(request); });
+    addRoute("position", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->positionHandler(request); });
     
     // GET /api/v1/focuser/{device_number}/stepsize
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/stepsize").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->stepSizeHandler(request); });
+    addRoute("stepsize", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->stepSizeHandler(request); });
     
     // GET /api/v1/focuser/{device_number}/tempcomp
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/tempcomp").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->tempCompGetHandler(request); });
+    addRoute("tempcomp", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->tempCompGetHandler(request); });
     
     // PUT /api/v1/focuser/{device_number}/tempcomp
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/tempcomp").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->tempCompPutHandler(request); });
+    addRoute("tempcomp", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->tempCompPutHandler(request); });
     
     // GET /api/v1/focuser/{device_number}/tempcompavailable
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/tempcompavailable").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->tempCompAvailableHandler(request); });
+    addRoute("tempcompavailable", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->tempCompAvailableHandler(request); });
     
     // GET /api/v1/focuser/{device_number}/temperature
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/temperature").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->temperatureHandler(request); });
+    addRoute("temperature", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->temperatureHandler(request); });
     
     // PUT /api/v1/focuser/{device_number}/halt
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/halt").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->haltHandler(request); });
+    addRoute("halt", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->haltHandler(request); });
     
     // PUT /api/v1/focuser/{device_number}/move
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/move").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->moveHandler(request); });
+    addRoute("move", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->moveHandler(request); });
     
     LOG_DEBUG("Focuser handlers registered!");
   }
@@ -156,31 +153,16 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     // Get absolute capability from device implementation
-    bool absolute = GetAbsolute();
-
-    // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              absolute, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("absoluteHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    if (!AbsoluteResponse.ready()) {
+      AbsoluteResponse.set(GetAbsolute());
+    }
+    AbsoluteResponse.send(request, clientTransID, ++serverTransID);
   }
 
   /**
@@ -200,13 +182,8 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -214,17 +191,7 @@ public:
     bool isMoving = GetIsMoving();
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              isMoving, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("isMovingHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, isMoving);
   }
 
   /**
@@ -244,31 +211,16 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     // Get max increment from device implementation
-    int maxIncrement = GetMaxIncrement();
-
-    // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              maxIncrement, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("maxIncrementHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    if (!MaxIncrementResponse.ready()) {
+      MaxIncrementResponse.set(GetMaxIncrement());
+    }
+    MaxIncrementResponse.send(request, clientTransID, ++serverTransID);
   }
 
   /**
@@ -288,31 +240,16 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     // Get max step from device implementation
-    int maxStep = GetMaxStep();
-
-    // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              maxStep, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("maxStepHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    if (!MaxStepResponse.ready()) {
+      MaxStepResponse.set(GetMaxStep());
+    }
+    MaxStepResponse.send(request, clientTransID, ++serverTransID);
   }
 
   /**
@@ -332,13 +269,8 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -346,17 +278,7 @@ public:
     int position = GetPosition();
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              position, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("positionHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, position);
   }
 
   /**
@@ -376,31 +298,16 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     // Get step size from device implementation
-    double stepSize = GetStepSize();
-
-    // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              stepSize, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("stepSizeHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    if (!StepSizeResponse.ready()) {
+      StepSizeResponse.set(GetStepSize());
+    }
+    StepSizeResponse.send(request, clientTransID, ++serverTransID);
   }
 
   /**
@@ -420,13 +327,8 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -434,17 +336,7 @@ public:
     bool tempComp = GetTempComp();
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              tempComp, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("tempCompGetHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, tempComp);
   }
 
   /**
@@ -464,13 +356,8 @@ public:
 
     // Extract ClientID and ClientTransactionID from form data (PUT request)
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -486,15 +373,7 @@ public:
     SetTempComp(tempComp);
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "tempcomp", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("tempCompPutHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   /**
@@ -514,31 +393,16 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     // Get temperature compensation availability from device implementation
-    bool tempCompAvailable = GetTempCompAvailable();
-
-    // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              tempCompAvailable, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("tempCompAvailableHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    if (!TempCompAvailableResponse.ready()) {
+      TempCompAvailableResponse.set(GetTempCompAvailable());
+    }
+    TempCompAvailableResponse.send(request, clientTransID, ++serverTransID);
   }
 
   /**
@@ -558,13 +422,8 @@ public:
 
     // Extract ClientID and ClientTransactionID from query parameters
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -572,17 +431,7 @@ public:
     double temperature = GetTemperature();
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              temperature, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("temperatureHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, temperature);
   }
 
   /**
@@ -602,13 +451,8 @@ public:
 
     // Extract ClientID and ClientTransactionID from form data (PUT request)
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -618,15 +462,7 @@ public:
     Halt();
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "halt", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("haltHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   /**
@@ -646,13 +482,8 @@ public:
 
     // Extract ClientID and ClientTransactionID from form data (PUT request)
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -662,21 +493,13 @@ public:
       return;
     }
     
-    LOG_INFO("Moving focuser to position:", position);
+    LOG_DEFERRED_INFO("Moving focuser to position: %d", position);
 
     // Move focuser via device implementation
     Move(position);
 
     // Build JSON response
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "move", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("moveHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   // ==================== Common Device Handlers ====================
@@ -691,24 +514,13 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "action", AlpacaError::ActionNotImplemented, 
-                         "Action not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::ActionNotImplemented, "Action not implemented");
   }
 
   void commandblindHandler(AsyncWebServerRequest *request) override {
@@ -716,13 +528,8 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -737,14 +544,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandblind", AlpacaError::NotImplemented, 
-                         "CommandBlind not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBlind not implemented");
   }
 
   void commandboolHandler(AsyncWebServerRequest *request) override {
@@ -752,13 +553,8 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -773,14 +569,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandbool", AlpacaError::NotImplemented, 
-                         "CommandBool not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBool not implemented");
   }
 
   void commandstringHandler(AsyncWebServerRequest *request) override {
@@ -788,13 +578,8 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -809,14 +594,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "commandstring", AlpacaError::NotImplemented, 
-                         "CommandString not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandString not implemented");
   }
 
   void connectHandler(AsyncWebServerRequest *request) override {
@@ -824,23 +603,12 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "connect", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void connectedHandler(AsyncWebServerRequest *request) override {
@@ -855,13 +623,8 @@ public:
     }
     
     if (!extractClientIDAndTransactionID(request, !isGet, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -873,13 +636,7 @@ public:
       }
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              true, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, true);
   }
 
   void connectingHandler(AsyncWebServerRequest *request) override {
@@ -887,23 +644,12 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              false, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, false);
   }
 
   void descriptionHandler(AsyncWebServerRequest *request) override {
@@ -911,23 +657,24 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              Description, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DescriptionResponse.ready()) {
+      DescriptionResponse.set(Description);
+    }
+    DescriptionResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  /**
+   * @brief Operational properties reported by DeviceState
+   */
+  void collectDeviceState(AlpacaDeviceState &state) override {
+    state.add("IsMoving", GetIsMoving());
+    state.add("Position", GetPosition());
+    state.add("Temperature", GetTemperature());
   }
 
   void deviceStateHandler(AsyncWebServerRequest *request) override {
@@ -935,24 +682,12 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "devicestate", AlpacaError::NotImplemented, 
-                         "DeviceState not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendDeviceState(request, clientTransID, ++serverTransID);
   }
 
   void disconnectHandler(AsyncWebServerRequest *request) override {
@@ -960,23 +695,12 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "disconnect", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void driverInfoHandler(AsyncWebServerRequest *request) override {
@@ -984,23 +708,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              "ASCOM Alpaca Focuser Driver", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DriverInfoResponse.ready()) {
+      DriverInfoResponse.set("ASCOM Alpaca Focuser Driver");
+    }
+    DriverInfoResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void driverVersionHandler(AsyncWebServerRequest *request) override {
@@ -1008,23 +724,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              String(instanceVersion), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DriverVersionResponse.ready()) {
+      DriverVersionResponse.set(String(instanceVersion));
+    }
+    DriverVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void interfaceVersionHandler(AsyncWebServerRequest *request) override {
@@ -1032,23 +740,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              2, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!InterfaceVersionResponse.ready()) {
+      InterfaceVersionResponse.set(2);
+    }
+    InterfaceVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void nameHandler(AsyncWebServerRequest *request) override {
@@ -1056,23 +756,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                              GetDeviceName(), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!NameResponse.ready()) {
+      NameResponse.set(GetDeviceName());
+    }
+    NameResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void supportedActionsHandler(AsyncWebServerRequest *request) override {
@@ -1080,27 +772,15 @@ public:
     int clientTransID = 0;
     
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    root["ClientTransactionID"] = clientTransID;
-    root["ServerTransactionID"] = ++serverTransID;
-    root["ErrorNumber"] = static_cast<int>(AlpacaError::Success);
-    root["ErrorMessage"] = "";
-    JsonArray &values = root.createNestedArray("Value");
-    (void)values; // Mark as intentionally unused
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!SupportedActionsResponse.ready()) {
+      SupportedActionsResponse.setRaw("[]");
+    }
+    SupportedActionsResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void setupHandler(AsyncWebServerRequest *request) override {
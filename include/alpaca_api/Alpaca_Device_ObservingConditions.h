@@ -3,8 +3,9 @@
 
 #include "Aplaca_Device.h"
 #include "ascom_interfaces/IObservingConditions.h"
-#include "DebugLog.h"
+#include "Log_Filter.h"
 #include "Alpaca_Response_Builder.h"
+#include "Alpaca_Response_Writer.h"
 #include "Alpaca_Errors.h"
 #include "Alpaca_Driver_Settings.h"
 #include "Alpaca_Request_Helper.h"
@@ -42,7 +43,6 @@
 class AlpacaDeviceObservingConditions : public AplacaDevice, public IObservingConditions {
 private:
   String Description;
-  uint32_t serverTransID = 0;
 
 public:
   /**
@@ -64,116 +64,80 @@ public:
 
   // ==================== Device-specific endpoint registration ====================
   
-  void registerHandlers(AsyncWebServer &server) override {
+  void registerHandlers(AsyncWebServer &) override {
     LOG_DEBUG("Registering ObservingConditions specific handlers");
     
     // GET /api/v1/observingconditions/{device_number}/averageperiod
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/averageperiod").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->averagePeriodGetHandler(request); });
+    addRoute("averageperiod", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->averagePeriodGetHandler(request); });
     
     // PUT /api/v1/observingconditions/{device_number}/averageperiod
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/averageperiod").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->averagePeriodPutHandler(request); });
+    addRoute("averageperiod", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->averagePeriodPutHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/cloudcover
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/cloudcover").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->cloudCoverHandler(request); });
+    addRoute("cloudcover", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->cloudCoverHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/dewpoint
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/dewpoint").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->dewPointHandler(request); });
+    addRoute("dewpoint", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->dewPointHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/humidity
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/humidity").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->humidityHandler(request); });
+    addRoute("humidity", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->humidityHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/pressure
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/pressure").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->pressureHandler(request); });
+    addRoute("pressure", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->pressureHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/rainrate
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/rainrate").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->rainRateHandler(request); });
+    addRoute("rainrate", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->rainRateHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/skybrightness
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/skybrightness").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->skyBrightnessHandler(request); });
+    addRoute("skybrightness", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->skyBrightnessHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/skyquality
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/skyquality").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->skyQualityHandler(request); });
+    addRoute("skyquality", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->skyQualityHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/skytemperature
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/skytemperature").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->skyTemperatureHandler(request); });
+    addRoute("skytemperature", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->skyTemperatureHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/starfwhm
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/starfwhm").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->starFWHMHandler(request); });
+    addRoute("starfwhm", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->starFWHMHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/temperature
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/temperature").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->temperatureHandler(request); });
+    addRoute("temperature", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->temperatureHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/winddirection
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/winddirection").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->windDirectionHandler(request); });
+    addRoute("winddirection", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->windDirectionHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/windgust
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/windgust").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->windGustHandler(request); });
+    addRoute("windgust", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->windGustHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/windspeed
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/windspeed").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->windSpeedHandler(request); });
+    addRoute("windspeed", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->windSpeedHandler(request); });
     
     // PUT /api/v1/observingconditions/{device_number}/refresh
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/refresh").c_str(), 
-              HTTP_PUT, 
-              [this](AsyncWebServerRequest *request){ this->refreshHandler(request); });
+    addRoute("refresh", HTTP_PUT,
+             [this](AsyncWebServerRequest *request){ this->refreshHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/sensordescription
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/sensordescription").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->sensorDescriptionHandler(request); });
+    addRoute("sensordescription", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->sensorDescriptionHandler(request); });
     
     // GET /api/v1/observingconditions/{device_number}/timesincelastupdate
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" + 
-               GetDeviceType() + "/" + GetDeviceNumber() + "/timesincelastupdate").c_str(), 
-              HTTP_GET, 
-              [this](AsyncWebServerRequest *request){ this->timeSinceLastUpdateHandler(request); });
+    addRoute("timesincelastupdate", HTTP_GET,
+             [this](AsyncWebServerRequest *request){ this->timeSinceLastUpdateHandler(request); });
     
     LOG_DEBUG("ObservingConditions handlers registered!");
   }
@@ -192,29 +156,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double averagePeriod = GetAveragePeriod();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  averagePeriod, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("averagePeriodGetHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, averagePeriod);
   }
 
   void averagePeriodPutHandler(AsyncWebServerRequest *request) {
@@ -229,13 +178,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -249,15 +193,7 @@ public:
 
     SetAveragePeriod(period);
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "averageperiod", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("averagePeriodPutHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void cloudCoverHandler(AsyncWebServerRequest *request) {
@@ -272,29 +208,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double cloudCover = GetCloudCover();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  cloudCover, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("cloudCoverHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, cloudCover);
   }
 
   void dewPointHandler(AsyncWebServerRequest *request) {
@@ -309,29 +230,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double dewPoint = GetDewPoint();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  dewPoint, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("dewPointHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, dewPoint);
   }
 
   void humidityHandler(AsyncWebServerRequest *request) {
@@ -346,29 +252,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double humidity = GetHumidity();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  humidity, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("humidityHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, humidity);
   }
 
   void pressureHandler(AsyncWebServerRequest *request) {
@@ -383,29 +274,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double pressure = GetPressure();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  pressure, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("pressureHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, pressure);
   }
 
   void rainRateHandler(AsyncWebServerRequest *request) {
@@ -420,29 +296,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double rainRate = GetRainRate();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  rainRate, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("rainRateHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, rainRate);
   }
 
   void skyBrightnessHandler(AsyncWebServerRequest *request) {
@@ -457,29 +318,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double skyBrightness = GetSkyBrightness();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  skyBrightness, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("skyBrightnessHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, skyBrightness);
   }
 
   void skyQualityHandler(AsyncWebServerRequest *request) {
@@ -494,29 +340,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double skyQuality = GetSkyQuality();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  skyQuality, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("skyQualityHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, skyQuality);
   }
 
   void skyTemperatureHandler(AsyncWebServerRequest *request) {
@@ -531,29 +362,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double skyTemperature = GetSkyTemperature();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  skyTemperature, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("skyTemperatureHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, skyTemperature);
   }
 
   void starFWHMHandler(AsyncWebServerRequest *request) {
@@ -568,29 +384,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double starFWHM = GetStarFWHM();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  starFWHM, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("starFWHMHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, starFWHM);
   }
 
   void temperatureHandler(AsyncWebServerRequest *request) {
@@ -605,29 +406,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double temperature = GetTemperature();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  temperature, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("temperatureHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, temperature);
   }
 
   void windDirectionHandler(AsyncWebServerRequest *request) {
@@ -642,29 +428,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double windDirection = GetWindDirection();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  windDirection, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("windDirectionHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, windDirection);
   }
 
   void windGustHandler(AsyncWebServerRequest *request) {
@@ -679,29 +450,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double windGust = GetWindGust();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  windGust, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("windGustHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, windGust);
   }
 
   void windSpeedHandler(AsyncWebServerRequest *request) {
@@ -716,29 +472,14 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
     double windSpeed = GetWindSpeed();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  windSpeed, AlpacaError::Success, "");
-    
-    root.printTo(message);
-    LOG_DEBUG("windSpeedHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, windSpeed);
   }
 
   void refreshHandler(AsyncWebServerRequest *request) {
@@ -753,13 +494,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -767,15 +503,7 @@ public:
 
     Refresh();
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                         "refresh", AlpacaError::Success, "");
-    root.printTo(message);
-    LOG_DEBUG("refreshHandler response:", message.c_str());
-
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void sensorDescriptionHandler(AsyncWebServerRequest *request) {
@@ -790,13 +518,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -818,6 +541,7 @@ public:
     root.printTo(message);
     LOG_DEBUG("sensorDescriptionHandler response:", message.c_str());
 
+    metrics.noteResponseBytes(message.length());
     request->send(200, "application/json", message);
   }
 
@@ -833,13 +557,8 @@ public:
     }
 
     if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return;
     }
 
@@ -851,34 +570,320 @@ public:
     std::string sensorNameStd = sensorName.c_str();
     double timeSince = GetTimeSinceLastUpdate(sensorNameStd);
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, timeSince);
+  }
+
+  // ==================== Common Device Handlers ====================
+  
+  void actionHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
     
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                  timeSince, AlpacaError::Success, "");
+    if (request->method() != HTTP_PUT) {
+      request->send(405, "application/json", "{\"ErrorMessage\": \"Method Not Allowed\"}");
+      return;
+    }
+
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::ActionNotImplemented, "Action not implemented");
+  }
+
+  void commandblindHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
     
-    root.printTo(message);
-    LOG_DEBUG("timeSinceLastUpdateHandler response:", message.c_str());
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
 
-    request->send(200, "application/json", message);
+    String command;
+    bool raw = false;
+    if (!tryGetStringParam(request, "Command", true, command)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandblind", "Command");
+      return;
+    }
+    if (!tryGetBoolParam(request, "Raw", true, raw)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandblind", "Raw");
+      return;
+    }
+
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBlind not implemented");
+  }
+
+  void commandboolHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    String command;
+    bool raw = false;
+    if (!tryGetStringParam(request, "Command", true, command)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandbool", "Command");
+      return;
+    }
+    if (!tryGetBoolParam(request, "Raw", true, raw)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandbool", "Raw");
+      return;
+    }
+
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBool not implemented");
+  }
+
+  void commandstringHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    String command;
+    bool raw = false;
+    if (!tryGetStringParam(request, "Command", true, command)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandstring", "Command");
+      return;
+    }
+    if (!tryGetBoolParam(request, "Raw", true, raw)) {
+      sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "commandstring", "Raw");
+      return;
+    }
+
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandString not implemented");
+  }
+
+  void connectHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
+  }
+
+  void connectedHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    bool isGet = (request->method() == HTTP_GET);
+    bool isPut = (request->method() == HTTP_PUT);
+
+    if (!isGet && !isPut) {
+      request->send(405, "application/json", "{\"ErrorMessage\": \"Method Not Allowed\"}");
+      return;
+    }
+    
+    if (!extractClientIDAndTransactionID(request, !isGet, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (isPut) {
+      bool connected = false;
+      if (!tryGetBoolParam(request, "Connected", true, connected)) {
+        sendInvalidParamResponse(request, clientIDInt, clientTransID, serverTransID, "connected", "Connected");
+        return;
+      }
+    }
+
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, true);
+  }
+
+  void connectingHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, false);
+  }
+
+  void descriptionHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DescriptionResponse.ready()) {
+      DescriptionResponse.set(Description);
+    }
+    DescriptionResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  /**
+   * @brief Operational properties reported by DeviceState
+   */
+  void collectDeviceState(AlpacaDeviceState &state) override {
+    state.add("CloudCover", GetCloudCover());
+    state.add("DewPoint", GetDewPoint());
+    state.add("Humidity", GetHumidity());
+    state.add("Pressure", GetPressure());
+    state.add("RainRate", GetRainRate());
+    state.add("SkyBrightness", GetSkyBrightness());
+    state.add("SkyQuality", GetSkyQuality());
+    state.add("SkyTemperature", GetSkyTemperature());
+    state.add("StarFWHM", GetStarFWHM());
+    state.add("Temperature", GetTemperature());
+    state.add("WindDirection", GetWindDirection());
+    state.add("WindGust", GetWindGust());
+    state.add("WindSpeed", GetWindSpeed());
+  }
+
+  void deviceStateHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendDeviceState(request, clientTransID, ++serverTransID);
+  }
+
+  void disconnectHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, true, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
+  }
+
+  void driverInfoHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DriverInfoResponse.ready()) {
+      DriverInfoResponse.set("ASCOM Alpaca ObservingConditions Driver");
+    }
+    DriverInfoResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void driverVersionHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!DriverVersionResponse.ready()) {
+      DriverVersionResponse.set(String(instanceVersion));
+    }
+    DriverVersionResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void interfaceVersionHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!InterfaceVersionResponse.ready()) {
+      InterfaceVersionResponse.set(2);
+    }
+    InterfaceVersionResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void nameHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!NameResponse.ready()) {
+      NameResponse.set(GetDeviceName());
+    }
+    NameResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void supportedActionsHandler(AsyncWebServerRequest *request) override {
+    int clientIDInt = 0;
+    int clientTransID = 0;
+    
+    if (!extractClientIDAndTransactionID(request, false, clientIDInt, clientTransID)) {
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
+      return;
+    }
+
+    if (!SupportedActionsResponse.ready()) {
+      SupportedActionsResponse.setRaw("[]");
+    }
+    SupportedActionsResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void setupHandler(AsyncWebServerRequest *request) override {
+    // Default implementation - can be overridden in derived classes
+    request->send(200, "text/html", "<html><body><h1>ObservingConditions Setup</h1><p>No configuration required.</p></body></html>");
   }
 
   // ==================== Common Device Methods ====================
   
-  String GetDeviceDescription() override {
+  String GetDeviceDescription() {
     return Description;
   }
 
-  String GetDeviceDriverInfo() override {
+  String GetDeviceDriverInfo() {
     return "ASCOM Alpaca ObservingConditions Driver";
   }
 
-  String GetDeviceDriverVersion() override {
+  String GetDeviceDriverVersion() {
     return "1.0";
   }
 
-  String GetDeviceInterfaceVersion() override {
+  String GetDeviceInterfaceVersion() {
     return "1";
   }
 };
@@ -3,8 +3,9 @@
 
 #include "Aplaca_Device.h"
 #include "ascom_interfaces/ISafetyMonitor.h"
-#include "DebugLog.h"
+#include "Log_Filter.h"
 #include "Alpaca_Response_Builder.h"
+#include "Alpaca_Response_Writer.h"
 #include "Alpaca_Errors.h"
 #include "Alpaca_Driver_Settings.h"
 #include "Alpaca_Request_Helper.h"
@@ -26,17 +27,17 @@ class AlpacaDeviceSafetyMonitor : public AplacaDevice, public ISafetyMonitor
 {
 private:
   String Description;
-  uint32_t serverTransID = 0;
 
   // Helper methods for method-specific required parameters
 
   bool tryGetActionParam(AsyncWebServerRequest *request, bool fromBody, String &action)
   {
-    if (!request->hasParam("Action", fromBody))
+    const AsyncWebParameter *param = findAlpacaParam(request, "Action", fromBody);
+    if (param == nullptr)
     {
       return false;
     }
-    action = request->getParam("Action", fromBody)->value();
+    action = param->value();
     // Action must not be empty
     if (action.length() == 0)
     {
@@ -47,11 +48,12 @@ private:
 
   bool tryGetParametersParam(AsyncWebServerRequest *request, bool fromBody, String &parameters)
   {
-    if (!request->hasParam("Parameters", fromBody))
+    const AsyncWebParameter *param = findAlpacaParam(request, "Parameters", fromBody);
+    if (param == nullptr)
     {
       return false;
     }
-    parameters = request->getParam("Parameters", fromBody)->value();
+    parameters = param->value();
     return true;
   }
 
@@ -59,13 +61,8 @@ private:
                              const String &methodName, const String &paramName)
   {
     LOG_DEBUG("sendMissingParamError - Url: " + request->url() + ", Missing or invalid required parameter: " + paramName + " for method: " + methodName + " ClientID: " + String(clientID) + " ClientTransactionID: " + String(clientTransID));
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientID, clientTransID, ++serverTransID, methodName,
-                          AlpacaError::InvalidValue, "Missing or invalid required parameter: " + paramName);
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::InvalidValue, ("Missing or invalid required parameter: " + paramName).c_str());
   }
 
   bool ensureActionParams(AsyncWebServerRequest *request, bool fromBody, int clientID,
@@ -87,11 +84,12 @@ private:
 
   bool tryGetCommandParam(AsyncWebServerRequest *request, bool fromBody, String &command)
   {
-    if (!request->hasParam("Command", fromBody))
+    const AsyncWebParameter *param = findAlpacaParam(request, "Command", fromBody);
+    if (param == nullptr)
     {
       return false;
     }
-    command = request->getParam("Command", fromBody)->value();
+    command = param->value();
     // Command must not be empty
     if (command.length() == 0)
     {
@@ -102,25 +100,13 @@ private:
 
   bool tryGetRawParam(AsyncWebServerRequest *request, bool fromBody, bool &raw)
   {
-    if (!request->hasParam("Raw", fromBody))
+    const AsyncWebParameter *param = findAlpacaParam(request, "Raw", fromBody);
+    if (param == nullptr)
     {
       return false;
     }
-    String rawStr = request->getParam("Raw", fromBody)->value();
-    rawStr.toLowerCase();
     // Validate boolean value
-    if (rawStr == "true" || rawStr == "1")
-    {
-      raw = true;
-      return true;
-    }
-    else if (rawStr == "false" || rawStr == "0")
-    {
-      raw = false;
-      return true;
-    }
-    // Invalid boolean value
-    return false;
+    return parseBoolValue(param->value(), raw);
   }
 
   bool ensureCommandParams(AsyncWebServerRequest *request, bool fromBody, int clientID,
@@ -142,25 +128,13 @@ private:
 
   bool tryGetConnectedParam(AsyncWebServerRequest *request, bool fromBody, bool &connected)
   {
-    if (!request->hasParam("Connected", fromBody))
+    const AsyncWebParameter *param = findAlpacaParam(request, "Connected", fromBody);
+    if (param == nullptr)
     {
       return false;
     }
-    String connectedStr = request->getParam("Connected", fromBody)->value();
-    connectedStr.toLowerCase();
     // Validate boolean value
-    if (connectedStr == "true" || connectedStr == "1")
-    {
-      connected = true;
-      return true;
-    }
-    else if (connectedStr == "false" || connectedStr == "0")
-    {
-      connected = false;
-      return true;
-    }
-    // Invalid boolean value
-    return false;
+    return parseBoolValue(param->value(), connected);
   }
 
   bool ensureConnectedParam(AsyncWebServerRequest *request, bool fromBody, int clientID,
@@ -178,14 +152,8 @@ private:
   {
     if (!extractClientIDAndTransactionID(request, fromBody, clientIDInt, clientTransID))
     {
-      String message;
-      DynamicJsonBuffer jsonBuff(256);
-      JsonObject &root = jsonBuff.createObject();
-      AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                           "invalid_parameters", AlpacaError::InvalidValue, 
-                           "Invalid ClientID or ClientTransactionID");
-      root.printTo(message);
-      request->send(400, "application/json", message);
+      sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                         AlpacaError::InvalidValue, "Invalid ClientID or ClientTransactionID");
       return false;
     }
     return true;
@@ -212,17 +180,14 @@ public:
 
   // ==================== Device-specific endpoint registration ====================
 
-  void registerHandlers(AsyncWebServer &server) override
+  void registerHandlers(AsyncWebServer &) override
   {
     LOG_DEBUG("Registering SafetyMonitor specific handlers");
 
     // GET /api/v1/safetymonitor/{device_number}/issafe
-    server.on((String("/api/v") + String(InterfaceVersion) + "/" +
-               GetDeviceType() + "/" + GetDeviceNumber() + "/issafe")
-                  .c_str(),
-              HTTP_GET,
-              [this](AsyncWebServerRequest *request)
-              { this->isSafeHandler(request); });
+    addRoute("issafe", HTTP_GET,
+             [this](AsyncWebServerRequest *request)
+             { this->isSafeHandler(request); });
 
     LOG_DEBUG("SafetyMonitor handlers registered!");
   }
@@ -274,6 +239,7 @@ public:
     root.printTo(message);
     LOG_DEBUG("isSafeHandler response: " + message);
 
+    metrics.noteResponseBytes(message.length());
     request->send(200, "application/json", message);
   }
 
@@ -305,14 +271,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                          "action", AlpacaError::ActionNotImplemented,
-                          "Action not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::ActionNotImplemented, "Action not implemented");
   }
 
   void commandblindHandler(AsyncWebServerRequest *request) override
@@ -341,14 +301,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                          "commandblind", AlpacaError::NotImplemented,
-                          "CommandBlind not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBlind not implemented");
   }
 
   void commandboolHandler(AsyncWebServerRequest *request) override
@@ -377,14 +331,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                          "commandbool", AlpacaError::NotImplemented,
-                          "CommandBool not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandBool not implemented");
   }
 
   void commandstringHandler(AsyncWebServerRequest *request) override
@@ -413,14 +361,8 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                          "commandstring", AlpacaError::NotImplemented,
-                          "CommandString not implemented");
-    root.printTo(message);
-    request->send(400, "application/json", message);
+    sendAlpacaResponse(request, 400, clientTransID, ++serverTransID,
+                       AlpacaError::NotImplemented, "CommandString not implemented");
   }
 
   void connectHandler(AsyncWebServerRequest *request) override
@@ -442,13 +384,7 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                          "connect", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void connectedHandler(AsyncWebServerRequest *request) override
@@ -483,13 +419,7 @@ public:
       // TODO: Actually set the connected state based on the 'connected' parameter
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                               true, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, true);
   }
 
   void connectingHandler(AsyncWebServerRequest *request) override
@@ -511,13 +441,7 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                               false, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaValueResponse(request, 200, clientTransID, ++serverTransID, false);
   }
 
   void descriptionHandler(AsyncWebServerRequest *request) override
@@ -538,13 +462,21 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                               Description, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DescriptionResponse.ready()) {
+      DescriptionResponse.set(Description);
+    }
+    DescriptionResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  /**
+   * @brief Operational properties reported by DeviceState
+   */
+  void collectDeviceState(AlpacaDeviceState &state) override
+  {
+    char timestamp[12];
+    snprintf(timestamp, sizeof(timestamp), "%lu", millis());
+    state.add("IsSafe", GetIsSafe());
+    state.add("Timestamp", timestamp);
   }
 
   void deviceStateHandler(AsyncWebServerRequest *request) override
@@ -566,23 +498,7 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-
-    JsonArray &value = root.createNestedArray("Value");
-    JsonObject &item1 = value.createNestedObject();
-    item1["Name"] = "IsSafe";
-    item1["Value"] = GetIsSafe();
-    JsonObject &item2 = value.createNestedObject();
-    item2["Name"] = "Timestamp";
-    item2["Value"] = String(millis());
-
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID, AlpacaError::Success, "");
-
-    // isSafe ? "true" : "false"
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendDeviceState(request, clientTransID, ++serverTransID);
   }
 
   void disconnectHandler(AsyncWebServerRequest *request) override
@@ -604,13 +520,7 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                          "disconnect", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    sendAlpacaResponse(request, 200, clientTransID, ++serverTransID, AlpacaError::Success, "");
   }
 
   void driverInfoHandler(AsyncWebServerRequest *request) override
@@ -632,13 +542,10 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                               "ASCOM Alpaca SafetyMonitor Driver", AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DriverInfoResponse.ready()) {
+      DriverInfoResponse.set("ASCOM Alpaca SafetyMonitor Driver");
+    }
+    DriverInfoResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void driverVersionHandler(AsyncWebServerRequest *request) override
@@ -660,13 +567,10 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                               String(instanceVersion), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!DriverVersionResponse.ready()) {
+      DriverVersionResponse.set(String(instanceVersion));
+    }
+    DriverVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void interfaceVersionHandler(AsyncWebServerRequest *request) override
@@ -688,13 +592,10 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                               3, AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!InterfaceVersionResponse.ready()) {
+      InterfaceVersionResponse.set(3);
+    }
+    InterfaceVersionResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void nameHandler(AsyncWebServerRequest *request) override
@@ -716,13 +617,10 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    AlpacaResponseValueBuilder(root, clientIDInt, clientTransID, ++serverTransID,
-                               GetDeviceName(), AlpacaError::Success, "");
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!NameResponse.ready()) {
+      NameResponse.set(GetDeviceName());
+    }
+    NameResponse.send(request, clientTransID, ++serverTransID);
   }
 
   void supportedActionsHandler(AsyncWebServerRequest *request) override
@@ -744,17 +642,15 @@ public:
       return;
     }
 
-    String message;
-    DynamicJsonBuffer jsonBuff(256);
-    JsonObject &root = jsonBuff.createObject();
-    root["ClientTransactionID"] = clientTransID;
-    root["ServerTransactionID"] = ++serverTransID;
-    root["ErrorNumber"] = static_cast<int>(AlpacaError::Success);
-    root["ErrorMessage"] = "";
-    root.createNestedArray("Value");
-    // No custom actions supported - return empty array
-    root.printTo(message);
-    request->send(200, "application/json", message);
+    if (!SupportedActionsResponse.ready()) {
+      SupportedActionsResponse.setRaw("[]");
+    }
+    SupportedActionsResponse.send(request, clientTransID, ++serverTransID);
+  }
+
+  void setupHandler(AsyncWebServerRequest *request) override {
+    // Default implementation - can be overridden in derived classes
+    request->send(200, "text/html", "<html><body><h1>SafetyMonitor Setup</h1><p>No configuration required.</p></body></html>");
   }
 };
 
@@ -0,0 +1,97 @@
+#ifndef ALPACA_DEVICE_STATE_H
+#define ALPACA_DEVICE_STATE_H
+
+#include <Arduino.h>
+#include <vector>
+#include "ascom_interfaces/AscomTypes.h"
+#include "Alpaca_Response_Writer.h"
+
+/**
+ * @file Alpaca_Device_State.h
+ * @brief Snapshot of a device's operational properties for DeviceState
+ *
+ * A device fills an AlpacaDeviceState with add() calls; each entry is a
+ * StateValue whose value is already JSON encoded. The StateValue slots are
+ * reused between refreshes, so once the snapshot has reached its size a
+ * refresh does not allocate. render() produces the DeviceState array:
+ *
+ *   [{"Name":"Position","Value":1200},{"Name":"IsMoving","Value":false}]
+ *
+ * changedMask() tells which entries differ from the previous refresh (bit i
+ * for entry i; bit 31 stands for entry 31 and all later ones).
+ */
+
+#ifndef ALPACA_DEVICE_STATE_REFRESH_MS
+#define ALPACA_DEVICE_STATE_REFRESH_MS 500
+#endif
+
+class AlpacaDeviceState
+{
+private:
+  std::vector<StateValue> Values;
+  size_t Count = 0;
+  size_t PreviousCount = 0;
+  uint32_t Changed = 0;
+
+  template <typename T>
+  void addEncoded(const char *name, const T &value)
+  {
+    char buffer[ALPACA_RESPONSE_BUFFER_SIZE];
+    AlpacaBufferPrint out(buffer, sizeof(buffer));
+    AlpacaResponseWriter writer(out);
+    writer.literal(value);
+    if (out.overflowed()) {
+      return;
+    }
+    if (Count == Values.size()) {
+      Values.emplace_back();
+    }
+    StateValue &slot = Values[Count];
+    if (slot.name != name || slot.value != out.c_str()) {
+      slot.name = name;
+      slot.value = out.c_str();
+      Changed |= bit(Count);
+    }
+    Count++;
+  }
+
+public:
+  static uint32_t bit(size_t index) { return index < 31 ? (1UL << index) : (1UL << 31); }
+
+  void clear()
+  {
+    PreviousCount = Count;
+    Count = 0;
+    Changed = 0;
+  }
+
+  void add(const char *name, bool value) { addEncoded(name, value); }
+  void add(const char *name, int value) { addEncoded(name, value); }
+  void add(const char *name, double value) { addEncoded(name, value); }
+  void add(const char *name, const char *value) { addEncoded(name, value); }
+
+  size_t size() const { return Count; }
+  uint32_t changedMask() const { return Count < PreviousCount ? 0xFFFFFFFFUL : Changed; }
+  const StateValue &at(size_t index) const { return Values[index]; }
+
+  /**
+   * @brief Render the DeviceState array into @p json
+   */
+  void render(String &json) const
+  {
+    json = "[";
+    for (size_t i = 0; i < Count; i++) {
+      if (i > 0) {
+        json.concat(',');
+      }
+      json.concat("{\"Name\":\"");
+      json.concat(Values[i].name.c_str());
+      json.concat("\",\"Value\":");
+      json.concat(Values[i].value.c_str());
+      json.concat('}');
+    }
+    json.concat(']');
+  }
+};
+
+#endif // ALPACA_DEVICE_STATE_H
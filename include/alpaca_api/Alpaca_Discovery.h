@@ -4,7 +4,8 @@
 #include <ESP8266WiFi.h>
 #include <WiFiUdp.h>
 #include <ArduinoJson.h>
-#include "DebugLog.h"
+#include "Log_Filter.h"
+#include "Deferred_Log.h"
 
 #define ALPACA_DISCOVERY_PORT 32227
 #define ALPACA_DISCOVERY_REQUEST "alpacadiscovery1"
@@ -52,7 +53,7 @@ public:
             
             // Check if this is an Alpaca discovery request
             if (strcmp(incomingPacket, ALPACA_DISCOVERY_REQUEST) == 0) {
-                LOG_INFO("Valid Alpaca discovery request received");
+                LOG_DEFERRED_INFO("Valid Alpaca discovery request received");
                 sendDiscoveryResponse();
             } else {
                 LOG_DEBUG("Ignoring non-Alpaca discovery packet");
@@ -77,7 +78,8 @@ private:
         udp.write((const uint8_t*)response.c_str(), response.length());
         udp.endPacket();
         
-        LOG_INFO("Discovery response sent to " + udp.remoteIP().toString() + ":" + String(udp.remotePort()));
+        IPAddress remote = udp.remoteIP();
+        LOG_DEFERRED_INFO("Discovery response sent to %u.%u.%u.%u:%u", remote[0], remote[1], remote[2], remote[3], udp.remotePort());
     }
 };
 
@@ -0,0 +1,147 @@
+#ifndef ALPACA_EVENT_STREAM_H
+#define ALPACA_EVENT_STREAM_H
+
+#include <ESPAsyncWebServer.h>
+#include <vector>
+#include "Alpaca_Device_State.h"
+#include "Log_Filter.h"
+
+/**
+ * @file Alpaca_Event_Stream.h
+ * @brief Server-Sent Events push of DeviceState changes
+ *
+ * An opt-in `/api/v1/{devicetype}/{devicenumber}/events` text/event-stream.
+ * Every subscriber first gets the full DeviceState, then "state" events that
+ * only carry the properties that changed, as a JSON object:
+ *
+ *   event: state
+ *   data: {"Position":1210,"IsMoving":true}
+ *
+ * Changes are coalesced per subscriber: a subscriber gets at most one event
+ * per ALPACA_EVENTS_MIN_INTERVAL_MS, and none while more than
+ * ALPACA_EVENTS_MAX_QUEUED packets are still waiting for it, so a slow
+ * client only receives the latest values once it has caught up.
+ */
+
+#ifndef ALPACA_EVENTS_SAMPLE_MS
+#define ALPACA_EVENTS_SAMPLE_MS 50
+#endif
+
+#ifndef ALPACA_EVENTS_MIN_INTERVAL_MS
+#define ALPACA_EVENTS_MIN_INTERVAL_MS 100
+#endif
+
+#ifndef ALPACA_EVENTS_MAX_QUEUED
+#define ALPACA_EVENTS_MAX_QUEUED 4
+#endif
+
+#ifndef ALPACA_EVENTS_MAX_SUBSCRIBERS
+#define ALPACA_EVENTS_MAX_SUBSCRIBERS 4
+#endif
+
+class AlpacaEventStream
+{
+private:
+  struct Subscriber
+  {
+    AsyncEventSourceClient *client;
+    uint32_t pending;       // DeviceState entries changed since the last event
+    unsigned long lastSent; // millis() of the last event
+  };
+
+  AsyncEventSource *Source; // owned by the web server
+  std::vector<Subscriber> Subscribers;
+  uint32_t EventId = 0;
+
+  void subscribe(AsyncEventSourceClient *client)
+  {
+    if (Subscribers.size() >= ALPACA_EVENTS_MAX_SUBSCRIBERS) {
+      LOG_WARN("Event stream full, closing new subscriber");
+      client->close();
+      return;
+    }
+    // Full state on the next flush
+    Subscribers.push_back(Subscriber{client, 0xFFFFFFFFUL, millis() - ALPACA_EVENTS_MIN_INTERVAL_MS});
+    LOG_DEBUG("Event subscriber connected, now " + String((int)Subscribers.size()));
+  }
+
+  void unsubscribe(AsyncEventSourceClient *client)
+  {
+    for (auto it = Subscribers.begin(); it != Subscribers.end(); ++it) {
+      if (it->client == client) {
+        Subscribers.erase(it);
+        return;
+      }
+    }
+  }
+
+  static void renderDelta(const AlpacaDeviceState &state, uint32_t mask, String &json)
+  {
+    json = "{";
+    bool first = true;
+    for (size_t i = 0; i < state.size(); i++) {
+      if (!(mask & AlpacaDeviceState::bit(i))) {
+        continue;
+      }
+      if (!first) {
+        json.concat(',');
+      }
+      first = false;
+      json.concat('"');
+      json.concat(state.at(i).name.c_str());
+      json.concat("\":");
+      json.concat(state.at(i).value.c_str());
+    }
+    json.concat('}');
+  }
+
+public:
+  /**
+   * @brief Create the event source at @p url and add it to @p server
+   */
+  AlpacaEventStream(const String &url, AsyncWebServer &server) : Source(new AsyncEventSource(url.c_str()))
+  {
+    Source->onConnect([this](AsyncEventSourceClient *client) { subscribe(client); });
+    Source->onDisconnect([this](AsyncEventSourceClient *client) { unsubscribe(client); });
+    server.addHandler(Source);
+  }
+
+  bool hasSubscribers() const { return !Subscribers.empty(); }
+  size_t subscriberCount() const { return Subscribers.size(); }
+
+  /**
+   * @brief Record DeviceState entries that changed (AlpacaDeviceState::changedMask())
+   */
+  void changed(uint32_t mask)
+  {
+    if (mask == 0) {
+      return;
+    }
+    for (auto &subscriber : Subscribers) {
+      subscriber.pending |= mask;
+    }
+  }
+
+  /**
+   * @brief Send the pending changes to every subscriber that may receive one now
+   */
+  void flush(const AlpacaDeviceState &state)
+  {
+    unsigned long now = millis();
+    String json;
+    for (auto &subscriber : Subscribers) {
+      if (subscriber.pending == 0 ||
+          now - subscriber.lastSent < ALPACA_EVENTS_MIN_INTERVAL_MS ||
+          subscriber.client->packetsWaiting() > ALPACA_EVENTS_MAX_QUEUED) {
+        continue;
+      }
+      renderDelta(state, subscriber.pending, json);
+      if (subscriber.client->send(json.c_str(), "state", ++EventId)) {
+        subscriber.pending = 0;
+        subscriber.lastSent = now;
+      }
+    }
+  }
+};
+
+#endif // ALPACA_EVENT_STREAM_H
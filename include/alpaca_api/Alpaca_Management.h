@@ -9,9 +9,10 @@
 #include "Alpaca_Driver_Settings.h"
 #include "Alpaca_Response_Builder.h"
 #include "Alpaca_Request_Helper.h"
-#include "DebugLog.h"
+#include "Log_Filter.h"
 #include "Aplaca_Device.h"
 #include <vector>
+#include <ESP8266WiFi.h>
 
 
 class AlpacaManagement
@@ -102,6 +103,9 @@ void registerDevice(AsyncWebServer &server, String devicename, String devicetype
     if(device->hasSetupHandler()) {
         LOG_DEBUG("Calling setup handler for device: " + devicename);
         
+        // Handlers also match deeper paths, so /setup/config goes before /setup
+        server.on("/setup/v1/"+device->GetDeviceType()+"/"+String(device->GetDeviceNumber())+"/setup/config", HTTP_GET, [this, device](AsyncWebServerRequest *request){ device->setupConfigHandler(request); });
+        server.on("/setup/v1/"+device->GetDeviceType()+"/"+String(device->GetDeviceNumber())+"/setup/config", HTTP_POST, [this, device](AsyncWebServerRequest *request){ device->setupConfigHandler(request); });
         server.on("/setup/v1/"+device->GetDeviceType()+"/"+String(device->GetDeviceNumber())+"/setup", HTTP_GET, [this, device](AsyncWebServerRequest *request){ device->setupHandler(request); });
         server.on("/setup/v1/"+device->GetDeviceType()+"/"+String(device->GetDeviceNumber())+"/setup", HTTP_POST, [this, device](AsyncWebServerRequest *request){ device->setupHandler(request); });
         
@@ -199,6 +203,10 @@ public:
         server.on("/management/apiversions", HTTP_GET, [this](AsyncWebServerRequest *request){ this->handleMgmtAPIversions(request); });
         server.on("/management/v1/configureddevices", HTTP_GET, [this](AsyncWebServerRequest *request){ this->handleMgmtConfiguredDevices(request); });
         server.on("/management/v1/description", HTTP_GET, [this](AsyncWebServerRequest *request){ this->handleMgmtDescription(request); });    
+        // Request, heap, loop and stepper statistics for Prometheus (see Metrics.h)
+        server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request){ metrics.handle(request); });
+        // Per-task CPU time, ?reset=1 to start over (see Loop_Profiler.h)
+        server.on("/debug/profile", HTTP_GET, [](AsyncWebServerRequest *request){ loopProfiler.handle(request); });
     }
 
 
@@ -4,6 +4,7 @@
 #include <ESPAsyncWebServer.h>
 #include "Alpaca_Errors.h"
 #include "Alpaca_Response_Builder.h"
+#include "Alpaca_Response_Writer.h"
 
 /**
  * @file Alpaca_Request_Helper.h
@@ -15,8 +16,139 @@
  * Functions:
  * - extractClientID: Extract ClientID from GET (query params) or PUT (form body) requests
  * - extractClientTransactionID: Extract ClientTransactionID from GET or PUT requests
+ * - findAlpacaParam / tryGet*Param: look up other parameters through the
+ *   per-request parameter index (AlpacaParamIndex)
  */
 
+#ifndef ALPACA_MAX_INDEXED_PARAMS
+#define ALPACA_MAX_INDEXED_PARAMS 12
+#endif
+
+/**
+ * @brief Parameter index of one request
+ *
+ * Built on first use by walking the request's parameters once. Each entry
+ * keeps the FNV-1a hash of the lower-cased name, so a lookup compares one
+ * integer per parameter and touches the name only on a hash match; no
+ * String is created. The index lives in the request's _tempObject and is
+ * released (free()) by the web server together with the request.
+ *
+ * Name matching follows the Alpaca spec: query parameter names (GET) are
+ * case insensitive, form parameter names (PUT) are case sensitive.
+ */
+struct AlpacaParamIndex
+{
+  static const uint32_t MAGIC = 0x41505849; // "APXI"
+
+  uint32_t magic;
+  uint8_t count;
+  bool overflow; // more parameters than indexed, fall back to the web server's lookup
+  uint32_t hashes[ALPACA_MAX_INDEXED_PARAMS];
+  const AsyncWebParameter *params[ALPACA_MAX_INDEXED_PARAMS];
+};
+
+/**
+ * @brief FNV-1a hash of a parameter name, ignoring case
+ */
+inline uint32_t alpacaParamHash(const char *name)
+{
+  uint32_t hash = 2166136261u;
+  for (const char *p = name; *p != '\0'; p++) {
+    hash ^= (uint8_t)tolower((unsigned char)*p);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+inline void buildAlpacaParamIndex(AsyncWebServerRequest *request, AlpacaParamIndex &index)
+{
+  index.magic = AlpacaParamIndex::MAGIC;
+  index.count = 0;
+  index.overflow = false;
+  size_t total = request->params();
+  for (size_t i = 0; i < total; i++) {
+    const AsyncWebParameter *param = request->getParam(i);
+    if (param == nullptr || param->isFile()) {
+      continue;
+    }
+    if (index.count == ALPACA_MAX_INDEXED_PARAMS) {
+      index.overflow = true;
+      break;
+    }
+    index.hashes[index.count] = alpacaParamHash(param->name().c_str());
+    index.params[index.count] = param;
+    index.count++;
+  }
+}
+
+/**
+ * @brief Parameter index of @p request, built on first use
+ */
+inline const AlpacaParamIndex &alpacaParams(AsyncWebServerRequest *request)
+{
+  AlpacaParamIndex *index = (AlpacaParamIndex *)request->_tempObject;
+  if (index != nullptr && index->magic == AlpacaParamIndex::MAGIC) {
+    return *index;
+  }
+  if (index == nullptr) {
+    index = (AlpacaParamIndex *)malloc(sizeof(AlpacaParamIndex));
+    if (index != nullptr) {
+      request->_tempObject = index;
+      buildAlpacaParamIndex(request, *index);
+      return *index;
+    }
+  }
+  // _tempObject taken by another handler (or out of memory): rebuild on every call
+  static AlpacaParamIndex scratch;
+  buildAlpacaParamIndex(request, scratch);
+  return scratch;
+}
+
+/**
+ * @brief Find a query (fromBody = false) or form (fromBody = true) parameter
+ * @return The parameter or nullptr
+ */
+inline const AsyncWebParameter *findAlpacaParam(AsyncWebServerRequest *request, const char *name, bool fromBody)
+{
+  const AlpacaParamIndex &index = alpacaParams(request);
+  uint32_t hash = alpacaParamHash(name);
+  for (uint8_t i = 0; i < index.count; i++) {
+    const AsyncWebParameter *param = index.params[i];
+    if (index.hashes[i] != hash || param->isPost() != fromBody) {
+      continue;
+    }
+    const char *paramName = param->name().c_str();
+    if (fromBody ? strcmp(paramName, name) == 0 : strcasecmp(paramName, name) == 0) {
+      return param;
+    }
+  }
+  if (index.overflow) {
+    return request->getParam(name, fromBody);
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Parse a non-negative decimal ID such as ClientID
+ * @return false if @p value is empty or not all digits
+ */
+inline bool parseClientIdValue(const String &value, int &id)
+{
+  if (value.length() == 0)
+  {
+    return false;
+  }
+  for (size_t i = 0; i < value.length(); ++i)
+  {
+    if (!isDigit(value[i]))
+    {
+      return false;
+    }
+  }
+  id = atoi(value.c_str());
+  return id >= 0;
+}
+
 /**
  * @brief Extract ClientID from request parameters
  * @param request The AsyncWebServerRequest object
@@ -25,50 +157,21 @@
  * @return true if valid (>= 0), false if invalid (< 0)
  *
  * ClientID is optional per the Alpaca spec. If not present, defaults to 0.
- * Returns false if the parsed value is negative.
+ * Returns false if the parsed value is negative. A form parameter with
+ * different casing is ignored, as form parameter names are case sensitive.
  */
 inline bool extractClientID(AsyncWebServerRequest *request, bool fromBody, int &clientID)
 {
   clientID = 0;
-  if (request->hasParam("ClientID", fromBody))
+  const AsyncWebParameter *param = findAlpacaParam(request, "ClientID", fromBody);
+  if (param == nullptr)
   {
-    String value = request->getParam("ClientID", fromBody)->value();
-    if (value.length() == 0)
-    {
-      return false;
-    }
-    for (size_t i = 0; i < value.length(); ++i)
-    {
-      if (!isDigit(value[i]))
-      {
-        return false;
-      }
-    }
-    clientID = atoi(value.c_str());
-    if (clientID < 0)
-    {
-      return false;
-    }
+    return true;
   }
-  else if (request->hasParam("clientid", fromBody))
+  if (!parseClientIdValue(param->value(), clientID))
   {
-    String value = request->getParam("clientid", fromBody)->value();
-    if (value.length() == 0)
-    {
-      return false;
-    }
-    for (size_t i = 0; i < value.length(); ++i)
-    {
-      if (!isDigit(value[i]))
-      {
-        return false;
-      }
-    }
-    clientID = atoi(value.c_str());
-    if (clientID < 0)
-    {
-      return false;
-    }
+    clientID = 0;
+    return false;
   }
   return true;
 }
@@ -81,60 +184,22 @@ inline bool extractClientID(AsyncWebServerRequest *request, bool fromBody, int &
  * @return true if valid (>= 0), false if invalid (< 0)
  *
  * ClientTransactionID is optional per the Alpaca spec. If not present, defaults to 0.
- * Returns false if the parsed value is negative.
+ * Returns false if the parsed value is negative. A form parameter with
+ * different casing is ignored, as form parameter names are case sensitive.
  */
 inline bool extractClientTransactionID(AsyncWebServerRequest *request, bool fromBody, int &clientTransactionID)
 {
   clientTransactionID = 0;
-  if (request->hasParam("ClientTransactionID", fromBody))
+  const AsyncWebParameter *param = findAlpacaParam(request, "ClientTransactionID", fromBody);
+  if (param == nullptr)
   {
-    String value = request->getParam("ClientTransactionID", fromBody)->value();
-    if (value.length() == 0)
-    {
-      return false;
-    }
-    for (size_t i = 0; i < value.length(); ++i)
-    {
-      if (!isDigit(value[i]))
-      {
-        return false;
-      }
-    }
-    clientTransactionID = atoi(value.c_str());
-    if (clientTransactionID < 0)
-    {
-      return false;
-    }
+    return true;
   }
-  else if (request->hasParam("clienttransactionid", fromBody))
+  if (!parseClientIdValue(param->value(), clientTransactionID))
   {
-    if (!fromBody)
-    {
-      String value = request->getParam("clienttransactionid", fromBody)->value();
-      if (value.length() == 0)
-      {
-        return false;
-      }
-      for (size_t i = 0; i < value.length(); ++i)
-      {
-        if (!isDigit(value[i]))
-        {
-          return false;
-        }
-      }
-      clientTransactionID = atoi(value.c_str());
-      if (clientTransactionID < 0)
-      {
-        return false;
-      }
-    }
-    else
-    {
-      clientTransactionID = 0;
-      return true;
-    }
+    clientTransactionID = 0;
+    return false;
   }
-
   return true;
 }
 
@@ -238,42 +303,40 @@ inline bool isDecimalValue(const String &value, bool allowSign)
   return sawDigit;
 }
 
-inline bool tryGetStringParam(AsyncWebServerRequest *request, const String &name, bool fromBody, String &value)
+inline bool tryGetStringParam(AsyncWebServerRequest *request, const char *name, bool fromBody, String &value)
 {
-  if (!request->hasParam(name, fromBody))
+  const AsyncWebParameter *param = findAlpacaParam(request, name, fromBody);
+  if (param == nullptr)
   {
     return false;
   }
-  value = request->getParam(name, fromBody)->value();
+  value = param->value();
   return value.length() > 0;
 }
 
-inline bool tryGetOptionalStringParam(AsyncWebServerRequest *request, const String &name, bool fromBody, String &value)
+inline bool tryGetOptionalStringParam(AsyncWebServerRequest *request, const char *name, bool fromBody, String &value)
 {
-  if (!request->hasParam(name, fromBody))
+  const AsyncWebParameter *param = findAlpacaParam(request, name, fromBody);
+  if (param == nullptr)
   {
     return false;
   }
-  value = request->getParam(name, fromBody)->value();
+  value = param->value();
   return true;
 }
 
-inline bool tryGetIntParam(AsyncWebServerRequest *request, const String &name, bool fromBody, int &value, bool allowSign = false)
+inline bool tryGetIntParam(AsyncWebServerRequest *request, const char *name, bool fromBody, int &value, bool allowSign = false)
 {
-  String raw;
-  if (!tryGetStringParam(request, name, fromBody, raw))
+  const AsyncWebParameter *param = findAlpacaParam(request, name, fromBody);
+  if (param == nullptr || !isIntegerValue(param->value(), allowSign))
   {
     return false;
   }
-  if (!isIntegerValue(raw, allowSign))
-  {
-    return false;
-  }
-  value = raw.toInt();
+  value = param->value().toInt();
   return true;
 }
 
-inline bool tryGetIntParamAlt(AsyncWebServerRequest *request, const String &name, const String &altName,
+inline bool tryGetIntParamAlt(AsyncWebServerRequest *request, const char *name, const char *altName,
                               bool fromBody, int &value, bool allowSign = false)
 {
   if (tryGetIntParam(request, name, fromBody, value, allowSign))
@@ -283,35 +346,29 @@ inline bool tryGetIntParamAlt(AsyncWebServerRequest *request, const String &name
   return tryGetIntParam(request, altName, fromBody, value, allowSign);
 }
 
-inline bool tryGetDoubleParam(AsyncWebServerRequest *request, const String &name, bool fromBody, double &value, bool allowSign = true)
+inline bool tryGetDoubleParam(AsyncWebServerRequest *request, const char *name, bool fromBody, double &value, bool allowSign = true)
 {
-  String raw;
-  if (!tryGetStringParam(request, name, fromBody, raw))
-  {
-    return false;
-  }
-  if (!isDecimalValue(raw, allowSign))
+  const AsyncWebParameter *param = findAlpacaParam(request, name, fromBody);
+  if (param == nullptr || !isDecimalValue(param->value(), allowSign))
   {
     return false;
   }
-  value = atof(raw.c_str());
+  value = atof(param->value().c_str());
   return true;
 }
 
-inline bool tryGetBoolParam(AsyncWebServerRequest *request, const String &name, bool fromBody, bool &value)
+/**
+ * @brief Parse "true"/"false"/"1"/"0" (any case)
+ */
+inline bool parseBoolValue(const String &raw, bool &value)
 {
-  String raw;
-  if (!tryGetStringParam(request, name, fromBody, raw))
-  {
-    return false;
-  }
-  raw.toLowerCase();
-  if (raw == "true" || raw == "1")
+  const char *text = raw.c_str();
+  if (strcasecmp(text, "true") == 0 || strcmp(text, "1") == 0)
   {
     value = true;
     return true;
   }
-  if (raw == "false" || raw == "0")
+  if (strcasecmp(text, "false") == 0 || strcmp(text, "0") == 0)
   {
     value = false;
     return true;
@@ -319,17 +376,21 @@ inline bool tryGetBoolParam(AsyncWebServerRequest *request, const String &name,
   return false;
 }
 
+inline bool tryGetBoolParam(AsyncWebServerRequest *request, const char *name, bool fromBody, bool &value)
+{
+  const AsyncWebParameter *param = findAlpacaParam(request, name, fromBody);
+  if (param == nullptr)
+  {
+    return false;
+  }
+  return parseBoolValue(param->value(), value);
+}
+
 inline void sendInvalidParamResponse(AsyncWebServerRequest *request, int clientID, int clientTransID,
                                      uint32_t &serverTransID, const String &methodName, const String &paramName)
 {
-  String message;
-  DynamicJsonBuffer jsonBuff(256);
-  JsonObject &root = jsonBuff.createObject();
-  AlpacaResponseBuilder(root, clientID, clientTransID, ++serverTransID,
-                        methodName, AlpacaError::InvalidValue,
-                        "Missing or invalid required parameter: " + paramName);
-  root.printTo(message);
-  request->send(400, "application/json", message);
+  String errMsg = "Missing or invalid required parameter: " + paramName;
+  sendAlpacaResponse(request, 400, clientTransID, ++serverTransID, AlpacaError::InvalidValue, errMsg.c_str());
 }
 
 /**
@@ -340,28 +401,13 @@ inline void sendInvalidParamResponse(AsyncWebServerRequest *request, int clientI
  */
 inline String findInvalidClientIdValue(AsyncWebServerRequest *request, bool fromBody)
 {
-  if (request->hasParam("ClientID", fromBody))
-  {
-    String value = request->getParam("ClientID", fromBody)->value();
-    if (!isNumericValue(value))
-    {
-      return value;
-    }
-  }
-  if (request->hasParam("ClientTransactionID", fromBody))
-  {
-    String value = request->getParam("ClientTransactionID", fromBody)->value();
-    if (!isNumericValue(value))
-    {
-      return value;
-    }
-  }
-  if (request->hasParam("clienttransactionid", fromBody))
+  static const char *const names[] = {"ClientID", "ClientTransactionID", "clienttransactionid"};
+  for (const char *name : names)
   {
-    String value = request->getParam("clienttransactionid", fromBody)->value();
-    if (!isNumericValue(value))
+    const AsyncWebParameter *param = findAlpacaParam(request, name, fromBody);
+    if (param != nullptr && !isNumericValue(param->value()))
     {
-      return value;
+      return param->value();
     }
   }
   return "unknown";
@@ -2,7 +2,7 @@
 #define Alpaca_Response_Builder_h
 
 #include <ArduinoJson.h>
-#include "DebugLog.h"
+#include "Log_Filter.h"
 
 void AlpacaResponseBuilder( JsonObject&, int clientTransID, int transID, int serverTransID, String methodName, int errNum , String errMsg );
 void AlpacaResponseValueBuilder( JsonObject&, int clientTransID, int transID, int serverTransID, String value, int errNum , String errMsg );
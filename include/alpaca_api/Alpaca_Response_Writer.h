@@ -0,0 +1,443 @@
+#ifndef ALPACA_RESPONSE_WRITER_H
+#define ALPACA_RESPONSE_WRITER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "Alpaca_Errors.h"
+#include "Log_Filter.h"
+#include "Metrics.h"
+#include <math.h>
+
+/**
+ * @file Alpaca_Response_Writer.h
+ * @brief Allocation-free writer for the standard Alpaca response envelope
+ *
+ * AlpacaResponseBuilder/AlpacaResponseValueBuilder fill a DynamicJsonBuffer,
+ * print it into a String and hand that String to send(), which costs several
+ * heap allocations per request. The writer below prints the fixed envelope
+ *
+ *   {"ClientTransactionID":1,"ServerTransactionID":2,"ErrorNumber":0,"ErrorMessage":"","Value":...}
+ *
+ * straight into a Print: normally a buffer on the stack, which is then given
+ * to request->send() as a const char* (the web server keeps its own copy).
+ * If the response does not fit, it is rendered again into an
+ * AsyncResponseStream, so long string values still work.
+ *
+ * Number formatting follows ArduinoJson 5 (doubles use up to 9 decimals with
+ * trailing zeros removed), so the output matches the JSON builders.
+ */
+
+#ifndef ALPACA_RESPONSE_BUFFER_SIZE
+#define ALPACA_RESPONSE_BUFFER_SIZE 256
+#endif
+
+/**
+ * @brief Print into a fixed caller-provided buffer, remembering overflow
+ */
+class AlpacaBufferPrint : public Print
+{
+private:
+  char *Buffer;
+  size_t Capacity;
+  size_t Length = 0;
+  bool Overflow = false;
+
+public:
+  AlpacaBufferPrint(char *buffer, size_t capacity) : Buffer(buffer), Capacity(capacity)
+  {
+    Buffer[0] = '\0';
+  }
+
+  size_t write(uint8_t c) override
+  {
+    if (Length + 1 >= Capacity) {
+      Overflow = true;
+      return 0;
+    }
+    Buffer[Length++] = (char)c;
+    Buffer[Length] = '\0';
+    return 1;
+  }
+
+  size_t write(const uint8_t *data, size_t size) override
+  {
+    if (Length + size >= Capacity) {
+      Overflow = true;
+      return 0;
+    }
+    memcpy(Buffer + Length, data, size);
+    Length += size;
+    Buffer[Length] = '\0';
+    return size;
+  }
+  using Print::write;
+
+  const char *c_str() const { return Buffer; }
+  size_t length() const { return Length; }
+  bool overflowed() const { return Overflow; }
+};
+
+/**
+ * @brief Pass-through Print counting the bytes written, for response size metrics
+ */
+class AlpacaCountingPrint : public Print
+{
+private:
+  Print &Out;
+  size_t Count = 0;
+
+public:
+  explicit AlpacaCountingPrint(Print &out) : Out(out) {}
+
+  size_t write(uint8_t c) override
+  {
+    size_t written = Out.write(c);
+    Count += written;
+    return written;
+  }
+
+  size_t write(const uint8_t *data, size_t size) override
+  {
+    size_t written = Out.write(data, size);
+    Count += written;
+    return written;
+  }
+  using Print::write;
+
+  size_t count() const { return Count; }
+};
+
+/**
+ * @brief Streams one Alpaca response object to a Print
+ *
+ * Usage: begin(), optionally one value(), then end().
+ */
+class AlpacaResponseWriter
+{
+private:
+  Print &Out;
+
+  void writeInteger(long value)
+  {
+    char digits[21];
+    snprintf(digits, sizeof(digits), "%ld", value);
+    Out.write(digits);
+  }
+
+  void writeUnsigned(unsigned long value)
+  {
+    char digits[21];
+    snprintf(digits, sizeof(digits), "%lu", value);
+    Out.write(digits);
+  }
+
+  // Shortest "%.9f" rendering, as ArduinoJson 5 prints doubles
+  static void trimDecimals(char *text)
+  {
+    char *dot = strchr(text, '.');
+    if (dot == nullptr) {
+      return;
+    }
+    char *end = text + strlen(text) - 1;
+    while (end > dot && *end == '0') {
+      *end-- = '\0';
+    }
+    if (end == dot) {
+      *dot = '\0';
+    }
+  }
+
+  void writeDouble(double value)
+  {
+    if (isnan(value)) {
+      Out.write("NaN");
+      return;
+    }
+    if (value < 0.0) {
+      Out.write('-');
+      value = -value;
+    }
+    if (isinf(value)) {
+      Out.write("Infinity");
+      return;
+    }
+
+    int exponent = 0;
+    if (value != 0.0 && (value >= 1e7 || value < 1e-5)) {
+      exponent = (int)floor(log10(value));
+      value /= pow(10.0, exponent);
+    }
+
+    char text[32];
+    snprintf(text, sizeof(text), "%.9f", value);
+    trimDecimals(text);
+    Out.write(text);
+    if (exponent != 0) {
+      Out.write('e');
+      writeInteger(exponent);
+    }
+  }
+
+  void writeString(const char *value)
+  {
+    Out.write('"');
+    for (const char *p = value; *p != '\0'; p++) {
+      char c = *p;
+      switch (c) {
+        case '"':  Out.write("\\\""); break;
+        case '\\': Out.write("\\\\"); break;
+        case '\b': Out.write("\\b"); break;
+        case '\f': Out.write("\\f"); break;
+        case '\n': Out.write("\\n"); break;
+        case '\r': Out.write("\\r"); break;
+        case '\t': Out.write("\\t"); break;
+        default:
+          if ((uint8_t)c < 0x20) {
+            char escaped[7];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned)c);
+            Out.write(escaped);
+          } else {
+            Out.write((uint8_t)c);
+          }
+      }
+    }
+    Out.write('"');
+  }
+
+public:
+  explicit AlpacaResponseWriter(Print &out) : Out(out) {}
+
+  /**
+   * @brief Open the object and write the common envelope fields
+   */
+  void begin(int clientTransID, uint32_t serverTransID, AlpacaError errNum, const char *errMsg)
+  {
+    ids(clientTransID, serverTransID);
+    status(errNum, errMsg);
+  }
+
+  /**
+   * @brief Open the object and write the two transaction IDs
+   */
+  void ids(int clientTransID, uint32_t serverTransID)
+  {
+    Out.write("{\"ClientTransactionID\":");
+    writeInteger(clientTransID);
+    Out.write(",\"ServerTransactionID\":");
+    writeUnsigned(serverTransID);
+  }
+
+  /**
+   * @brief Write ErrorNumber and ErrorMessage
+   */
+  void status(AlpacaError errNum, const char *errMsg)
+  {
+    Out.write(",\"ErrorNumber\":");
+    writeInteger(static_cast<int>(errNum));
+    Out.write(",\"ErrorMessage\":");
+    writeString(errMsg != nullptr ? errMsg : "");
+  }
+
+  void value(bool value) { Out.write(value ? ",\"Value\":true" : ",\"Value\":false"); }
+  void value(int value) { Out.write(",\"Value\":"); writeInteger(value); }
+  void value(long value) { Out.write(",\"Value\":"); writeInteger(value); }
+  void value(unsigned int value) { Out.write(",\"Value\":"); writeUnsigned(value); }
+  void value(unsigned long value) { Out.write(",\"Value\":"); writeUnsigned(value); }
+  void value(float value) { Out.write(",\"Value\":"); writeDouble(value); }
+  void value(double value) { Out.write(",\"Value\":"); writeDouble(value); }
+  void value(const char *value) { Out.write(",\"Value\":"); writeString(value != nullptr ? value : ""); }
+  void value(const String &value) { Out.write(",\"Value\":"); writeString(value.c_str()); }
+  void rawValue(const char *json) { Out.write(",\"Value\":"); Out.write(json); }
+
+  /**
+   * @brief Write a bare JSON value (no field name), e.g. inside an array
+   */
+  void literal(bool value) { Out.write(value ? "true" : "false"); }
+  void literal(int value) { writeInteger(value); }
+  void literal(long value) { writeInteger(value); }
+  void literal(unsigned long value) { writeUnsigned(value); }
+  void literal(double value) { writeDouble(value); }
+  void literal(const char *value) { writeString(value != nullptr ? value : ""); }
+
+  /**
+   * @brief Close the object
+   */
+  void end() { Out.write('}'); }
+};
+
+/**
+ * @brief Send an Alpaca response without a Value field
+ * @param request The request to answer
+ * @param code HTTP status code
+ * @param clientTransID Client's transaction ID
+ * @param serverTransID Server's transaction ID (already incremented by the caller)
+ * @param errNum Alpaca error number
+ * @param errMsg Alpaca error message ("" on success)
+ */
+inline void sendAlpacaResponse(AsyncWebServerRequest *request, int code, int clientTransID, uint32_t serverTransID,
+                               AlpacaError errNum, const char *errMsg)
+{
+  char buffer[ALPACA_RESPONSE_BUFFER_SIZE];
+  AlpacaBufferPrint out(buffer, sizeof(buffer));
+  AlpacaResponseWriter writer(out);
+  writer.begin(clientTransID, serverTransID, errNum, errMsg);
+  writer.end();
+
+  if (!out.overflowed()) {
+    LOG_DEBUG("Alpaca response:", out.c_str());
+    metrics.noteResponseBytes(out.length());
+    request->send(code, "application/json", out.c_str());
+    return;
+  }
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->setCode(code);
+  AlpacaCountingPrint counted(*response);
+  AlpacaResponseWriter streamWriter(counted);
+  streamWriter.begin(clientTransID, serverTransID, errNum, errMsg);
+  streamWriter.end();
+  metrics.noteResponseBytes(counted.count());
+  request->send(response);
+}
+
+/**
+ * @brief Send an Alpaca response carrying a Value
+ * @param request The request to answer
+ * @param code HTTP status code
+ * @param clientTransID Client's transaction ID
+ * @param serverTransID Server's transaction ID (already incremented by the caller)
+ * @param value bool, integer, floating point or string value
+ * @param errNum Alpaca error number
+ * @param errMsg Alpaca error message ("" on success)
+ */
+template <typename T>
+inline void sendAlpacaValueResponse(AsyncWebServerRequest *request, int code, int clientTransID, uint32_t serverTransID,
+                                    const T &value, AlpacaError errNum = AlpacaError::Success, const char *errMsg = "")
+{
+  char buffer[ALPACA_RESPONSE_BUFFER_SIZE];
+  AlpacaBufferPrint out(buffer, sizeof(buffer));
+  AlpacaResponseWriter writer(out);
+  writer.begin(clientTransID, serverTransID, errNum, errMsg);
+  writer.value(value);
+  writer.end();
+
+  if (!out.overflowed()) {
+    LOG_DEBUG("Alpaca response:", out.c_str());
+    metrics.noteResponseBytes(out.length());
+    request->send(code, "application/json", out.c_str());
+    return;
+  }
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->setCode(code);
+  AlpacaCountingPrint counted(*response);
+  AlpacaResponseWriter streamWriter(counted);
+  streamWriter.begin(clientTransID, serverTransID, errNum, errMsg);
+  streamWriter.value(value);
+  streamWriter.end();
+  metrics.noteResponseBytes(counted.count());
+  request->send(response);
+}
+
+/**
+ * @brief Pre-rendered response for a value that does not change
+ *
+ * Everything after the two transaction IDs is rendered once by set(), so
+ * serving the response only formats the IDs and copies the stored tail.
+ * Call reset() if the underlying value can change (e.g. from a setup page).
+ *
+ * @code
+ * if (!NameResponse.ready()) {
+ *   NameResponse.set(GetDeviceName());
+ * }
+ * NameResponse.send(request, clientTransID, ++serverTransID);
+ * @endcode
+ */
+class AlpacaResponseTemplate
+{
+private:
+  String Tail;
+  bool Ready = false;
+
+  class TailPrint : public Print
+  {
+  private:
+    String &Out;
+
+  public:
+    explicit TailPrint(String &out) : Out(out) {}
+    size_t write(uint8_t c) override { return Out.concat((char)c) ? 1 : 0; }
+    size_t write(const uint8_t *data, size_t size) override
+    {
+      return Out.concat((const char *)data, (unsigned int)size) ? size : 0;
+    }
+    using Print::write;
+  };
+
+public:
+  bool ready() const { return Ready; }
+
+  void reset()
+  {
+    Tail = String();
+    Ready = false;
+  }
+
+  /**
+   * @brief Render the tail for @p value
+   */
+  template <typename T>
+  void set(const T &value, AlpacaError errNum = AlpacaError::Success, const char *errMsg = "")
+  {
+    Tail = String();
+    TailPrint out(Tail);
+    AlpacaResponseWriter writer(out);
+    writer.status(errNum, errMsg);
+    writer.value(value);
+    writer.end();
+    Ready = true;
+  }
+
+  /**
+   * @brief Render the tail for an already serialised JSON value such as "[]"
+   */
+  void setRaw(const char *json)
+  {
+    Tail = String();
+    TailPrint out(Tail);
+    AlpacaResponseWriter writer(out);
+    writer.status(AlpacaError::Success, "");
+    writer.rawValue(json);
+    writer.end();
+    Ready = true;
+  }
+
+  /**
+   * @brief Send the response with the given transaction IDs
+   */
+  void send(AsyncWebServerRequest *request, int clientTransID, uint32_t serverTransID, int code = 200) const
+  {
+    char buffer[ALPACA_RESPONSE_BUFFER_SIZE];
+    AlpacaBufferPrint out(buffer, sizeof(buffer));
+    AlpacaResponseWriter writer(out);
+    writer.ids(clientTransID, serverTransID);
+    out.write((const uint8_t *)Tail.c_str(), Tail.length());
+
+    if (!out.overflowed()) {
+      metrics.noteResponseBytes(out.length());
+      request->send(code, "application/json", out.c_str());
+      return;
+    }
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->setCode(code);
+    AlpacaCountingPrint counted(*response);
+    AlpacaResponseWriter streamWriter(counted);
+    streamWriter.ids(clientTransID, serverTransID);
+    counted.write((const uint8_t *)Tail.c_str(), Tail.length());
+    metrics.noteResponseBytes(counted.count());
+    request->send(response);
+  }
+};
+
+#endif // ALPACA_RESPONSE_WRITER_H
@@ -0,0 +1,324 @@
+#ifndef ALPACA_ROUTER_H
+#define ALPACA_ROUTER_H
+
+#include <ESPAsyncWebServer.h>
+#include "Alpaca_Driver_Settings.h"
+#include "Alpaca_Admission.h"
+#include "Metrics.h"
+#include "Loop_Profiler.h"
+#include "Log_Filter.h"
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <string.h>
+
+/**
+ * @file Alpaca_Router.h
+ * @brief Single catch-all dispatcher for the device API
+ *
+ * Instead of one AsyncCallbackWebHandler (and one heap String URL) per
+ * endpoint, every device registers its methods in an AlpacaRouteTable and the
+ * server gets exactly one catch-all handler for `/api/v1/`. A request URL
+ * `/api/v1/{devicetype}/{devicenumber}/{method}` is split in place (no
+ * allocation), the device is selected by type and number and the method is
+ * found by binary search over the FNV-1a hashes of the method names.
+ *
+ * Responses for unmatched requests:
+ * - unknown device or method: 404
+ * - known method, wrong HTTP verb: 405
+ *
+ * URLs passed to exclude() (e.g. event streams served by their own handler)
+ * are filtered out, so the catch-all does not shadow them.
+ *
+ * Every request to a known device first passes the router's AlpacaAdmission
+ * (per-client rate limits); a throttled request is given to the device's
+ * cached reply (see AlpacaRouteTable::setCachedReply()) or answered with 429.
+ *
+ * Dispatched handlers are timed into their route's MetricsEndpoint, exported
+ * with the admission counters at /metrics (see Metrics.h).
+ */
+
+/**
+ * @brief FNV-1a hash of the first @p length characters of @p str
+ */
+inline uint32_t alpacaRouteHash(const char *str, size_t length)
+{
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= (uint8_t)str[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief One registered method of a device
+ */
+struct AlpacaRoute
+{
+  uint32_t hash;
+  const char *method; // string literal, not copied
+  WebRequestMethodComposite methods;
+  ArRequestHandlerFunction handler;
+  mutable MetricsEndpoint *stats; // allocated on the first request
+};
+
+/**
+ * @brief Cheap answer for a throttled request, e.g. from the DeviceState snapshot
+ * @return false if there is no cached answer for @p method (not NUL terminated)
+ */
+typedef std::function<bool(const char *method, size_t length, AsyncWebServerRequest *request)> AlpacaCachedReplyFunction;
+
+/**
+ * @brief Methods of one device, kept sorted by name hash
+ */
+class AlpacaRouteTable
+{
+private:
+  String DeviceType;
+  int DeviceNumber;
+  std::vector<AlpacaRoute> Routes;
+  AlpacaCachedReplyFunction CachedReply;
+
+  static bool hashLess(const AlpacaRoute &route, uint32_t hash) { return route.hash < hash; }
+
+public:
+  AlpacaRouteTable(const String &devicetype, int devicenumber)
+      : DeviceType(devicetype), DeviceNumber(devicenumber) {}
+
+  /**
+   * @brief Register a handler for a method of this device
+   * @param method Method name as it appears in the URL, must be a string literal
+   * @param methods HTTP verbs accepted (HTTP_GET, HTTP_PUT, ...)
+   * @param handler Handler to call
+   */
+  void on(const char *method, WebRequestMethodComposite methods, ArRequestHandlerFunction handler)
+  {
+    AlpacaRoute route = {alpacaRouteHash(method, strlen(method)), method, methods, handler, nullptr};
+    auto pos = std::upper_bound(Routes.begin(), Routes.end(), route,
+                                [](const AlpacaRoute &a, const AlpacaRoute &b) { return a.hash < b.hash; });
+    Routes.insert(pos, route);
+  }
+
+  /**
+   * @brief Set the answer used when the client is over its request budget
+   */
+  void setCachedReply(AlpacaCachedReplyFunction reply) { CachedReply = reply; }
+
+  bool replyCached(const char *method, size_t length, AsyncWebServerRequest *request) const
+  {
+    return CachedReply && CachedReply(method, length, request);
+  }
+
+  bool matches(const char *devicetype, size_t typeLength, int devicenumber) const
+  {
+    return DeviceNumber == devicenumber && DeviceType.length() == typeLength &&
+           strncmp(DeviceType.c_str(), devicetype, typeLength) == 0;
+  }
+
+  /**
+   * @brief Run the handler registered for @p method and the request's verb
+   * @return 200 if a handler ran, 404 if the method is unknown, 405 if only the verb did not match
+   */
+  int dispatch(const char *method, size_t length, AsyncWebServerRequest *request) const
+  {
+    uint32_t hash = alpacaRouteHash(method, length);
+    int result = 404;
+    for (auto it = std::lower_bound(Routes.begin(), Routes.end(), hash, hashLess);
+         it != Routes.end() && it->hash == hash; ++it) {
+      if (strncmp(it->method, method, length) != 0 || it->method[length] != '\0') {
+        continue;
+      }
+      if (!(it->methods & request->method())) {
+        result = 405;
+        continue;
+      }
+      static const int profile = loopProfiler.section("http");
+      LoopProfilerScope cycles(profile);
+      uint32_t started = metrics.beginRequest();
+      it->handler(request);
+      metrics.endRequest(it->stats, started);
+      return 200;
+    }
+    return result;
+  }
+
+  size_t size() const { return Routes.size(); }
+
+  /**
+   * @brief Write the request latency histograms of the methods called so far
+   */
+  void writeLatency(MetricsWriter &out) const
+  {
+    char labels[96];
+    for (const AlpacaRoute &route : Routes) {
+      if (route.stats != nullptr) {
+        snprintf(labels, sizeof(labels), "device=\"%s\",number=\"%d\",method=\"%s\"", DeviceType.c_str(), DeviceNumber, route.method);
+        out.histogram("alpaca_request_duration_seconds", labels, route.stats->latency);
+      }
+    }
+  }
+
+  /**
+   * @brief Write the response bytes of the methods called so far
+   */
+  void writeResponseBytes(MetricsWriter &out) const
+  {
+    char labels[96];
+    for (const AlpacaRoute &route : Routes) {
+      if (route.stats != nullptr) {
+        snprintf(labels, sizeof(labels), "device=\"%s\",number=\"%d\",method=\"%s\"", DeviceType.c_str(), DeviceNumber, route.method);
+        out.sample("alpaca_response_bytes_total", labels, route.stats->responseBytes);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Owns the route tables of all devices served by one AsyncWebServer
+ */
+class AlpacaRouter
+{
+private:
+  String Prefix;
+  std::vector<AlpacaRouteTable *> Devices;
+  std::vector<String> Excluded;
+  AlpacaAdmission Admission;
+
+  bool isExcluded(const String &url) const
+  {
+    for (const String &excluded : Excluded) {
+      if (excluded == url) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  AlpacaRouter() : Prefix(String("/api/v") + String(InterfaceVersion) + "/") {}
+
+public:
+  /**
+   * @brief Router for @p server, installing its catch-all handler on first use
+   */
+  static AlpacaRouter &forServer(AsyncWebServer &server)
+  {
+    static std::vector<std::pair<AsyncWebServer *, AlpacaRouter *>> routers;
+    for (auto &entry : routers) {
+      if (entry.first == &server) {
+        return *entry.second;
+      }
+    }
+    AlpacaRouter *router = new AlpacaRouter();
+    routers.push_back(std::make_pair(&server, router));
+    server.on(router->Prefix + "*", HTTP_ANY, [router](AsyncWebServerRequest *request){ router->handle(request); })
+        .setFilter([router](AsyncWebServerRequest *request){ return !router->isExcluded(request->url()); });
+    metrics.addCollector([router](MetricsWriter &out){ router->writeMetrics(out); });
+    LOG_DEBUG("Alpaca router installed at " + router->Prefix + "*");
+    return *router;
+  }
+
+  /**
+   * @brief Create the route table of a device
+   */
+  AlpacaRouteTable &addDevice(const String &devicetype, int devicenumber)
+  {
+    AlpacaRouteTable *table = new AlpacaRouteTable(devicetype, devicenumber);
+    Devices.push_back(table);
+    return *table;
+  }
+
+  /**
+   * @brief Per-client request limits applied before dispatching
+   */
+  AlpacaAdmission &admission() { return Admission; }
+
+  /**
+   * @brief Write the per-method request statistics and admission counters
+   */
+  void writeMetrics(MetricsWriter &out) const
+  {
+    out.family("alpaca_request_duration_seconds", "histogram", "Device API handler time by method");
+    for (const AlpacaRouteTable *device : Devices) {
+      device->writeLatency(out);
+    }
+    out.family("alpaca_response_bytes_total", "counter", "Device API response body bytes by method");
+    for (const AlpacaRouteTable *device : Devices) {
+      device->writeResponseBytes(out);
+    }
+    out.family("alpaca_requests_unrouted_total", "counter", "Device API requests answered 404 or 405 by the router");
+    out.sample("alpaca_requests_unrouted_total", nullptr, (uint64_t)metrics.unroutedCount());
+    out.family("alpaca_admission_admitted_total", "counter", "Requests within their client's budget");
+    out.sample("alpaca_admission_admitted_total", nullptr, (uint64_t)Admission.admittedCount());
+    out.family("alpaca_admission_throttled_total", "counter", "Requests over their client's budget");
+    out.sample("alpaca_admission_throttled_total", nullptr, (uint64_t)Admission.throttledCount());
+    out.family("alpaca_admission_control_total", "counter", "Halt and abort requests, never throttled");
+    out.sample("alpaca_admission_control_total", nullptr, (uint64_t)Admission.controlCount());
+    out.family("alpaca_admission_evicted_total", "counter", "Client buckets reused for another client");
+    out.sample("alpaca_admission_evicted_total", nullptr, (uint64_t)Admission.evictedCount());
+    out.family("alpaca_admission_clients", "gauge", "Clients with a request budget");
+    out.sample("alpaca_admission_clients", nullptr, (uint64_t)Admission.clientCount());
+  }
+
+  /**
+   * @brief Leave @p url under the prefix to another handler
+   */
+  void exclude(const String &url)
+  {
+    Excluded.push_back(url);
+  }
+
+  /**
+   * @brief Dispatch `{prefix}{devicetype}/{devicenumber}/{method}` without allocating
+   */
+  void handle(AsyncWebServerRequest *request)
+  {
+    const String &url = request->url();
+    const char *type = url.c_str() + Prefix.length();
+    const char *typeEnd = strchr(type, '/');
+    if (typeEnd == nullptr || typeEnd == type || !isDigit(typeEnd[1])) {
+      metrics.countUnrouted();
+      request->send(404);
+      return;
+    }
+
+    int devicenumber = 0;
+    const char *p = typeEnd + 1;
+    while (isDigit(*p)) {
+      devicenumber = devicenumber * 10 + (*p++ - '0');
+    }
+    if (*p != '/' || p[1] == '\0' || strchr(p + 1, '/') != nullptr) {
+      metrics.countUnrouted();
+      request->send(404);
+      return;
+    }
+    const char *method = p + 1;
+    size_t methodLength = url.length() - (method - url.c_str());
+
+    for (const AlpacaRouteTable *device : Devices) {
+      if (!device->matches(type, typeEnd - type, devicenumber)) {
+        continue;
+      }
+      if (!Admission.admit(request, method, methodLength)) {
+        if (!device->replyCached(method, methodLength, request)) {
+          Admission.reject(request);
+        }
+        return;
+      }
+      int result = device->dispatch(method, methodLength, request);
+      if (result != 200) {
+        metrics.countUnrouted();
+      }
+      if (result == 405) {
+        request->send(405, "application/json", "{\"ErrorMessage\": \"Method Not Allowed\"}");
+      } else if (result == 404) {
+        request->send(404);
+      }
+      return;
+    }
+    metrics.countUnrouted();
+    request->send(404);
+  }
+};
+
+#endif // ALPACA_ROUTER_H
@@ -0,0 +1,157 @@
+#ifndef ALPACA_SETUP_PAGE_H
+#define ALPACA_SETUP_PAGE_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "Alpaca_Response_Writer.h"
+
+/**
+ * @file Alpaca_Setup_Page.h
+ * @brief Static setup pages with a JSON settings endpoint
+ *
+ * A device with hasSetupHandler() serves its setup page as a pre-gzipped
+ * asset from flash (sendAlpacaSetupAsset()), so showing the page costs no
+ * heap beyond the response itself. The page is static HTML/JS and talks to
+ *
+ *   GET  /setup/v1/{devicetype}/{devicenumber}/setup/config  -> settings and status as one JSON object
+ *   POST /setup/v1/{devicetype}/{devicenumber}/setup/config  -> form fields to change, answered with
+ *        {"ok":true,"restart":false,"messages":["Position set"]}
+ *
+ * which AlpacaManagement routes to AplacaDevice::setupConfigHandler().
+ * Page sources live in web/ and are turned into AlpacaSetupAsset headers by
+ * tools/embed_web_assets.py.
+ */
+
+#ifndef ALPACA_SETUP_CACHE_SECONDS
+#define ALPACA_SETUP_CACHE_SECONDS 86400
+#endif
+
+#ifndef ALPACA_SETUP_MAX_MESSAGES
+#define ALPACA_SETUP_MAX_MESSAGES 12
+#endif
+
+/**
+ * @brief A gzip-compressed page in flash
+ */
+struct AlpacaSetupAsset
+{
+  const uint8_t *data; // PROGMEM
+  size_t length;
+  const char *contentType;
+  const char *etag;    // quoted, changes with the page source
+};
+
+/**
+ * @brief Send @p asset with Content-Encoding: gzip, or 304 if the browser has it already
+ */
+inline void sendAlpacaSetupAsset(AsyncWebServerRequest *request, const AlpacaSetupAsset &asset)
+{
+  const AsyncWebHeader *cached = request->getHeader("If-None-Match");
+  if (cached != nullptr && cached->value() == asset.etag) {
+    AsyncWebServerResponse *response = request->beginResponse(304);
+    response->addHeader("ETag", asset.etag);
+    request->send(response);
+    return;
+  }
+  AsyncWebServerResponse *response = request->beginResponse_P(200, asset.contentType, asset.data, asset.length);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("Cache-Control", "public, max-age=" + String(ALPACA_SETUP_CACHE_SECONDS));
+  response->addHeader("ETag", asset.etag);
+  request->send(response);
+}
+
+/**
+ * @brief Streams a flat JSON object such as the setup settings to a Print
+ *
+ * Usage: field() for every member, then end().
+ */
+class AlpacaJsonObjectWriter
+{
+private:
+  Print &Out;
+  AlpacaResponseWriter Values;
+  bool First = true;
+
+  void key(const char *name)
+  {
+    Out.write(First ? '{' : ',');
+    First = false;
+    Out.write('"');
+    Out.write(name);
+    Out.write("\":");
+  }
+
+public:
+  explicit AlpacaJsonObjectWriter(Print &out) : Out(out), Values(out) {}
+
+  void field(const char *name, bool value) { key(name); Values.literal(value); }
+  void field(const char *name, int value) { key(name); Values.literal(value); }
+  void field(const char *name, long value) { key(name); Values.literal(value); }
+  void field(const char *name, unsigned long value) { key(name); Values.literal(value); }
+  void field(const char *name, double value) { key(name); Values.literal(value); }
+  void field(const char *name, const char *value) { key(name); Values.literal(value); }
+  void field(const char *name, const String &value) { key(name); Values.literal(value.c_str()); }
+
+  void end()
+  {
+    if (First) {
+      Out.write('{');
+    }
+    Out.write('}');
+  }
+};
+
+/**
+ * @brief Outcome of a setup POST: messages (string literals) and whether a restart follows
+ */
+class AlpacaSetupResult
+{
+private:
+  const char *Messages[ALPACA_SETUP_MAX_MESSAGES];
+  size_t Count = 0;
+  bool Ok = true;
+  bool Restart = false;
+
+  void add(const char *message)
+  {
+    if (Count < ALPACA_SETUP_MAX_MESSAGES) {
+      Messages[Count++] = message;
+    }
+  }
+
+public:
+  void done(const char *message) { add(message); }
+  void fail(const char *message)
+  {
+    Ok = false;
+    add(message);
+  }
+  void restart() { Restart = true; }
+
+  bool ok() const { return Ok; }
+  bool restarting() const { return Restart; }
+  size_t size() const { return Count; }
+  const char *message(size_t index) const { return Messages[index]; }
+
+  /**
+   * @brief Answer the POST with {"ok":...,"restart":...,"messages":[...]}
+   */
+  void send(AsyncWebServerRequest *request) const
+  {
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->setCode(Ok ? 200 : 400);
+    AlpacaResponseWriter writer(*response);
+    response->write(Ok ? "{\"ok\":true" : "{\"ok\":false");
+    response->write(Restart ? ",\"restart\":true,\"messages\":[" : ",\"restart\":false,\"messages\":[");
+    for (size_t i = 0; i < Count; i++) {
+      if (i > 0) {
+        response->write(',');
+      }
+      writer.literal(Messages[i]);
+    }
+    response->write("]}");
+    request->send(response);
+  }
+};
+
+#endif // ALPACA_SETUP_PAGE_H
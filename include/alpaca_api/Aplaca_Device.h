@@ -2,8 +2,14 @@
 #define Aplaca_Device_h
 
 #include "UUID.h"
-#include "DebugLog.h"
-#include <EEPROM.h>
+#include "Log_Filter.h"
+#include "Alpaca_Router.h"
+#include "Alpaca_Request_Helper.h"
+#include "Alpaca_Response_Writer.h"
+#include "Alpaca_Device_State.h"
+#include "Alpaca_Event_Stream.h"
+#include "Persistent_Store.h"
+#include "Task_Scheduler.h"
 
 class AplacaDevice
 {
@@ -13,11 +19,17 @@ private:
     int DeviceNumber;
     String UniqueID;
     bool HasSetup = false;
+    AlpacaRouteTable *Routes = nullptr;
+
+    // DeviceState snapshot, refreshed by a scheduler task (or on demand when stale)
+    AlpacaDeviceState DeviceState;
+    AlpacaResponseTemplate DeviceStateResponse;
+    String DeviceStateJson;
+    unsigned long DeviceStateMillis = 0;
+    AlpacaEventStream *Events = nullptr; // created by enableEventStream()
     
-    // EEPROM storage for UniqueID
-    // ArduinoStepper uses bytes 0-7, ArduinoFocuser uses bytes 8-15
-    static const int EEPROM_UNIQUEID_ADDR = 16;  // Start address for UniqueID storage
-    static const int EEPROM_UNIQUEID_LENGTH = 36; // Standard UUID length (xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx)
+    // UniqueID is kept in the persistent store under STORE_KEY_DEVICE_UNIQUEID
+    static const int UNIQUEID_LENGTH = 36; // Standard UUID length (xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx)
 
 
     String GenerateUniqueID()
@@ -28,20 +40,15 @@ private:
     }
     
     /**
-     * @brief Load UniqueID from EEPROM
+     * @brief Load UniqueID from the persistent store
      * @return true if valid ID was loaded, false otherwise
      */
-    bool LoadUniqueIDFromEEPROM()
+    bool LoadUniqueID()
     {
-        char buffer[EEPROM_UNIQUEID_LENGTH + 1];
-        
-        // Read the UniqueID from EEPROM
-        for (int i = 0; i < EEPROM_UNIQUEID_LENGTH; i++) {
-            buffer[i] = EEPROM.read(EEPROM_UNIQUEID_ADDR + i);
-        }
-        buffer[EEPROM_UNIQUEID_LENGTH] = '\0'; // Null terminate
-        
-        String loadedID = String(buffer);
+        persistentStore.begin();
+
+        String loadedID;
+        persistentStore.getString(STORE_KEY_DEVICE_UNIQUEID, loadedID);
         
         // Validate the loaded ID (should be 36 characters and contain hyphens at positions 8, 13, 18, 23)
         if (loadedID.length() == 36 && 
@@ -69,57 +76,156 @@ private:
             
             if (valid) {
                 UniqueID = loadedID;
-                LOG_INFO("Loaded UniqueID from EEPROM: " + UniqueID);
+                LOG_INFO("Loaded UniqueID: " + UniqueID);
                 return true;
             }
         }
         
-        LOG_WARN("Invalid UniqueID in EEPROM, will generate new one");
+        LOG_WARN("No valid stored UniqueID, will generate new one");
         return false;
     }
     
     /**
-     * @brief Save UniqueID to EEPROM
+     * @brief Save UniqueID to the persistent store
      */
-    void SaveUniqueIDToEEPROM()
+    void SaveUniqueID()
     {
-        // Write the UniqueID to EEPROM
-        int idLength = (int)UniqueID.length();
-        for (int i = 0; i < EEPROM_UNIQUEID_LENGTH && i < idLength; i++) {
-            EEPROM.write(EEPROM_UNIQUEID_ADDR + i, UniqueID.charAt(i));
-        }
-        
-        // Pad with zeros if UniqueID is shorter than expected
-        for (int i = idLength; i < EEPROM_UNIQUEID_LENGTH; i++) {
-            EEPROM.write(EEPROM_UNIQUEID_ADDR + i, 0);
-        }
-        
-        EEPROM.commit(); // Commit changes to EEPROM (required for ESP8266)
-        LOG_INFO("Saved UniqueID to EEPROM: " + UniqueID);
+        persistentStore.putString(STORE_KEY_DEVICE_UNIQUEID, UniqueID.substring(0, UNIQUEID_LENGTH));
+        LOG_INFO("Saved UniqueID: " + UniqueID);
     }
 
-    void registerCommonDeviceHandlers(AsyncWebServer &server){  
+    void registerCommonDeviceHandlers(){  
         LOG_DEBUG("Registering common device handlers for DeviceName: " + DeviceName + " DeviceType: " + DeviceType + " DeviceNumber: " + String(DeviceNumber));
-        LOG_DEBUG("Registering action handler at URL: " + (String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/action"));
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/action").c_str(), HTTP_PUT, [this](AsyncWebServerRequest *request){ this->actionHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/commandblind").c_str(), HTTP_PUT, [this](AsyncWebServerRequest *request){ this->commandblindHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/commandbool").c_str(), HTTP_PUT, [this](AsyncWebServerRequest *request){ this->commandboolHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/commandstring").c_str(), HTTP_PUT, [this](AsyncWebServerRequest *request){ this->commandstringHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/connect").c_str(), HTTP_PUT, [this](AsyncWebServerRequest *request){ this->connectHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/connected").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->connectedHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/connected").c_str(), HTTP_PUT, [this](AsyncWebServerRequest *request){ this->connectedHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/connecting").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->connectingHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/description").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->descriptionHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/devicestate").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->deviceStateHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/disconnect").c_str(), HTTP_PUT, [this](AsyncWebServerRequest *request){ this->disconnectHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/driverinfo").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->driverInfoHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/driverversion").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->driverVersionHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/interfaceversion").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->interfaceVersionHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/name").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->nameHandler(request); });
-        server.on((String("/api/v")+String(InterfaceVersion)+"/" + DeviceType + "/" + DeviceNumber + "/supportedactions").c_str(), HTTP_GET, [this](AsyncWebServerRequest *request){ this->supportedActionsHandler(request); });
+        addRoute("action", HTTP_PUT, [this](AsyncWebServerRequest *request){ this->actionHandler(request); });
+        addRoute("commandblind", HTTP_PUT, [this](AsyncWebServerRequest *request){ this->commandblindHandler(request); });
+        addRoute("commandbool", HTTP_PUT, [this](AsyncWebServerRequest *request){ this->commandboolHandler(request); });
+        addRoute("commandstring", HTTP_PUT, [this](AsyncWebServerRequest *request){ this->commandstringHandler(request); });
+        addRoute("connect", HTTP_PUT, [this](AsyncWebServerRequest *request){ this->connectHandler(request); });
+        addRoute("connected", HTTP_GET, [this](AsyncWebServerRequest *request){ this->connectedHandler(request); });
+        addRoute("connected", HTTP_PUT, [this](AsyncWebServerRequest *request){ this->connectedHandler(request); });
+        addRoute("connecting", HTTP_GET, [this](AsyncWebServerRequest *request){ this->connectingHandler(request); });
+        addRoute("description", HTTP_GET, [this](AsyncWebServerRequest *request){ this->descriptionHandler(request); });
+        addRoute("devicestate", HTTP_GET, [this](AsyncWebServerRequest *request){ this->deviceStateHandler(request); });
+        addRoute("disconnect", HTTP_PUT, [this](AsyncWebServerRequest *request){ this->disconnectHandler(request); });
+        addRoute("driverinfo", HTTP_GET, [this](AsyncWebServerRequest *request){ this->driverInfoHandler(request); });
+        addRoute("driverversion", HTTP_GET, [this](AsyncWebServerRequest *request){ this->driverVersionHandler(request); });
+        addRoute("interfaceversion", HTTP_GET, [this](AsyncWebServerRequest *request){ this->interfaceVersionHandler(request); });
+        addRoute("name", HTTP_GET, [this](AsyncWebServerRequest *request){ this->nameHandler(request); });
+        addRoute("supportedactions", HTTP_GET, [this](AsyncWebServerRequest *request){ this->supportedActionsHandler(request); });
         LOG_DEBUG("registerCommonDeviceHandlers Done!");
     }
 
+protected:
+    // ServerTransactionID of every reply this device sends, cached or not
+    uint32_t serverTransID = 0;
+
+    /**
+     * @brief Register a handler for /api/v1/{devicetype}/{devicenumber}/{method}
+     * @param method Method name, must be a string literal (it is not copied)
+     * @param methods HTTP verbs accepted
+     * @param handler Handler to call
+     */
+    void addRoute(const char *method, WebRequestMethodComposite methods, ArRequestHandlerFunction handler)
+    {
+        Routes->on(method, methods, handler);
+    }
+
+    // Pre-rendered responses of the common properties that never change at runtime
+    AlpacaResponseTemplate NameResponse;
+    AlpacaResponseTemplate DescriptionResponse;
+    AlpacaResponseTemplate DriverInfoResponse;
+    AlpacaResponseTemplate DriverVersionResponse;
+    AlpacaResponseTemplate InterfaceVersionResponse;
+    AlpacaResponseTemplate SupportedActionsResponse;
+
+    /**
+     * @brief Drop the pre-rendered responses so they are rebuilt on next use
+     */
+    virtual void invalidateResponseTemplates()
+    {
+        NameResponse.reset();
+        DescriptionResponse.reset();
+        DriverInfoResponse.reset();
+        DriverVersionResponse.reset();
+        InterfaceVersionResponse.reset();
+        SupportedActionsResponse.reset();
+    }
+
+    /**
+     * @brief Add the device's operational properties to the DeviceState snapshot
+     * Called from the update loop, so only read cached device state here.
+     */
+    virtual void collectDeviceState(AlpacaDeviceState &state) { (void)state; }
+
+    /**
+     * @brief Rebuild the DeviceState snapshot; re-renders the response only if a value changed
+     */
+    void refreshDeviceState()
+    {
+        DeviceStateMillis = millis();
+        DeviceState.clear();
+        collectDeviceState(DeviceState);
+
+        if (DeviceState.changedMask() == 0 && DeviceStateResponse.ready()) {
+            return;
+        }
+        DeviceState.render(DeviceStateJson);
+        DeviceStateResponse.setRaw(DeviceStateJson.c_str());
+        if (Events != nullptr) {
+            Events->changed(DeviceState.changedMask());
+        }
+    }
+
+    /**
+     * @brief Answer a DeviceState request from the snapshot
+     * The snapshot is refreshed first if the update loop has not done so recently.
+     */
+    void sendDeviceState(AsyncWebServerRequest *request, int clientTransID, uint32_t serverTransID)
+    {
+        if (!DeviceStateResponse.ready() || millis() - DeviceStateMillis >= 2 * ALPACA_DEVICE_STATE_REFRESH_MS) {
+            refreshDeviceState();
+        }
+        DeviceStateResponse.send(request, clientTransID, serverTransID);
+    }
+
+    /**
+     * @brief Answer a throttled GET for a DeviceState property from the snapshot
+     * @return false if @p method is not part of DeviceState (the router then sends 429)
+     */
+    bool replyFromDeviceState(const char *method, size_t length, AsyncWebServerRequest *request)
+    {
+        if (request->method() != HTTP_GET) {
+            return false;
+        }
+        int clientTransID = 0;
+        extractClientTransactionID(request, false, clientTransID);
+        if (length == 11 && strncmp(method, "devicestate", length) == 0) {
+            sendDeviceState(request, clientTransID, ++serverTransID);
+            return true;
+        }
+
+        const AlpacaDeviceState &state = currentDeviceState();
+        for (size_t i = 0; i < state.size(); i++) {
+            const StateValue &entry = state.at(i);
+            if (entry.name.length() != length || strncasecmp(entry.name.c_str(), method, length) != 0) {
+                continue;
+            }
+            char buffer[ALPACA_RESPONSE_BUFFER_SIZE];
+            AlpacaBufferPrint out(buffer, sizeof(buffer));
+            AlpacaResponseWriter writer(out);
+            writer.begin(clientTransID, ++serverTransID, AlpacaError::Success, "");
+            writer.rawValue(entry.value.c_str());
+            writer.end();
+            if (out.overflowed()) {
+                return false;
+            }
+            metrics.noteResponseBytes(out.length());
+            request->send(200, "application/json", out.c_str());
+            return true;
+        }
+        return false;
+    }
+
 public:
     //Interface
     virtual void registerHandlers(AsyncWebServer &server)=0;
@@ -142,6 +248,58 @@ public:
     virtual bool hasSetupHandler() {return HasSetup;  };
     virtual void setupHandler(AsyncWebServerRequest *request) = 0;
 
+    /**
+     * @brief Settings of the setup page as JSON (GET) or changes to them (POST)
+     * Served at /setup/v1/{devicetype}/{devicenumber}/setup/config, see Alpaca_Setup_Page.h.
+     */
+    virtual void setupConfigHandler(AsyncWebServerRequest *request) { request->send(404); }
+
+    /**
+     * @brief Register the device's periodic work (motion, sensor polls, ...)
+     * Tasks must not block. Overrides should call the base version, which
+     * keeps the DeviceState snapshot up to date.
+     */
+    virtual void registerTasks(TaskScheduler &scheduler)
+    {
+        scheduler.every("devicestate", ALPACA_EVENTS_SAMPLE_MS * 1000UL, TASK_PRIORITY_LOW, [this]() {
+            // Sample fast only while someone is subscribed to the event stream
+            bool subscribed = Events != nullptr && Events->hasSubscribers();
+            if (subscribed || millis() - DeviceStateMillis >= ALPACA_DEVICE_STATE_REFRESH_MS) {
+                refreshDeviceState();
+            }
+            if (subscribed) {
+                Events->flush(DeviceState);
+            }
+        });
+    }
+
+    /**
+     * @brief Serve DeviceState changes at /api/v1/{devicetype}/{devicenumber}/events
+     * Opt-in; call once after the device is created.
+     */
+    void enableEventStream(AsyncWebServer &server)
+    {
+        if (Events != nullptr) {
+            return;
+        }
+        String url = String("/api/v") + String(InterfaceVersion) + "/" + DeviceType + "/" + String(DeviceNumber) + "/events";
+        AlpacaRouter::forServer(server).exclude(url);
+        Events = new AlpacaEventStream(url, server);
+        LOG_INFO("Event stream enabled at " + url);
+    }
+
+    /**
+     * @brief DeviceState snapshot for other publishers (e.g. the MQTT bridge)
+     * Refreshed first if it is older than ALPACA_EVENTS_SAMPLE_MS.
+     */
+    const AlpacaDeviceState &currentDeviceState()
+    {
+        if (!DeviceStateResponse.ready() || millis() - DeviceStateMillis >= ALPACA_EVENTS_SAMPLE_MS) {
+            refreshDeviceState();
+        }
+        return DeviceState;
+    }
+
     //Constructor and getters
     AplacaDevice( String devicename, String devicetype, int devicenumber, AsyncWebServer &server, bool hasSetup=false) {
         DeviceName = devicename;
@@ -149,14 +307,18 @@ public:
         DeviceNumber = devicenumber;
         HasSetup = hasSetup;
         
-        // Try to load UniqueID from EEPROM, generate new one if invalid
-        if (!LoadUniqueIDFromEEPROM()) {
+        // Try to load the stored UniqueID, generate new one if invalid
+        if (!LoadUniqueID()) {
             UniqueID = GenerateUniqueID();
-            SaveUniqueIDToEEPROM();
+            SaveUniqueID();
             LOG_INFO("Generated new UniqueID: " + UniqueID);
         }
         
-        registerCommonDeviceHandlers(server);
+        Routes = &AlpacaRouter::forServer(server).addDevice(DeviceType, DeviceNumber);
+        Routes->setCachedReply([this](const char *method, size_t length, AsyncWebServerRequest *request) {
+            return replyFromDeviceState(method, length, request);
+        });
+        registerCommonDeviceHandlers();
     }
     ~AplacaDevice() {}
 
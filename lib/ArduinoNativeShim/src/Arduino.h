@@ -0,0 +1,278 @@
+#ifndef NATIVE_SHIM_ARDUINO_H
+#define NATIVE_SHIM_ARDUINO_H
+
+/**
+ * @file Arduino.h
+ * @brief Host replacement for the Arduino/ESP8266 core used by the native build
+ *
+ * Provides timing, GPIO, Print/Serial and the ESP object on top of the C++
+ * standard library so that the Alpaca handlers and device implementations can
+ * be compiled and exercised on Linux. GPIO writes are recorded in a pin table
+ * instead of touching hardware; time comes from std::chrono::steady_clock.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+#include <cstdarg>
+
+#include "WString.h"
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define memcpy_P memcpy
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x00
+#define OUTPUT 0x01
+#define INPUT_PULLUP 0x02
+
+#define NATIVE_SHIM_GPIO_COUNT 17
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// ==================== Timing ====================
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// ==================== GPIO ====================
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+/**
+ * @brief Number of digitalWrite() calls issued since start (host only)
+ */
+unsigned long nativeShimDigitalWriteCount();
+
+/**
+ * @brief Write-only GPIO output register (esp8266_peri.h GPOS/GPOC/GP16O)
+ *
+ * Assigning a mask sets (GPOS) or clears (GPOC) the levels of GPIO0..15 in
+ * the pin table in one operation; GP16O sets GPIO16 to bit 0.
+ */
+class NativeShimGpioRegister
+{
+public:
+    enum Kind
+    {
+        SET,
+        CLEAR,
+        GPIO16
+    };
+
+    explicit NativeShimGpioRegister(Kind kind) : RegisterKind(kind) {}
+    NativeShimGpioRegister &operator=(uint32_t mask);
+
+    /**
+     * @brief Number of writes to any GPIO output register since start (host only)
+     */
+    static unsigned long writeCount();
+
+private:
+    Kind RegisterKind;
+};
+
+extern NativeShimGpioRegister GPOS;
+extern NativeShimGpioRegister GPOC;
+extern NativeShimGpioRegister GP16O;
+
+// ==================== Math / characters ====================
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+inline bool isDigit(int c) { return c >= '0' && c <= '9'; }
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isAlphaNumeric(int c) { return isalnum(c) != 0; }
+inline bool isSpace(int c) { return isspace(c) != 0; }
+
+template <typename T, typename L, typename H>
+inline T constrain(T amt, L low, H high)
+{
+    return amt < low ? low : (amt > high ? high : amt);
+}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+using std::max;
+using std::min;
+
+// ==================== Print ====================
+
+class Print;
+
+class Printable
+{
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size--)
+        {
+            n += write(*buffer++);
+        }
+        return n;
+    }
+    size_t write(const char *str) { return str == nullptr ? 0 : write((const uint8_t *)str, strlen(str)); }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    // 0 = a write may block, as in the ESP8266 core
+    virtual int availableForWrite() { return 0; }
+
+    size_t print(const char *str) { return write(str); }
+    size_t print(const String &s) { return write((const uint8_t *)s.c_str(), s.length()); }
+    size_t print(const __FlashStringHelper *str) { return write(reinterpret_cast<const char *>(str)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(int value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(unsigned int value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(long value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(unsigned long value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(double value, int digits = 2) { return print(String(value, (unsigned char)digits)); }
+    size_t print(const Printable &p) { return p.printTo(*this); }
+
+    template <typename T>
+    size_t println(const T &value)
+    {
+        size_t n = print(value);
+        return n + println();
+    }
+    template <typename T>
+    size_t println(const T &value, int format)
+    {
+        size_t n = print(value, format);
+        return n + println();
+    }
+    size_t println() { return write("\r\n"); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char buf[256];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        if (len < 0)
+        {
+            return 0;
+        }
+        return write((const uint8_t *)buf, std::min((size_t)len, sizeof(buf) - 1));
+    }
+};
+
+class Stream : public Print
+{
+protected:
+    unsigned long _timeout = 1000;
+
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+};
+
+/**
+ * @brief Serial port replacement writing to stdout
+ */
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    void flush() { fflush(stdout); }
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+    using Print::write;
+    // An empty ESP8266 UART FIFO; stdout never makes the writer wait
+    int availableForWrite() override { return 128; }
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+// ==================== ESP ====================
+
+#define SPI_FLASH_SEC_SIZE 4096
+#define NATIVE_SHIM_FLASH_SECTORS 4
+
+/**
+ * @brief Replacement for the ESP8266 `ESP` object
+ *
+ * Heap figures are synthetic (the host has no 80 KB heap); the cycle counter
+ * is derived from the steady clock at the ESP8266's 80 MHz so that code doing
+ * cycle arithmetic behaves the same on both targets.
+ *
+ * The flash functions work on NATIVE_SHIM_FLASH_SECTORS sectors in RAM with
+ * NOR semantics: erase sets a sector to 0xFF and writes can only clear bits.
+ * Addresses and sizes must be 4-byte aligned, as on the ESP8266.
+ */
+class EspClass
+{
+public:
+    void reset();
+    void restart();
+    uint32_t getFreeHeap();
+    uint32_t getMaxFreeBlockSize();
+    uint8_t getHeapFragmentation();
+    uint32_t getChipId() { return 0x00A1FACA; }
+    uint32_t getCpuFreqMHz() { return 80; }
+    uint32_t getCycleCount();
+    const char *getSdkVersion() { return "native"; }
+    String getResetReason() { return "native"; }
+
+    bool flashEraseSector(uint32_t sector);
+    bool flashWrite(uint32_t address, const uint32_t *data, size_t size);
+    bool flashRead(uint32_t address, uint32_t *data, size_t size);
+
+    // Host-only helpers
+    unsigned long flashEraseCount();
+    unsigned long flashWriteCount();
+    // Let @p operations more erases/writes succeed, then fail all (-1: never fail)
+    void flashFailAfter(long operations);
+};
+
+extern EspClass ESP;
+
+// Sketch entry points, provided by main.cpp
+void setup(void);
+void loop(void);
+
+#endif /* NATIVE_SHIM_ARDUINO_H */
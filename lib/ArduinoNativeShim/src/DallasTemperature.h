@@ -0,0 +1,138 @@
+#ifndef NATIVE_SHIM_DALLASTEMPERATURE_H
+#define NATIVE_SHIM_DALLASTEMPERATURE_H
+
+/**
+ * @file DallasTemperature.h
+ * @brief Simulated DS18B20 driver for the native build
+ *
+ * Every probe on the bus reports the same configurable temperature.
+ * Conversions take the DS18B20's datasheet time for the configured
+ * resolution: requestTemperatures() sleeps for it while waitForConversion is
+ * set, otherwise isConversionComplete() turns true once it has elapsed.
+ */
+
+#include <Arduino.h>
+#include "OneWire.h"
+
+#define DEVICE_DISCONNECTED_C -127
+#define DEVICE_DISCONNECTED_F -196.6
+#define DEVICE_DISCONNECTED_RAW -7040
+
+typedef uint8_t DeviceAddress[8];
+
+class DallasTemperature
+{
+private:
+    OneWire *_wire;
+    uint8_t _resolution = 12;
+    bool _waitForConversion = true;
+    unsigned long _requestMillis = 0;
+
+public:
+    /**
+     * @brief Temperature every simulated probe reports (host only)
+     */
+    static float &simulatedTemperature()
+    {
+        static float value = 20.0f;
+        return value;
+    }
+    /**
+     * @brief Number of probes the simulated bus enumerates (host only)
+     */
+    static uint8_t &simulatedDeviceCount()
+    {
+        static uint8_t value = 1;
+        return value;
+    }
+
+    DallasTemperature() : _wire(nullptr) {}
+    explicit DallasTemperature(OneWire *wire) : _wire(wire) {}
+
+    void begin() {}
+    uint8_t getDeviceCount() { return simulatedDeviceCount(); }
+    bool getAddress(uint8_t *address, uint8_t index)
+    {
+        if (index >= simulatedDeviceCount())
+        {
+            return false;
+        }
+        const uint8_t rom[8] = {0x28, 0xCC, 0xA7, 0xB3, 0x00, 0x00, index, 0x00};
+        memcpy(address, rom, sizeof(rom));
+        address[7] = OneWire::crc8(address, 7);
+        return true;
+    }
+    bool validAddress(const uint8_t *address) { return OneWire::crc8(address, 7) == address[7]; }
+    bool isConnected(const uint8_t *address) { return validAddress(address); }
+
+    bool setResolution(const uint8_t *address, uint8_t bits, bool skipGlobalCalc = false)
+    {
+        (void)address;
+        (void)skipGlobalCalc;
+        _resolution = bits;
+        return true;
+    }
+    void setResolution(uint8_t bits) { _resolution = bits; }
+    uint8_t getResolution() { return _resolution; }
+    uint8_t getResolution(const uint8_t *address)
+    {
+        (void)address;
+        return _resolution;
+    }
+
+    void setWaitForConversion(bool flag) { _waitForConversion = flag; }
+    bool getWaitForConversion() { return _waitForConversion; }
+    bool isConversionComplete()
+    {
+        return millis() - _requestMillis >= (unsigned long)millisToWaitForConversion(_resolution);
+    }
+    int16_t millisToWaitForConversion(uint8_t bitResolution)
+    {
+        switch (bitResolution)
+        {
+        case 9: return 94;
+        case 10: return 188;
+        case 11: return 375;
+        default: return 750;
+        }
+    }
+
+    struct request_t
+    {
+        bool result;
+        unsigned long timestamp;
+        operator bool() { return result; }
+    };
+
+    request_t requestTemperatures()
+    {
+        _requestMillis = millis();
+        if (_waitForConversion)
+        {
+            delay(millisToWaitForConversion(_resolution));
+        }
+        return request_t{true, _requestMillis};
+    }
+    request_t requestTemperaturesByAddress(const uint8_t *address)
+    {
+        (void)address;
+        return requestTemperatures();
+    }
+    request_t requestTemperaturesByIndex(uint8_t index)
+    {
+        request_t request = requestTemperatures();
+        request.result = index < simulatedDeviceCount();
+        return request;
+    }
+
+    float getTempCByIndex(uint8_t index)
+    {
+        return index < simulatedDeviceCount() ? simulatedTemperature() : DEVICE_DISCONNECTED_C;
+    }
+    float getTempC(const uint8_t *address)
+    {
+        return validAddress(address) && address[6] < simulatedDeviceCount() ? simulatedTemperature() : DEVICE_DISCONNECTED_C;
+    }
+};
+
+#endif /* NATIVE_SHIM_DALLASTEMPERATURE_H */
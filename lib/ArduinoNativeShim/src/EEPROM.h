@@ -0,0 +1,99 @@
+#ifndef NATIVE_SHIM_EEPROM_H
+#define NATIVE_SHIM_EEPROM_H
+
+/**
+ * @file EEPROM.h
+ * @brief Host replacement for the ESP8266 flash-emulated EEPROM
+ *
+ * Keeps the emulated sector in RAM (erased state 0xFF, like a fresh chip)
+ * and counts commit() calls so host runs can report flash wear.
+ */
+
+#include <Arduino.h>
+
+class EEPROMClass
+{
+private:
+    static const size_t SECTOR_SIZE = 4096;
+    uint8_t _data[SECTOR_SIZE];
+    size_t _size = 0;
+    bool _dirty = false;
+    unsigned long _commits = 0;
+
+public:
+    EEPROMClass() { memset(_data, 0xFF, sizeof(_data)); }
+
+    void begin(size_t size) { _size = std::min(size, (size_t)SECTOR_SIZE); }
+    bool end()
+    {
+        bool ok = commit();
+        _size = 0;
+        return ok;
+    }
+
+    uint8_t read(int address) const
+    {
+        return (address >= 0 && (size_t)address < _size) ? _data[address] : 0;
+    }
+    void write(int address, uint8_t value)
+    {
+        if (address >= 0 && (size_t)address < _size && _data[address] != value)
+        {
+            _data[address] = value;
+            _dirty = true;
+        }
+    }
+
+    template <typename T>
+    T &get(int address, T &t)
+    {
+        if (address >= 0 && address + sizeof(T) <= _size)
+        {
+            memcpy((uint8_t *)&t, _data + address, sizeof(T));
+        }
+        return t;
+    }
+
+    template <typename T>
+    const T &put(int address, const T &t)
+    {
+        if (address >= 0 && address + sizeof(T) <= _size &&
+            memcmp(_data + address, (const uint8_t *)&t, sizeof(T)) != 0)
+        {
+            memcpy(_data + address, (const uint8_t *)&t, sizeof(T));
+            _dirty = true;
+        }
+        return t;
+    }
+
+    bool commit()
+    {
+        if (_size == 0)
+        {
+            return false;
+        }
+        if (_dirty)
+        {
+            ++_commits;
+            _dirty = false;
+        }
+        return true;
+    }
+
+    uint8_t *getDataPtr()
+    {
+        _dirty = true;
+        return _data;
+    }
+    const uint8_t *getConstDataPtr() const { return _data; }
+    size_t length() const { return _size; }
+
+    /**
+     * @brief Number of commits that actually rewrote the sector (host only)
+     */
+    unsigned long commitCount() const { return _commits; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif /* NATIVE_SHIM_EEPROM_H */
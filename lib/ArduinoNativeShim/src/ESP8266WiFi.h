@@ -0,0 +1,94 @@
+#ifndef NATIVE_SHIM_ESP8266WIFI_H
+#define NATIVE_SHIM_ESP8266WIFI_H
+
+/**
+ * @file ESP8266WiFi.h
+ * @brief Host replacement for the ESP8266 WiFi stack
+ *
+ * There is no radio on the host: station mode "connects" immediately and
+ * reports the loopback address so the firmware takes its normal code path.
+ */
+
+#include <Arduino.h>
+#include "IPAddress.h"
+
+typedef enum WiFiMode
+{
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} WiFiMode_t;
+
+typedef enum
+{
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_WRONG_PASSWORD = 6,
+    WL_DISCONNECTED = 7
+} wl_status_t;
+
+class ESP8266WiFiClass
+{
+private:
+    WiFiMode_t _mode = WIFI_OFF;
+    wl_status_t _status = WL_DISCONNECTED;
+    String _hostname = "native-host";
+    String _ssid;
+    String _apSsid;
+
+public:
+    bool mode(WiFiMode_t m)
+    {
+        _mode = m;
+        return true;
+    }
+    WiFiMode_t getMode() const { return _mode; }
+
+    bool hostname(const char *name)
+    {
+        _hostname = name;
+        return true;
+    }
+    bool hostname(const String &name) { return hostname(name.c_str()); }
+    String hostname() const { return _hostname; }
+
+    wl_status_t begin(const char *ssid, const char *passphrase = nullptr)
+    {
+        (void)passphrase;
+        _ssid = ssid;
+        _status = _ssid.length() > 0 ? WL_CONNECTED : WL_NO_SSID_AVAIL;
+        return _status;
+    }
+    bool disconnect(bool wifioff = false)
+    {
+        (void)wifioff;
+        _status = WL_DISCONNECTED;
+        return true;
+    }
+    wl_status_t status() const { return _status; }
+    bool isConnected() const { return _status == WL_CONNECTED; }
+
+    IPAddress localIP() const { return _status == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress(); }
+    String SSID() const { return _ssid; }
+    int32_t RSSI() const { return -42; }
+    String macAddress() const { return "02:00:00:00:00:01"; }
+
+    bool softAP(const char *ssid, const char *passphrase = nullptr)
+    {
+        (void)passphrase;
+        _apSsid = ssid;
+        return true;
+    }
+    IPAddress softAPIP() const { return IPAddress(192, 168, 4, 1); }
+    String softAPSSID() const { return _apSsid; }
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif /* NATIVE_SHIM_ESP8266WIFI_H */
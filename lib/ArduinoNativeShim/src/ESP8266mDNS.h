@@ -0,0 +1,25 @@
+#ifndef NATIVE_SHIM_ESP8266MDNS_H
+#define NATIVE_SHIM_ESP8266MDNS_H
+
+#include <Arduino.h>
+
+class MDNSResponder
+{
+public:
+    bool begin(const char *hostname)
+    {
+        (void)hostname;
+        return true;
+    }
+    void addService(const char *service, const char *proto, uint16_t port)
+    {
+        (void)service;
+        (void)proto;
+        (void)port;
+    }
+    void update() {}
+};
+
+extern MDNSResponder MDNS;
+
+#endif /* NATIVE_SHIM_ESP8266MDNS_H */
@@ -0,0 +1,303 @@
+#ifndef NATIVE_SHIM_ESPASYNCTCP_H
+#define NATIVE_SHIM_ESPASYNCTCP_H
+
+/**
+ * @file ESPAsyncTCP.h
+ * @brief Host replacement for ESPAsyncTCP's AsyncClient
+ *
+ * For the web server shim a client only carries the remote address of a
+ * request. connect() opens a non-blocking POSIX socket instead; yield(),
+ * called after every loop(), polls the open connections and runs the
+ * callbacks from there, as lwIP runs them between loop iterations on the
+ * board. Nothing blocks: connect() returns at once, add() only buffers up to
+ * space() and send() writes what the socket takes.
+ */
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "IPAddress.h"
+#include "lwip/err.h"
+
+class AsyncClient;
+
+typedef std::function<void(void *, AsyncClient *)> AcConnectHandler;
+typedef std::function<void(void *, AsyncClient *, void *data, size_t len)> AcDataHandler;
+typedef std::function<void(void *, AsyncClient *, int8_t error)> AcErrorHandler;
+
+#define ASYNC_WRITE_FLAG_COPY 0x01
+
+class AsyncClient
+{
+private:
+    // TCP_SND_BUF of the ESP8266 core: two segments
+    static const size_t SEND_BUFFER = 2 * 1460;
+
+    IPAddress _remoteIP;
+    uint16_t _remotePort;
+    int _fd = -1;
+    bool _connecting = false;
+    std::vector<uint8_t> _tx;
+
+    AcConnectHandler _connectCb;
+    void *_connectArg = nullptr;
+    AcConnectHandler _disconnectCb;
+    void *_disconnectArg = nullptr;
+    AcDataHandler _dataCb;
+    void *_dataArg = nullptr;
+    AcErrorHandler _errorCb;
+    void *_errorArg = nullptr;
+
+    // Clients with an open socket; never destroyed, so clients may outlive it at exit
+    static std::vector<AsyncClient *> &open()
+    {
+        static std::vector<AsyncClient *> *clients = new std::vector<AsyncClient *>();
+        return *clients;
+    }
+
+    void detach()
+    {
+        if (_fd >= 0)
+        {
+            ::close(_fd);
+        }
+        _fd = -1;
+        _connecting = false;
+        _tx.clear();
+        auto &clients = open();
+        clients.erase(std::remove(clients.begin(), clients.end(), this), clients.end());
+    }
+
+    void fail(int8_t error)
+    {
+        if (_errorCb)
+        {
+            _errorCb(_errorArg, this, error);
+        }
+        close(true);
+    }
+
+    void flush()
+    {
+        if (_fd < 0 || _connecting || _tx.empty())
+        {
+            return;
+        }
+        ssize_t n = ::send(_fd, _tx.data(), _tx.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            _tx.erase(_tx.begin(), _tx.begin() + n);
+        }
+        else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            fail(ERR_RST);
+        }
+    }
+
+    void poll()
+    {
+        if (_connecting)
+        {
+            pollfd pfd = {_fd, POLLOUT, 0};
+            if (::poll(&pfd, 1, 0) != 1)
+            {
+                return;
+            }
+            int error = 0;
+            socklen_t length = sizeof(error);
+            if (getsockopt(_fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0)
+            {
+                fail(ERR_CONN);
+                return;
+            }
+            _connecting = false;
+            if (_connectCb)
+            {
+                _connectCb(_connectArg, this);
+            }
+            return;
+        }
+        flush();
+        uint8_t buffer[512];
+        while (_fd >= 0)
+        {
+            ssize_t n = ::recv(_fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (n > 0)
+            {
+                if (_dataCb)
+                {
+                    _dataCb(_dataArg, this, buffer, (size_t)n);
+                }
+            }
+            else if (n == 0)
+            {
+                close(true);
+            }
+            else
+            {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                {
+                    fail(ERR_RST);
+                }
+                break;
+            }
+        }
+    }
+
+public:
+    AsyncClient(IPAddress ip = IPAddress(127, 0, 0, 1), uint16_t port = 40000) : _remoteIP(ip), _remotePort(port) {}
+    // Copies carry the address only, not the connection
+    AsyncClient(const AsyncClient &other) : _remoteIP(other._remoteIP), _remotePort(other._remotePort) {}
+    AsyncClient &operator=(const AsyncClient &) = delete;
+    ~AsyncClient() { detach(); }
+
+    IPAddress remoteIP() const { return _remoteIP; }
+    uint16_t remotePort() const { return _remotePort; }
+
+    /**
+     * @brief Start connecting to @p ip:@p port; onConnect or onError/onDisconnect follow
+     * @return false if the connection could not be started
+     */
+    bool connect(IPAddress ip, uint16_t port)
+    {
+        if (_fd >= 0)
+        {
+            return false;
+        }
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return false;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = (uint32_t)ip;
+        if (::connect(fd, (const sockaddr *)&address, sizeof(address)) < 0 && errno != EINPROGRESS)
+        {
+            ::close(fd);
+            return false;
+        }
+        _fd = fd;
+        _connecting = true;
+        _remoteIP = ip;
+        _remotePort = port;
+        open().push_back(this);
+        return true;
+    }
+
+    /**
+     * @brief Close the connection; onDisconnect runs before this returns
+     */
+    void close(bool now = false)
+    {
+        (void)now;
+        if (_fd < 0)
+        {
+            return;
+        }
+        detach();
+        if (_disconnectCb)
+        {
+            _disconnectCb(_disconnectArg, this);
+        }
+    }
+    void abort() { close(true); }
+
+    bool connecting() const { return _fd >= 0 && _connecting; }
+    bool connected() const { return _fd >= 0 && !_connecting; }
+    bool disconnected() const { return _fd < 0; }
+
+    size_t space() const { return connected() ? SEND_BUFFER - _tx.size() : 0; }
+
+    size_t add(const char *data, size_t size, uint8_t apiflags = ASYNC_WRITE_FLAG_COPY)
+    {
+        (void)apiflags;
+        size = std::min(size, space());
+        _tx.insert(_tx.end(), (const uint8_t *)data, (const uint8_t *)data + size);
+        return size;
+    }
+    bool send()
+    {
+        flush();
+        return connected();
+    }
+    size_t write(const char *data, size_t size)
+    {
+        size_t added = add(data, size);
+        send();
+        return added;
+    }
+
+    void setNoDelay(bool nodelay) { (void)nodelay; }
+    void setRxTimeout(uint32_t timeout) { (void)timeout; }
+
+    void onConnect(AcConnectHandler cb, void *arg = nullptr)
+    {
+        _connectCb = cb;
+        _connectArg = arg;
+    }
+    void onDisconnect(AcConnectHandler cb, void *arg = nullptr)
+    {
+        _disconnectCb = cb;
+        _disconnectArg = arg;
+    }
+    void onData(AcDataHandler cb, void *arg = nullptr)
+    {
+        _dataCb = cb;
+        _dataArg = arg;
+    }
+    void onError(AcErrorHandler cb, void *arg = nullptr)
+    {
+        _errorCb = cb;
+        _errorArg = arg;
+    }
+
+    const char *errorToString(int8_t error) const
+    {
+        switch (error)
+        {
+        case ERR_OK:
+            return "OK";
+        case ERR_TIMEOUT:
+            return "Timeout";
+        case ERR_CONN:
+            return "Not Connected";
+        case ERR_ABRT:
+            return "Connection Aborted";
+        case ERR_RST:
+            return "Connection Reset";
+        default:
+            return "UNKNOWN";
+        }
+    }
+
+    /**
+     * @brief Service every open connection; called from yield()
+     */
+    static void pollAll()
+    {
+        std::vector<AsyncClient *> clients = open(); // callbacks may open or close connections
+        for (AsyncClient *client : clients)
+        {
+            auto &current = open();
+            if (std::find(current.begin(), current.end(), client) != current.end())
+            {
+                client->poll();
+            }
+        }
+    }
+};
+
+#endif /* NATIVE_SHIM_ESPASYNCTCP_H */
@@ -0,0 +1,641 @@
+#ifndef NATIVE_SHIM_ESPASYNCWEBSERVER_H
+#define NATIVE_SHIM_ESPASYNCWEBSERVER_H
+
+/**
+ * @file ESPAsyncWebServer.h
+ * @brief In-process replacement for ESPAsyncWebServer on the native build
+ *
+ * Implements the subset of the ESPAsyncWebServer 3.x API used by this project.
+ * Instead of a TCP listener, requests are constructed in memory and fed to
+ * AsyncWebServer::handle(), which walks the registered handlers in order with
+ * the same URI/method matching rules as the real library. The response sent
+ * by the handler is captured on the request for inspection.
+ *
+ * Example:
+ * @code
+ * AsyncWebServerRequest request(HTTP_GET, "/api/v1/focuser/0/position?ClientID=1&ClientTransactionID=7");
+ * server.handle(&request);
+ * request.responseCode();   // 200
+ * request.responseBody();   // {"ClientTransactionID":7,...}
+ * @endcode
+ */
+
+#include <Arduino.h>
+#include <functional>
+#include <memory>
+#include "IPAddress.h"
+#include "ESPAsyncTCP.h"
+
+typedef enum
+{
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+class AsyncWebServerResponse;
+
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+typedef std::function<bool(AsyncWebServerRequest *request)> ArRequestFilterFunction;
+
+// ==================== Parameters ====================
+
+class AsyncWebParameter
+{
+private:
+    String _name;
+    String _value;
+    size_t _size;
+    bool _isForm;
+    bool _isFile;
+
+public:
+    AsyncWebParameter(const String &name, const String &value, bool form = false, bool file = false, size_t size = 0)
+        : _name(name), _value(value), _size(size), _isForm(form), _isFile(file) {}
+    const String &name() const { return _name; }
+    const String &value() const { return _value; }
+    size_t size() const { return _size; }
+    bool isPost() const { return _isForm; }
+    bool isFile() const { return _isFile; }
+};
+
+// ==================== Responses ====================
+
+class AsyncWebServerResponse
+{
+protected:
+    int _code;
+    String _contentType;
+    String _content;
+    std::vector<std::pair<String, String>> _headers;
+
+public:
+    AsyncWebServerResponse(int code = 200, const String &contentType = String(), const String &content = String())
+        : _code(code), _contentType(contentType), _content(content) {}
+    virtual ~AsyncWebServerResponse() {}
+
+    void setCode(int code) { _code = code; }
+    void setContentType(const String &type) { _contentType = type; }
+    void setContentLength(size_t len) { (void)len; }
+    bool addHeader(const String &name, const String &value, bool replaceExisting = true)
+    {
+        if (replaceExisting)
+        {
+            for (auto &header : _headers)
+            {
+                if (header.first.equalsIgnoreCase(name))
+                {
+                    header.second = value;
+                    return true;
+                }
+            }
+        }
+        _headers.emplace_back(name, value);
+        return true;
+    }
+
+    int code() const { return _code; }
+    const String &contentType() const { return _contentType; }
+    const String &content() const { return _content; }
+    const std::vector<std::pair<String, String>> &headers() const { return _headers; }
+};
+
+/**
+ * @brief Response assembled through the Print interface
+ */
+class AsyncResponseStream : public AsyncWebServerResponse, public Print
+{
+public:
+    AsyncResponseStream(const String &contentType, size_t bufferSize)
+        : AsyncWebServerResponse(200, contentType)
+    {
+        _content.reserve((unsigned int)bufferSize);
+    }
+    size_t write(uint8_t c) override
+    {
+        _content.concat((char)c);
+        return 1;
+    }
+    size_t write(const uint8_t *data, size_t len) override
+    {
+        _content.concat((const char *)data, (unsigned int)len);
+        return len;
+    }
+    using Print::write;
+};
+
+// ==================== Request ====================
+
+/**
+ * @brief One request header
+ */
+class AsyncWebHeader
+{
+private:
+    String _name;
+    String _value;
+
+public:
+    AsyncWebHeader(const String &name, const String &value) : _name(name), _value(value) {}
+    const String &name() const { return _name; }
+    const String &value() const { return _value; }
+};
+
+class AsyncWebServerRequest
+{
+private:
+    WebRequestMethodComposite _method;
+    String _url;
+    std::vector<AsyncWebParameter> _params;
+    std::vector<AsyncWebHeader> _headers;
+    AsyncClient _client;
+    std::unique_ptr<AsyncWebServerResponse> _response;
+
+    static String urlDecode(const char *begin, const char *end)
+    {
+        String decoded;
+        decoded.reserve((unsigned int)(end - begin));
+        for (const char *p = begin; p < end; ++p)
+        {
+            if (*p == '+')
+            {
+                decoded.concat(' ');
+            }
+            else if (*p == '%' && end - p > 2 && isxdigit((unsigned char)p[1]) && isxdigit((unsigned char)p[2]))
+            {
+                char hex[3] = {p[1], p[2], 0};
+                decoded.concat((char)strtol(hex, nullptr, 16));
+                p += 2;
+            }
+            else
+            {
+                decoded.concat(*p);
+            }
+        }
+        return decoded;
+    }
+
+    void parseParams(const char *data, bool form)
+    {
+        while (*data)
+        {
+            const char *end = strchr(data, '&');
+            if (end == nullptr)
+            {
+                end = data + strlen(data);
+            }
+            const char *eq = (const char *)memchr(data, '=', end - data);
+            if (end > data)
+            {
+                if (eq != nullptr)
+                {
+                    _params.emplace_back(urlDecode(data, eq), urlDecode(eq + 1, end), form);
+                }
+                else
+                {
+                    _params.emplace_back(urlDecode(data, end), String(), form);
+                }
+            }
+            data = *end ? end + 1 : end;
+        }
+    }
+
+public:
+    // Per-request scratch memory for handlers; like the library, released with free()
+    void *_tempObject = nullptr;
+
+    /**
+     * @brief Build a request in memory (host only)
+     * @param method HTTP method
+     * @param url Path with optional "?query" part, parsed into GET parameters
+     * @param formBody Optional application/x-www-form-urlencoded body, parsed into POST parameters
+     * @param client Remote peer reported by client()
+     */
+    AsyncWebServerRequest(WebRequestMethodComposite method, const String &url, const String &formBody = String(),
+                          AsyncClient client = AsyncClient())
+        : _method(method), _client(client)
+    {
+        int query = url.indexOf('?');
+        if (query >= 0)
+        {
+            _url = url.substring(0, (unsigned int)query);
+            parseParams(url.c_str() + query + 1, false);
+        }
+        else
+        {
+            _url = url;
+        }
+        parseParams(formBody.c_str(), true);
+    }
+    ~AsyncWebServerRequest()
+    {
+        free(_tempObject);
+    }
+
+    WebRequestMethodComposite method() const { return _method; }
+    const String &url() const { return _url; }
+    AsyncClient *client() { return &_client; }
+    const char *methodToString() const
+    {
+        switch (_method)
+        {
+        case HTTP_GET: return "GET";
+        case HTTP_POST: return "POST";
+        case HTTP_DELETE: return "DELETE";
+        case HTTP_PUT: return "PUT";
+        case HTTP_PATCH: return "PATCH";
+        case HTTP_HEAD: return "HEAD";
+        case HTTP_OPTIONS: return "OPTIONS";
+        default: return "UNKNOWN";
+        }
+    }
+
+    size_t params() const { return _params.size(); }
+    const AsyncWebParameter *getParam(size_t num) const { return num < _params.size() ? &_params[num] : nullptr; }
+    bool hasParam(const String &name, bool post = false, bool file = false) const
+    {
+        return getParam(name, post, file) != nullptr;
+    }
+    const AsyncWebParameter *getParam(const String &name, bool post = false, bool file = false) const
+    {
+        for (const auto &param : _params)
+        {
+            if (param.name() == name && param.isPost() == post && param.isFile() == file)
+            {
+                return &param;
+            }
+        }
+        return nullptr;
+    }
+    bool hasArg(const char *name) const
+    {
+        for (const auto &param : _params)
+        {
+            if (param.name() == name)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool hasHeader(const char *name) const { return getHeader(name) != nullptr; }
+    const AsyncWebHeader *getHeader(const char *name) const
+    {
+        for (const auto &header : _headers)
+        {
+            if (header.name().equalsIgnoreCase(name))
+            {
+                return &header;
+            }
+        }
+        return nullptr;
+    }
+
+    AsyncWebServerResponse *beginResponse(int code, const String &contentType = String(), const String &content = String())
+    {
+        return new AsyncWebServerResponse(code, contentType, content);
+    }
+    AsyncWebServerResponse *beginResponse(int code, const String &contentType, const uint8_t *content, size_t len)
+    {
+        return new AsyncWebServerResponse(code, contentType, String((const char *)content, len));
+    }
+    AsyncWebServerResponse *beginResponse_P(int code, const String &contentType, const uint8_t *content, size_t len)
+    {
+        return beginResponse(code, contentType, content, len);
+    }
+    AsyncResponseStream *beginResponseStream(const String &contentType, size_t bufferSize = 1460)
+    {
+        return new AsyncResponseStream(contentType, bufferSize);
+    }
+
+    void send(AsyncWebServerResponse *response) { _response.reset(response); }
+    void send(int code, const String &contentType = String(), const String &content = String())
+    {
+        send(beginResponse(code, contentType, content));
+    }
+    void send_P(int code, const String &contentType, const uint8_t *content, size_t len)
+    {
+        send(beginResponse_P(code, contentType, content, len));
+    }
+    void redirect(const String &url)
+    {
+        AsyncWebServerResponse *response = beginResponse(302);
+        response->addHeader("Location", url);
+        send(response);
+    }
+
+    // ==================== Host-only inspection ====================
+
+    void addRequestHeader(const String &name, const String &value) { _headers.emplace_back(name, value); }
+    bool hasResponse() const { return _response != nullptr; }
+    const AsyncWebServerResponse *response() const { return _response.get(); }
+    int responseCode() const { return _response ? _response->code() : 0; }
+    String responseBody() const { return _response ? _response->content() : String(); }
+    String responseHeader(const char *name) const
+    {
+        if (_response)
+        {
+            for (const auto &header : _response->headers())
+            {
+                if (header.first.equalsIgnoreCase(name))
+                {
+                    return header.second;
+                }
+            }
+        }
+        return String();
+    }
+};
+
+// ==================== Handlers ====================
+
+class AsyncWebHandler
+{
+private:
+    ArRequestFilterFunction _filter;
+
+public:
+    virtual ~AsyncWebHandler() {}
+    AsyncWebHandler &setFilter(ArRequestFilterFunction fn)
+    {
+        _filter = fn;
+        return *this;
+    }
+    bool filter(AsyncWebServerRequest *request) { return !_filter || _filter(request); }
+    virtual bool canHandle(AsyncWebServerRequest *request) const = 0;
+    virtual void handleRequest(AsyncWebServerRequest *request) = 0;
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler
+{
+private:
+    String _uri;
+    WebRequestMethodComposite _method = HTTP_ANY;
+    ArRequestHandlerFunction _onRequest;
+
+public:
+    void setUri(const String &uri) { _uri = uri; }
+    void setMethod(WebRequestMethodComposite method) { _method = method; }
+    void onRequest(ArRequestHandlerFunction fn) { _onRequest = fn; }
+
+    bool canHandle(AsyncWebServerRequest *request) const override
+    {
+        if (!_onRequest || !(_method & request->method()))
+        {
+            return false;
+        }
+        if (_uri.length() && _uri.startsWith("/*."))
+        {
+            String ext = _uri.substring(_uri.indexOf('.'));
+            return request->url().endsWith(ext);
+        }
+        if (_uri.length() && _uri.endsWith("*"))
+        {
+            return request->url().startsWith(_uri.substring(0, _uri.length() - 1));
+        }
+        if (_uri.length() && _uri != request->url() && !request->url().startsWith(_uri + "/"))
+        {
+            return false;
+        }
+        return true;
+    }
+
+    void handleRequest(AsyncWebServerRequest *request) override
+    {
+        if (_onRequest)
+        {
+            _onRequest(request);
+        }
+        else
+        {
+            request->send(500);
+        }
+    }
+};
+
+// ==================== Server-Sent Events ====================
+
+/**
+ * @brief One subscriber of an AsyncEventSource
+ *
+ * On the host, sent events are kept in messages() and the send queue depth
+ * reported by packetsWaiting() can be set to simulate a slow client.
+ */
+class AsyncEventSourceClient
+{
+private:
+    AsyncClient _client;
+    uint32_t _lastId = 0;
+    bool _connected = true;
+    size_t _packetsWaiting = 0;
+    std::vector<String> _messages;
+
+public:
+    explicit AsyncEventSourceClient(AsyncClient client) : _client(client) {}
+
+    bool send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0)
+    {
+        if (!_connected)
+        {
+            return false;
+        }
+        String text;
+        if (reconnect)
+        {
+            text += "retry: " + String(reconnect) + "\n";
+        }
+        if (id)
+        {
+            text += "id: " + String(id) + "\n";
+            _lastId = id;
+        }
+        if (event != nullptr)
+        {
+            text += "event: " + String(event) + "\n";
+        }
+        text += "data: " + String(message) + "\n\n";
+        _messages.push_back(text);
+        return true;
+    }
+    bool connected() const { return _connected; }
+    void close() { _connected = false; }
+    uint32_t lastId() const { return _lastId; }
+    size_t packetsWaiting() const { return _packetsWaiting; }
+    AsyncClient *client() { return &_client; }
+
+    // Host-only inspection
+    const std::vector<String> &messages() const { return _messages; }
+    void clearMessages() { _messages.clear(); }
+    void setPacketsWaiting(size_t packets) { _packetsWaiting = packets; }
+};
+
+typedef std::function<void(AsyncEventSourceClient *client)> ArEventHandlerFunction;
+
+/**
+ * @brief text/event-stream endpoint; a GET of its URL subscribes a client
+ */
+class AsyncEventSource : public AsyncWebHandler
+{
+private:
+    String _url;
+    std::vector<std::unique_ptr<AsyncEventSourceClient>> _clients;
+    ArEventHandlerFunction _connectcb;
+    ArEventHandlerFunction _disconnectcb;
+
+public:
+    enum SendStatus
+    {
+        DISCARDED = 0,
+        ENQUEUED,
+        PARTIALLY_ENQUEUED,
+    };
+
+    explicit AsyncEventSource(const char *url) : _url(url) {}
+    const char *url() const { return _url.c_str(); }
+    void onConnect(ArEventHandlerFunction cb) { _connectcb = cb; }
+    void onDisconnect(ArEventHandlerFunction cb) { _disconnectcb = cb; }
+
+    SendStatus send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0)
+    {
+        size_t sent = 0;
+        for (auto &client : _clients)
+        {
+            sent += client->send(message, event, id, reconnect) ? 1 : 0;
+        }
+        return sent == 0 ? DISCARDED : (sent == _clients.size() ? ENQUEUED : PARTIALLY_ENQUEUED);
+    }
+    size_t count() const { return _clients.size(); }
+    size_t avgPacketsWaiting() const
+    {
+        size_t total = 0;
+        for (auto &client : _clients)
+        {
+            total += client->packetsWaiting();
+        }
+        return _clients.empty() ? 0 : total / _clients.size();
+    }
+    void close()
+    {
+        while (!_clients.empty())
+        {
+            disconnect(_clients.front().get());
+        }
+    }
+
+    bool canHandle(AsyncWebServerRequest *request) const override
+    {
+        return request->method() == HTTP_GET && request->url() == _url;
+    }
+    void handleRequest(AsyncWebServerRequest *request) override
+    {
+        request->send(200, "text/event-stream");
+        _clients.emplace_back(new AsyncEventSourceClient(*request->client()));
+        if (_connectcb)
+        {
+            _connectcb(_clients.back().get());
+        }
+    }
+
+    // Host-only: the subscriber went away
+    void disconnect(AsyncEventSourceClient *client)
+    {
+        for (auto it = _clients.begin(); it != _clients.end(); ++it)
+        {
+            if (it->get() == client)
+            {
+                client->close();
+                if (_disconnectcb)
+                {
+                    _disconnectcb(client);
+                }
+                _clients.erase(it);
+                return;
+            }
+        }
+    }
+    AsyncEventSourceClient *client(size_t index) { return index < _clients.size() ? _clients[index].get() : nullptr; }
+};
+
+// ==================== Server ====================
+
+class AsyncWebServer
+{
+private:
+    uint16_t _port;
+    std::vector<std::unique_ptr<AsyncWebHandler>> _handlers;
+    ArRequestHandlerFunction _notFound;
+
+public:
+    explicit AsyncWebServer(uint16_t port) : _port(port) {}
+
+    void begin() {}
+    void end() {}
+    void reset()
+    {
+        _handlers.clear();
+        _notFound = nullptr;
+    }
+
+    AsyncCallbackWebHandler &on(const String &uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest)
+    {
+        AsyncCallbackWebHandler *handler = new AsyncCallbackWebHandler();
+        handler->setUri(uri);
+        handler->setMethod(method);
+        handler->onRequest(onRequest);
+        _handlers.emplace_back(handler);
+        return *handler;
+    }
+    AsyncCallbackWebHandler &on(const String &uri, ArRequestHandlerFunction onRequest)
+    {
+        return on(uri, HTTP_ANY, onRequest);
+    }
+    AsyncWebHandler &addHandler(AsyncWebHandler *handler)
+    {
+        _handlers.emplace_back(handler);
+        return *handler;
+    }
+    void onNotFound(ArRequestHandlerFunction fn) { _notFound = fn; }
+
+    // ==================== Host-only dispatch ====================
+
+    /**
+     * @brief Route a request through the registered handlers (first match wins)
+     * @return true if a registered handler accepted the request
+     */
+    bool handle(AsyncWebServerRequest *request)
+    {
+        for (auto &handler : _handlers)
+        {
+            if (handler->filter(request) && handler->canHandle(request))
+            {
+                handler->handleRequest(request);
+                return true;
+            }
+        }
+        if (_notFound)
+        {
+            _notFound(request);
+        }
+        else
+        {
+            request->send(404);
+        }
+        return false;
+    }
+
+    uint16_t port() const { return _port; }
+    size_t handlerCount() const { return _handlers.size(); }
+    AsyncWebHandler *handler(size_t index) { return index < _handlers.size() ? _handlers[index].get() : nullptr; }
+};
+
+#endif /* NATIVE_SHIM_ESPASYNCWEBSERVER_H */
@@ -0,0 +1,47 @@
+#ifndef NATIVE_SHIM_IPADDRESS_H
+#define NATIVE_SHIM_IPADDRESS_H
+
+#include <Arduino.h>
+
+/**
+ * @brief IPv4 address value type matching the Arduino core API
+ */
+class IPAddress : public Printable
+{
+private:
+    uint8_t _address[4];
+
+public:
+    IPAddress() : _address{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address{a, b, c, d} {}
+    explicit IPAddress(uint32_t address)
+    {
+        memcpy(_address, &address, sizeof(_address));
+    }
+
+    operator uint32_t() const
+    {
+        uint32_t address;
+        memcpy(&address, _address, sizeof(address));
+        return address;
+    }
+    bool operator==(const IPAddress &other) const { return memcmp(_address, other._address, sizeof(_address)) == 0; }
+    bool operator!=(const IPAddress &other) const { return !(*this == other); }
+    uint8_t operator[](int index) const { return _address[index]; }
+    uint8_t &operator[](int index) { return _address[index]; }
+    uint8_t *raw_address() { return _address; }
+
+    String toString() const
+    {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address[0], _address[1], _address[2], _address[3]);
+        return String(buf);
+    }
+
+    size_t printTo(Print &p) const override
+    {
+        return p.print(toString());
+    }
+};
+
+#endif /* NATIVE_SHIM_IPADDRESS_H */
@@ -0,0 +1,31 @@
+/**
+ * @file NativeMain.cpp
+ * @brief Host entry point running the sketch like the Arduino core does
+ *
+ * Kept in its own translation unit so that programs providing their own
+ * main() (benchmarks, tests) do not pull it out of the library archive.
+ * Set NATIVE_LOOP_ITERATIONS to bound the run, e.g. for CI smoke tests.
+ */
+
+#include <Arduino.h>
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    setup();
+#ifdef NATIVE_LOOP_ITERATIONS
+    for (unsigned long i = 0; i < NATIVE_LOOP_ITERATIONS; ++i)
+    {
+        loop();
+        yield();
+    }
+#else
+    for (;;)
+    {
+        loop();
+        yield();
+    }
+#endif
+    return 0;
+}
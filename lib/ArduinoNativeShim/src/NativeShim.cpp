@@ -0,0 +1,296 @@
+/**
+ * @file NativeShim.cpp
+ * @brief Global objects and runtime functions of the host Arduino shim
+ */
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <ESP8266WiFi.h>
+#include <ESP8266mDNS.h>
+#include <ESPAsyncTCP.h>
+#include <lwip/dns.h>
+#include <netdb.h>
+#include <chrono>
+#include <thread>
+#include <random>
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+ESP8266WiFiClass WiFi;
+MDNSResponder MDNS;
+
+namespace
+{
+const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+uint8_t pinModes[NATIVE_SHIM_GPIO_COUNT];
+uint8_t pinLevels[NATIVE_SHIM_GPIO_COUNT];
+unsigned long digitalWrites = 0;
+unsigned long gpioRegisterWrites = 0;
+
+uint8_t flash[NATIVE_SHIM_FLASH_SECTORS * SPI_FLASH_SEC_SIZE];
+bool flashErased = false;
+unsigned long flashErases = 0;
+unsigned long flashWrites = 0;
+long flashBudget = -1; // erases/writes left before flash fails, -1 = unlimited
+
+// Simulated power loss: false once the budget set by flashFailAfter() is used up
+bool flashPowered()
+{
+    if (flashBudget == 0)
+    {
+        return false;
+    }
+    if (flashBudget > 0)
+    {
+        --flashBudget;
+    }
+    return true;
+}
+
+bool flashRange(uint32_t address, size_t size)
+{
+    if (!flashErased)
+    {
+        memset(flash, 0xFF, sizeof(flash));
+        flashErased = true;
+    }
+    return (address % 4) == 0 && (size % 4) == 0 && address + size <= sizeof(flash);
+}
+
+std::minstd_rand &rng()
+{
+    static std::minstd_rand engine(1);
+    return engine;
+}
+}
+
+// ==================== Timing ====================
+
+unsigned long millis()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - startTime)
+        .count();
+}
+
+unsigned long micros()
+{
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - startTime)
+        .count();
+}
+
+void delay(unsigned long ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield()
+{
+    AsyncClient::pollAll();
+}
+
+// ==================== DNS ====================
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg)
+{
+    (void)found;
+    (void)callback_arg;
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    addrinfo *result = nullptr;
+    if (hostname == nullptr || getaddrinfo(hostname, nullptr, &hints, &result) != 0 || result == nullptr)
+    {
+        return ERR_ARG;
+    }
+    addr->addr = (uint32_t)((const sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(result);
+    return ERR_OK;
+}
+
+// ==================== GPIO ====================
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (pin < NATIVE_SHIM_GPIO_COUNT)
+    {
+        pinModes[pin] = mode;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    ++digitalWrites;
+    if (pin < NATIVE_SHIM_GPIO_COUNT)
+    {
+        pinLevels[pin] = val ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    return pin < NATIVE_SHIM_GPIO_COUNT ? pinLevels[pin] : LOW;
+}
+
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    return 512;
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+    digitalWrite(pin, val > 0 ? HIGH : LOW);
+}
+
+unsigned long nativeShimDigitalWriteCount()
+{
+    return digitalWrites;
+}
+
+NativeShimGpioRegister GPOS(NativeShimGpioRegister::SET);
+NativeShimGpioRegister GPOC(NativeShimGpioRegister::CLEAR);
+NativeShimGpioRegister GP16O(NativeShimGpioRegister::GPIO16);
+
+NativeShimGpioRegister &NativeShimGpioRegister::operator=(uint32_t mask)
+{
+    ++gpioRegisterWrites;
+    if (RegisterKind == GPIO16)
+    {
+        pinLevels[16] = (mask & 1) ? HIGH : LOW;
+        return *this;
+    }
+    for (uint8_t pin = 0; pin < 16; pin++)
+    {
+        if (mask & (1UL << pin))
+        {
+            pinLevels[pin] = RegisterKind == SET ? HIGH : LOW;
+        }
+    }
+    return *this;
+}
+
+unsigned long NativeShimGpioRegister::writeCount()
+{
+    return gpioRegisterWrites;
+}
+
+// ==================== Random ====================
+
+long random(long howbig)
+{
+    if (howbig <= 0)
+    {
+        return 0;
+    }
+    return (long)(rng()() % (unsigned long)howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+    {
+        return howsmall;
+    }
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0)
+    {
+        rng().seed((std::minstd_rand::result_type)seed);
+    }
+}
+
+// ==================== ESP ====================
+
+void EspClass::reset()
+{
+    Serial.println("ESP.reset() requested - exiting native firmware");
+    Serial.flush();
+    exit(0);
+}
+
+void EspClass::restart()
+{
+    reset();
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    return 80 * 1024;
+}
+
+uint32_t EspClass::getMaxFreeBlockSize()
+{
+    return 80 * 1024;
+}
+
+uint8_t EspClass::getHeapFragmentation()
+{
+    return 0;
+}
+
+uint32_t EspClass::getCycleCount()
+{
+    return (uint32_t)(micros() * getCpuFreqMHz());
+}
+
+bool EspClass::flashEraseSector(uint32_t sector)
+{
+    if (!flashRange(sector * SPI_FLASH_SEC_SIZE, SPI_FLASH_SEC_SIZE) || !flashPowered())
+    {
+        return false;
+    }
+    memset(flash + sector * SPI_FLASH_SEC_SIZE, 0xFF, SPI_FLASH_SEC_SIZE);
+    ++flashErases;
+    return true;
+}
+
+bool EspClass::flashWrite(uint32_t address, const uint32_t *data, size_t size)
+{
+    if (!flashRange(address, size) || !flashPowered())
+    {
+        return false;
+    }
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        flash[address + i] &= bytes[i];
+    }
+    ++flashWrites;
+    return true;
+}
+
+bool EspClass::flashRead(uint32_t address, uint32_t *data, size_t size)
+{
+    if (!flashRange(address, size))
+    {
+        return false;
+    }
+    memcpy(data, flash + address, size);
+    return true;
+}
+
+unsigned long EspClass::flashEraseCount()
+{
+    return flashErases;
+}
+
+unsigned long EspClass::flashWriteCount()
+{
+    return flashWrites;
+}
+
+void EspClass::flashFailAfter(long operations)
+{
+    flashBudget = operations;
+}
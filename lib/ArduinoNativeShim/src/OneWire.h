@@ -0,0 +1,48 @@
+#ifndef NATIVE_SHIM_ONEWIRE_H
+#define NATIVE_SHIM_ONEWIRE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Placeholder 1-Wire bus; DallasTemperature is simulated on the host
+ */
+class OneWire
+{
+private:
+    uint8_t _pin;
+
+public:
+    OneWire() : _pin(0) {}
+    explicit OneWire(uint8_t pin) : _pin(pin) {}
+    void begin(uint8_t pin) { _pin = pin; }
+    uint8_t pin() const { return _pin; }
+    uint8_t reset() { return 1; }
+    void reset_search() {}
+    bool search(uint8_t *newAddr, bool search_mode = true)
+    {
+        (void)newAddr;
+        (void)search_mode;
+        return false;
+    }
+    static uint8_t crc8(const uint8_t *addr, uint8_t len)
+    {
+        uint8_t crc = 0;
+        while (len--)
+        {
+            uint8_t inbyte = *addr++;
+            for (uint8_t i = 8; i; i--)
+            {
+                uint8_t mix = (crc ^ inbyte) & 0x01;
+                crc >>= 1;
+                if (mix)
+                {
+                    crc ^= 0x8C;
+                }
+                inbyte >>= 1;
+            }
+        }
+        return crc;
+    }
+};
+
+#endif /* NATIVE_SHIM_ONEWIRE_H */
@@ -0,0 +1,7 @@
+#ifndef NATIVE_SHIM_STREAM_H
+#define NATIVE_SHIM_STREAM_H
+
+// Stream lives in Arduino.h; libraries such as PubSubClient include it by this name
+#include <Arduino.h>
+
+#endif /* NATIVE_SHIM_STREAM_H */
@@ -0,0 +1,347 @@
+#ifndef NATIVE_SHIM_WSTRING_H
+#define NATIVE_SHIM_WSTRING_H
+
+/**
+ * @file WString.h
+ * @brief Host replacement for the Arduino String class
+ *
+ * Backed by std::string so every allocation goes through the global
+ * operator new and can be counted by host-side benchmarks. Only the subset
+ * of the Arduino API used by this project (and by ArduinoJson 5) is provided.
+ */
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <ostream>
+#include <type_traits>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+class String
+{
+protected:
+    std::string _buffer;
+
+    static std::string fromDouble(double value, unsigned char decimalPlaces)
+    {
+        char buf[40];
+        snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+        return buf;
+    }
+
+public:
+    String() {}
+    String(const char *cstr) : _buffer(cstr != nullptr ? cstr : "") {}
+    String(const char *cstr, size_t length) : _buffer(cstr, length) {}
+    String(const std::string &str) : _buffer(str) {}
+    String(const __FlashStringHelper *str) : _buffer(reinterpret_cast<const char *>(str)) {}
+    explicit String(char c) : _buffer(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) : String((unsigned long)value, base) {}
+    explicit String(int value, unsigned char base = 10) : String((long)value, base) {}
+    explicit String(unsigned int value, unsigned char base = 10) : String((unsigned long)value, base) {}
+    explicit String(long value, unsigned char base = 10)
+    {
+        if (base == 10)
+        {
+            _buffer = std::to_string(value);
+        }
+        else
+        {
+            char buf[72];
+            bool negative = value < 0;
+            unsigned long magnitude = negative ? 0UL - (unsigned long)value : (unsigned long)value;
+            char *p = buf + sizeof(buf) - 1;
+            *p = '\0';
+            do
+            {
+                unsigned long digit = magnitude % base;
+                *--p = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+                magnitude /= base;
+            } while (magnitude != 0);
+            if (negative)
+            {
+                *--p = '-';
+            }
+            _buffer = p;
+        }
+    }
+    explicit String(unsigned long value, unsigned char base = 10)
+    {
+        char buf[72];
+        char *p = buf + sizeof(buf) - 1;
+        *p = '\0';
+        do
+        {
+            unsigned long digit = value % base;
+            *--p = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+            value /= base;
+        } while (value != 0);
+        _buffer = p;
+    }
+    explicit String(long long value) : _buffer(std::to_string(value)) {}
+    explicit String(unsigned long long value) : _buffer(std::to_string(value)) {}
+    explicit String(float value, unsigned char decimalPlaces = 2) : _buffer(fromDouble(value, decimalPlaces)) {}
+    explicit String(double value, unsigned char decimalPlaces = 2) : _buffer(fromDouble(value, decimalPlaces)) {}
+
+    // Memory management
+    bool reserve(unsigned int size)
+    {
+        _buffer.reserve(size);
+        return true;
+    }
+    unsigned int length() const { return (unsigned int)_buffer.length(); }
+    bool isEmpty() const { return _buffer.empty(); }
+    const char *c_str() const { return _buffer.c_str(); }
+    char *begin() { return &_buffer[0]; }
+    char *end() { return &_buffer[0] + _buffer.length(); }
+    const char *begin() const { return _buffer.c_str(); }
+    const char *end() const { return _buffer.c_str() + _buffer.length(); }
+
+    // Concatenation
+    bool concat(const String &str)
+    {
+        _buffer += str._buffer;
+        return true;
+    }
+    bool concat(const char *cstr)
+    {
+        if (cstr == nullptr)
+        {
+            return false;
+        }
+        _buffer += cstr;
+        return true;
+    }
+    bool concat(const char *cstr, unsigned int length)
+    {
+        if (cstr == nullptr)
+        {
+            return false;
+        }
+        _buffer.append(cstr, length);
+        return true;
+    }
+    bool concat(char c)
+    {
+        _buffer += c;
+        return true;
+    }
+    bool concat(unsigned char value) { return concat(String(value)); }
+    bool concat(int value) { return concat(String(value)); }
+    bool concat(unsigned int value) { return concat(String(value)); }
+    bool concat(long value) { return concat(String(value)); }
+    bool concat(unsigned long value) { return concat(String(value)); }
+    bool concat(long long value) { return concat(String(value)); }
+    bool concat(unsigned long long value) { return concat(String(value)); }
+    bool concat(float value) { return concat(String(value)); }
+    bool concat(double value) { return concat(String(value)); }
+    bool concat(const __FlashStringHelper *str) { return concat(reinterpret_cast<const char *>(str)); }
+
+    template <typename T>
+    String &operator+=(const T &rhs)
+    {
+        concat(rhs);
+        return *this;
+    }
+    String &operator+=(const char *cstr)
+    {
+        concat(cstr);
+        return *this;
+    }
+
+    // Comparison
+    int compareTo(const String &s) const { return _buffer.compare(s._buffer); }
+    bool equals(const String &s) const { return _buffer == s._buffer; }
+    bool equals(const char *cstr) const { return cstr != nullptr && _buffer == cstr; }
+    bool equalsIgnoreCase(const String &s) const
+    {
+        if (_buffer.length() != s._buffer.length())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < _buffer.length(); ++i)
+        {
+            if (tolower((unsigned char)_buffer[i]) != tolower((unsigned char)s._buffer[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool operator==(const String &rhs) const { return equals(rhs); }
+    bool operator==(const char *cstr) const { return equals(cstr); }
+    bool operator!=(const String &rhs) const { return !equals(rhs); }
+    bool operator!=(const char *cstr) const { return !equals(cstr); }
+    bool operator<(const String &rhs) const { return compareTo(rhs) < 0; }
+    bool operator>(const String &rhs) const { return compareTo(rhs) > 0; }
+    bool startsWith(const String &prefix) const { return _buffer.compare(0, prefix._buffer.length(), prefix._buffer) == 0; }
+    bool startsWith(const String &prefix, unsigned int offset) const
+    {
+        return offset <= _buffer.length() && _buffer.compare(offset, prefix._buffer.length(), prefix._buffer) == 0;
+    }
+    bool endsWith(const String &suffix) const
+    {
+        return _buffer.length() >= suffix._buffer.length() &&
+               _buffer.compare(_buffer.length() - suffix._buffer.length(), suffix._buffer.length(), suffix._buffer) == 0;
+    }
+
+    // Character access
+    char charAt(unsigned int index) const { return index < _buffer.length() ? _buffer[index] : 0; }
+    void setCharAt(unsigned int index, char c)
+    {
+        if (index < _buffer.length())
+        {
+            _buffer[index] = c;
+        }
+    }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index) { return _buffer[index]; }
+
+    // Search
+    int indexOf(char ch, unsigned int fromIndex = 0) const
+    {
+        size_t pos = _buffer.find(ch, fromIndex);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    int indexOf(const String &str, unsigned int fromIndex = 0) const
+    {
+        size_t pos = _buffer.find(str._buffer, fromIndex);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    int lastIndexOf(char ch) const
+    {
+        size_t pos = _buffer.rfind(ch);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    String substring(unsigned int beginIndex) const
+    {
+        return beginIndex < _buffer.length() ? String(_buffer.substr(beginIndex)) : String();
+    }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const
+    {
+        if (beginIndex > endIndex)
+        {
+            unsigned int tmp = beginIndex;
+            beginIndex = endIndex;
+            endIndex = tmp;
+        }
+        if (beginIndex >= _buffer.length())
+        {
+            return String();
+        }
+        return String(_buffer.substr(beginIndex, endIndex - beginIndex));
+    }
+
+    // Modification
+    void replace(const String &find, const String &replace)
+    {
+        if (find._buffer.empty())
+        {
+            return;
+        }
+        size_t pos = 0;
+        while ((pos = _buffer.find(find._buffer, pos)) != std::string::npos)
+        {
+            _buffer.replace(pos, find._buffer.length(), replace._buffer);
+            pos += replace._buffer.length();
+        }
+    }
+    void remove(unsigned int index) { remove(index, (unsigned int)-1); }
+    void remove(unsigned int index, unsigned int count)
+    {
+        if (index < _buffer.length())
+        {
+            _buffer.erase(index, count);
+        }
+    }
+    void toLowerCase()
+    {
+        for (auto &c : _buffer)
+        {
+            c = (char)tolower((unsigned char)c);
+        }
+    }
+    void toUpperCase()
+    {
+        for (auto &c : _buffer)
+        {
+            c = (char)toupper((unsigned char)c);
+        }
+    }
+    void trim()
+    {
+        size_t first = 0;
+        while (first < _buffer.length() && isspace((unsigned char)_buffer[first]))
+        {
+            ++first;
+        }
+        size_t last = _buffer.length();
+        while (last > first && isspace((unsigned char)_buffer[last - 1]))
+        {
+            --last;
+        }
+        _buffer = _buffer.substr(first, last - first);
+    }
+
+    // Parsing
+    long toInt() const { return atol(_buffer.c_str()); }
+    float toFloat() const { return (float)atof(_buffer.c_str()); }
+    double toDouble() const { return atof(_buffer.c_str()); }
+
+    friend std::ostream &operator<<(std::ostream &os, const String &str) { return os << str._buffer; }
+};
+
+/**
+ * @brief Result type of String concatenation, mirrors the Arduino core so
+ * that libraries specialising on it (ArduinoJson 5) keep compiling.
+ */
+class StringSumHelper : public String
+{
+public:
+    StringSumHelper(const String &s) : String(s) {}
+    StringSumHelper(const char *p) : String(p) {}
+};
+
+inline StringSumHelper operator+(const StringSumHelper &lhs, const String &rhs)
+{
+    StringSumHelper result(lhs);
+    result.concat(rhs);
+    return result;
+}
+inline StringSumHelper operator+(const StringSumHelper &lhs, const char *cstr)
+{
+    StringSumHelper result(lhs);
+    result.concat(cstr);
+    return result;
+}
+inline StringSumHelper operator+(const String &lhs, const String &rhs)
+{
+    StringSumHelper result(lhs);
+    result.concat(rhs);
+    return result;
+}
+inline StringSumHelper operator+(const String &lhs, const char *cstr)
+{
+    StringSumHelper result(lhs);
+    result.concat(cstr);
+    return result;
+}
+inline StringSumHelper operator+(const char *cstr, const String &rhs)
+{
+    StringSumHelper result(cstr);
+    result.concat(rhs);
+    return result;
+}
+template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+inline StringSumHelper operator+(const String &lhs, T value)
+{
+    StringSumHelper result(lhs);
+    result.concat(value);
+    return result;
+}
+
+#endif /* NATIVE_SHIM_WSTRING_H */
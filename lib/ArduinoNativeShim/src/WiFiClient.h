@@ -0,0 +1,189 @@
+#ifndef NATIVE_SHIM_WIFICLIENT_H
+#define NATIVE_SHIM_WIFICLIENT_H
+
+/**
+ * @file WiFiClient.h
+ * @brief Host replacement for WiFiClient on top of a POSIX TCP socket
+ *
+ * Lets network clients such as the MQTT bridge talk to a real broker on the
+ * host (mosquitto or test/test_mqtt.py). connect() waits at most the Stream
+ * timeout, like the ESP8266 core; reads never block.
+ */
+
+#include <Arduino.h>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "Client.h"
+#include "IPAddress.h"
+
+class WiFiClient : public Client
+{
+private:
+    int _fd = -1;
+    bool _peerClosed = false;
+    std::vector<uint8_t> _rx;
+    size_t _rxPos = 0;
+
+    int connectAddress(const sockaddr_in &address)
+    {
+        stop();
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return 0;
+        }
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        if (::connect(fd, (const sockaddr *)&address, sizeof(address)) < 0 && errno != EINPROGRESS)
+        {
+            ::close(fd);
+            return 0;
+        }
+        pollfd pfd = {fd, POLLOUT, 0};
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (::poll(&pfd, 1, (int)_timeout) != 1 ||
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0)
+        {
+            ::close(fd);
+            return 0;
+        }
+        fcntl(fd, F_SETFL, flags); // writes block, reads use MSG_DONTWAIT
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        _fd = fd;
+        _peerClosed = false;
+        return 1;
+    }
+
+    // Move whatever the socket has into the receive buffer
+    void fill()
+    {
+        if (_fd < 0 || _peerClosed)
+        {
+            return;
+        }
+        if (_rxPos == _rx.size())
+        {
+            _rx.clear();
+            _rxPos = 0;
+        }
+        uint8_t buffer[512];
+        ssize_t n = ::recv(_fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0)
+        {
+            _rx.insert(_rx.end(), buffer, buffer + n);
+        }
+        else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        {
+            _peerClosed = true;
+        }
+    }
+
+public:
+    WiFiClient() {}
+    WiFiClient(const WiFiClient &) = delete;
+    WiFiClient &operator=(const WiFiClient &) = delete;
+    ~WiFiClient() { stop(); }
+
+    int connect(IPAddress ip, uint16_t port) override
+    {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = (uint32_t)ip;
+        return connectAddress(address);
+    }
+
+    int connect(const char *host, uint16_t port) override
+    {
+        addrinfo hints = {};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo *result = nullptr;
+        if (getaddrinfo(host, nullptr, &hints, &result) != 0 || result == nullptr)
+        {
+            return 0;
+        }
+        sockaddr_in address = *(const sockaddr_in *)result->ai_addr;
+        freeaddrinfo(result);
+        address.sin_port = htons(port);
+        return connectAddress(address);
+    }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        if (_fd < 0)
+        {
+            return 0;
+        }
+        size_t sent = 0;
+        while (sent < size)
+        {
+            ssize_t n = ::send(_fd, buf + sent, size - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                _peerClosed = true;
+                break;
+            }
+            sent += (size_t)n;
+        }
+        return sent;
+    }
+    using Print::write;
+
+    int available() override
+    {
+        fill();
+        return (int)(_rx.size() - _rxPos);
+    }
+    int read() override
+    {
+        return available() > 0 ? _rx[_rxPos++] : -1;
+    }
+    int read(uint8_t *buf, size_t size) override
+    {
+        size_t n = std::min(size, (size_t)available());
+        memcpy(buf, _rx.data() + _rxPos, n);
+        _rxPos += n;
+        return (int)n;
+    }
+    int peek() override
+    {
+        return available() > 0 ? _rx[_rxPos] : -1;
+    }
+    void flush() override {}
+
+    void stop() override
+    {
+        if (_fd >= 0)
+        {
+            ::close(_fd);
+        }
+        _fd = -1;
+        _peerClosed = false;
+        _rx.clear();
+        _rxPos = 0;
+    }
+
+    uint8_t connected() override
+    {
+        if (_fd < 0)
+        {
+            return 0;
+        }
+        fill();
+        return !_peerClosed || _rxPos < _rx.size();
+    }
+    operator bool() override { return _fd >= 0; }
+};
+
+#endif /* NATIVE_SHIM_WIFICLIENT_H */
@@ -0,0 +1,102 @@
+#ifndef NATIVE_SHIM_WIFIUDP_H
+#define NATIVE_SHIM_WIFIUDP_H
+
+/**
+ * @file WiFiUdp.h
+ * @brief Host replacement for WiFiUDP backed by in-memory packet queues
+ *
+ * Tests and benchmarks push datagrams with injectPacket() and inspect what
+ * the firmware answered through sentPackets().
+ */
+
+#include <Arduino.h>
+#include <deque>
+#include "IPAddress.h"
+
+class WiFiUDP : public Stream
+{
+public:
+    struct Datagram
+    {
+        IPAddress ip;
+        uint16_t port;
+        String payload;
+    };
+
+private:
+    uint16_t _localPort = 0;
+    std::deque<Datagram> _inbound;
+    std::vector<Datagram> _outbound;
+    Datagram _current;
+    size_t _readPos = 0;
+    Datagram _pending;
+
+public:
+    uint8_t begin(uint16_t port)
+    {
+        _localPort = port;
+        return 1;
+    }
+    void stop() { _localPort = 0; }
+
+    int parsePacket()
+    {
+        if (_inbound.empty())
+        {
+            return 0;
+        }
+        _current = _inbound.front();
+        _inbound.pop_front();
+        _readPos = 0;
+        return (int)_current.payload.length();
+    }
+    int available() override { return (int)(_current.payload.length() - _readPos); }
+    int read() override
+    {
+        return _readPos < _current.payload.length() ? (uint8_t)_current.payload[_readPos++] : -1;
+    }
+    int read(char *buffer, size_t len)
+    {
+        size_t n = std::min(len, _current.payload.length() - _readPos);
+        memcpy(buffer, _current.payload.c_str() + _readPos, n);
+        _readPos += n;
+        return (int)n;
+    }
+    int read(unsigned char *buffer, size_t len) { return read((char *)buffer, len); }
+    IPAddress remoteIP() const { return _current.ip; }
+    uint16_t remotePort() const { return _current.port; }
+
+    int beginPacket(IPAddress ip, uint16_t port)
+    {
+        _pending.ip = ip;
+        _pending.port = port;
+        _pending.payload = String();
+        return 1;
+    }
+    size_t write(uint8_t c) override
+    {
+        _pending.payload += (char)c;
+        return 1;
+    }
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+        _pending.payload.concat((const char *)buffer, (unsigned int)size);
+        return size;
+    }
+    using Print::write;
+    int endPacket()
+    {
+        _outbound.push_back(_pending);
+        return 1;
+    }
+
+    // ==================== Host-only helpers ====================
+
+    void injectPacket(const String &payload, IPAddress ip = IPAddress(127, 0, 0, 1), uint16_t port = 40000)
+    {
+        _inbound.push_back(Datagram{ip, port, payload});
+    }
+    std::vector<Datagram> &sentPackets() { return _outbound; }
+};
+
+#endif /* NATIVE_SHIM_WIFIUDP_H */
@@ -0,0 +1,27 @@
+#ifndef NATIVE_SHIM_LWIP_DNS_H
+#define NATIVE_SHIM_LWIP_DNS_H
+
+#include "lwip/err.h"
+
+/**
+ * @file dns.h
+ * @brief lwIP's asynchronous resolver API on top of the host resolver
+ *
+ * dns_gethostbyname() answers from the host resolver right away: ERR_OK with
+ * @p addr set, or ERR_ARG if the name does not resolve. The callback is only
+ * used by lwIP on the board, for names not in its cache.
+ */
+
+typedef struct ip4_addr
+{
+    uint32_t addr;
+} ip_addr_t;
+
+#define ip_2_ip4(ipaddr) (ipaddr)
+#define ip4_addr_get_u32(ipaddr) ((ipaddr)->addr)
+
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg);
+
+#endif /* NATIVE_SHIM_LWIP_DNS_H */
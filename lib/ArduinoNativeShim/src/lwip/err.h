@@ -0,0 +1,23 @@
+#ifndef NATIVE_SHIM_LWIP_ERR_H
+#define NATIVE_SHIM_LWIP_ERR_H
+
+#include <stdint.h>
+
+/**
+ * @file err.h
+ * @brief lwIP error codes, as passed to ESPAsyncTCP and DNS callbacks
+ */
+
+typedef int8_t err_t;
+
+#define ERR_OK 0
+#define ERR_MEM -1
+#define ERR_TIMEOUT -3
+#define ERR_INPROGRESS -5
+#define ERR_VAL -6
+#define ERR_CONN -11
+#define ERR_ABRT -13
+#define ERR_RST -14
+#define ERR_ARG -16
+
+#endif /* NATIVE_SHIM_LWIP_ERR_H */
@@ -0,0 +1,467 @@
+/**
+ * @file bench_handlers.cpp
+ * @brief Host micro-benchmark for every Alpaca HTTP endpoint
+ *
+ * Builds the same device set the example implementations provide on one
+ * in-process AsyncWebServer (lib/ArduinoNativeShim), then routes a synthetic
+ * request for every registered endpoint through AsyncWebServer::handle().
+ * For each endpoint it reports:
+ * - latency (mean/min/max, microseconds, steady clock)
+ * - bytes allocated and number of allocations per request
+ * - peak live heap reached while the request was handled
+ *
+ * The global operator new/delete are replaced here to do the accounting, so
+ * every String, JSON buffer and response allocation is counted.
+ *
+ * Build and run (CSV on stdout):
+ * @code
+ * pio run -e native_bench
+ * .pio/build/native_bench/program [iterations] [filter]
+ * @endcode
+ *
+ * `filter` restricts the run to endpoints whose path contains the given text,
+ * e.g. `focuser/0` or `/position`.
+ */
+
+#define DEBUGLOG_DEFAULT_LOG_LEVEL_WARN
+#include "Log_Filter.h"
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "alpaca_api/Alpaca_Management.h"
+#include "WiFi_Config.h"
+#include "implementation/ArduinoFocuser.h"
+#include "implementation/MyCoverCalibrator.h"
+#include "implementation/MyDome.h"
+#include "implementation/MyFilterWheel.h"
+#include "implementation/MyFocuser.h"
+#include "implementation/MyObservingConditions.h"
+#include "implementation/MyRotator.h"
+#include "implementation/MySafetyMonitor.h"
+#include "implementation/MySwitch.h"
+
+// ==================== Heap accounting ====================
+
+namespace
+{
+  struct HeapStats
+  {
+    size_t allocatedBytes = 0; // cumulative
+    size_t allocations = 0;    // cumulative
+    size_t liveBytes = 0;
+    size_t peakLiveBytes = 0;
+  };
+
+  HeapStats heapStats;
+
+  // Every block carries its size in front so delete can account for it
+  struct alignas(std::max_align_t) BlockHeader
+  {
+    size_t size;
+  };
+
+  void *countedAlloc(size_t size)
+  {
+    BlockHeader *header = static_cast<BlockHeader *>(malloc(sizeof(BlockHeader) + size));
+    if (header == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    header->size = size;
+    heapStats.allocatedBytes += size;
+    heapStats.allocations++;
+    heapStats.liveBytes += size;
+    if (heapStats.liveBytes > heapStats.peakLiveBytes)
+    {
+      heapStats.peakLiveBytes = heapStats.liveBytes;
+    }
+    return header + 1;
+  }
+
+  void countedFree(void *ptr)
+  {
+    if (ptr == nullptr)
+    {
+      return;
+    }
+    BlockHeader *header = static_cast<BlockHeader *>(ptr) - 1;
+    heapStats.liveBytes -= header->size;
+    free(header);
+  }
+}
+
+void *operator new(size_t size) { return countedAlloc(size); }
+void *operator new[](size_t size) { return countedAlloc(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return countedAlloc(size);
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+void operator delete(void *ptr) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr) noexcept { countedFree(ptr); }
+void operator delete(void *ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { countedFree(ptr); }
+
+// ==================== Firmware globals ====================
+
+WiFiConfig wifiConfig; // referenced by ArduinoFocuser
+PersistentStore persistentStore;
+TaskScheduler taskScheduler;
+MqttBridge mqttBridge;
+DeferredLog deferredLog;
+Metrics metrics;
+LoopProfiler loopProfiler;
+
+// ==================== Endpoint table ====================
+
+struct BenchEndpoint
+{
+  WebRequestMethod method;
+  String path;
+  String args; // query string for GET, form body for PUT
+};
+
+struct DeviceEndpoint
+{
+  WebRequestMethod method;
+  const char *name;
+  const char *args;
+};
+
+static const DeviceEndpoint commonEndpoints[] = {
+    {HTTP_PUT, "disconnect", ""},
+    {HTTP_PUT, "connect", ""},
+    {HTTP_PUT, "connected", "Connected=true"},
+    {HTTP_GET, "connected", ""},
+    {HTTP_GET, "connecting", ""},
+    {HTTP_GET, "description", ""},
+    {HTTP_GET, "devicestate", ""},
+    {HTTP_GET, "driverinfo", ""},
+    {HTTP_GET, "driverversion", ""},
+    {HTTP_GET, "interfaceversion", ""},
+    {HTTP_GET, "name", ""},
+    {HTTP_GET, "supportedactions", ""},
+    {HTTP_PUT, "action", "Action=status&Parameters="},
+    {HTTP_PUT, "commandblind", "Command=X&Raw=false"},
+    {HTTP_PUT, "commandbool", "Command=X&Raw=false"},
+    {HTTP_PUT, "commandstring", "Command=X&Raw=false"},
+};
+
+static const DeviceEndpoint coverCalibratorEndpoints[] = {
+    {HTTP_GET, "brightness", ""},
+    {HTTP_GET, "calibratorchanging", ""},
+    {HTTP_GET, "calibratorstate", ""},
+    {HTTP_GET, "covermoving", ""},
+    {HTTP_GET, "coverstate", ""},
+    {HTTP_GET, "maxbrightness", ""},
+    {HTTP_PUT, "calibratoron", "Brightness=100"},
+    {HTTP_PUT, "calibratoroff", ""},
+    {HTTP_PUT, "opencover", ""},
+    {HTTP_PUT, "haltcover", ""},
+    {HTTP_PUT, "closecover", ""},
+};
+
+static const DeviceEndpoint domeEndpoints[] = {
+    {HTTP_GET, "altitude", ""},
+    {HTTP_GET, "athome", ""},
+    {HTTP_GET, "atpark", ""},
+    {HTTP_GET, "azimuth", ""},
+    {HTTP_GET, "canfindhome", ""},
+    {HTTP_GET, "canpark", ""},
+    {HTTP_GET, "cansetaltitude", ""},
+    {HTTP_GET, "cansetazimuth", ""},
+    {HTTP_GET, "cansetpark", ""},
+    {HTTP_GET, "cansetshutter", ""},
+    {HTTP_GET, "canslave", ""},
+    {HTTP_GET, "cansyncazimuth", ""},
+    {HTTP_GET, "shutterstatus", ""},
+    {HTTP_GET, "slaved", ""},
+    {HTTP_GET, "slewing", ""},
+    {HTTP_PUT, "slaved", "Slaved=false"},
+    {HTTP_PUT, "abortslew", ""},
+    {HTTP_PUT, "openshutter", ""},
+    {HTTP_PUT, "closeshutter", ""},
+    {HTTP_PUT, "findhome", ""},
+    {HTTP_PUT, "park", ""},
+    {HTTP_PUT, "setpark", ""},
+    {HTTP_PUT, "slewtoaltitude", "Altitude=45.0"},
+    {HTTP_PUT, "slewtoazimuth", "Azimuth=180.0"},
+    {HTTP_PUT, "synctoazimuth", "Azimuth=180.0"},
+};
+
+static const DeviceEndpoint filterWheelEndpoints[] = {
+    {HTTP_GET, "focusoffsets", ""},
+    {HTTP_GET, "names", ""},
+    {HTTP_GET, "position", ""},
+    {HTTP_PUT, "position", "Position=2"},
+};
+
+static const DeviceEndpoint focuserEndpoints[] = {
+    {HTTP_GET, "absolute", ""},
+    {HTTP_GET, "ismoving", ""},
+    {HTTP_GET, "maxincrement", ""},
+    {HTTP_GET, "maxstep", ""},
+    {HTTP_GET, "position", ""},
+    {HTTP_GET, "stepsize", ""},
+    {HTTP_GET, "tempcomp", ""},
+    {HTTP_GET, "tempcompavailable", ""},
+    {HTTP_GET, "temperature", ""},
+    {HTTP_PUT, "tempcomp", "TempComp=false"},
+    {HTTP_PUT, "move", "Position=500"},
+    {HTTP_PUT, "halt", ""},
+};
+
+static const DeviceEndpoint observingConditionsEndpoints[] = {
+    {HTTP_GET, "averageperiod", ""},
+    {HTTP_GET, "cloudcover", ""},
+    {HTTP_GET, "dewpoint", ""},
+    {HTTP_GET, "humidity", ""},
+    {HTTP_GET, "pressure", ""},
+    {HTTP_GET, "rainrate", ""},
+    {HTTP_GET, "skybrightness", ""},
+    {HTTP_GET, "skyquality", ""},
+    {HTTP_GET, "skytemperature", ""},
+    {HTTP_GET, "starfwhm", ""},
+    {HTTP_GET, "temperature", ""},
+    {HTTP_GET, "winddirection", ""},
+    {HTTP_GET, "windgust", ""},
+    {HTTP_GET, "windspeed", ""},
+    {HTTP_GET, "sensordescription", "SensorName=Temperature"},
+    {HTTP_GET, "timesincelastupdate", "SensorName=Temperature"},
+    {HTTP_PUT, "averageperiod", "AveragePeriod=0.0"},
+    {HTTP_PUT, "refresh", ""},
+};
+
+static const DeviceEndpoint rotatorEndpoints[] = {
+    {HTTP_GET, "canreverse", ""},
+    {HTTP_GET, "ismoving", ""},
+    {HTTP_GET, "mechanicalposition", ""},
+    {HTTP_GET, "position", ""},
+    {HTTP_GET, "reverse", ""},
+    {HTTP_GET, "stepsize", ""},
+    {HTTP_GET, "targetposition", ""},
+    {HTTP_PUT, "reverse", "Reverse=false"},
+    {HTTP_PUT, "move", "Position=10.0"},
+    {HTTP_PUT, "moveabsolute", "Position=90.0"},
+    {HTTP_PUT, "movemechanical", "Position=90.0"},
+    {HTTP_PUT, "sync", "Position=90.0"},
+    {HTTP_PUT, "halt", ""},
+};
+
+static const DeviceEndpoint safetyMonitorEndpoints[] = {
+    {HTTP_GET, "issafe", ""},
+};
+
+static const DeviceEndpoint switchEndpoints[] = {
+    {HTTP_GET, "maxswitch", ""},
+    {HTTP_GET, "canasync", "Id=0"},
+    {HTTP_GET, "canwrite", "Id=0"},
+    {HTTP_GET, "getswitch", "Id=0"},
+    {HTTP_GET, "getswitchdescription", "Id=0"},
+    {HTTP_GET, "getswitchname", "Id=0"},
+    {HTTP_GET, "getswitchvalue", "Id=0"},
+    {HTTP_GET, "minswitchvalue", "Id=0"},
+    {HTTP_GET, "maxswitchvalue", "Id=0"},
+    {HTTP_GET, "statechangecomplete", "Id=0"},
+    {HTTP_GET, "switchstep", "Id=0"},
+    {HTTP_PUT, "setswitch", "Id=0&State=true"},
+    {HTTP_PUT, "setswitchname", "Id=0&Name=Heater"},
+    {HTTP_PUT, "setswitchvalue", "Id=0&Value=1"},
+    {HTTP_PUT, "setasync", "Id=0&State=false"},
+    {HTTP_PUT, "setasyncvalue", "Id=0&Value=0"},
+};
+
+template <size_t N>
+static void addDeviceEndpoints(std::vector<BenchEndpoint> &endpoints, AplacaDevice *device,
+                               const DeviceEndpoint (&specific)[N])
+{
+  String base = String("/api/v1/") + device->GetDeviceType() + "/" + String(device->GetDeviceNumber()) + "/";
+  for (const DeviceEndpoint &endpoint : commonEndpoints)
+  {
+    endpoints.push_back({endpoint.method, base + endpoint.name, endpoint.args});
+  }
+  for (const DeviceEndpoint &endpoint : specific)
+  {
+    endpoints.push_back({endpoint.method, base + endpoint.name, endpoint.args});
+  }
+  if (device->hasSetupHandler())
+  {
+    String setup = String("/setup/v1/") + device->GetDeviceType() + "/" + String(device->GetDeviceNumber()) + "/setup";
+    endpoints.push_back({HTTP_GET, setup, ""});
+    endpoints.push_back({HTTP_GET, setup + "/config", ""});
+  }
+}
+
+// ==================== Measurement ====================
+
+struct BenchResult
+{
+  int code = 0;
+  unsigned long iterations = 0;
+  double meanMicros = 0;
+  double minMicros = 0;
+  double maxMicros = 0;
+  size_t bytesPerRequest = 0;
+  size_t allocationsPerRequest = 0;
+  size_t peakHeapBytes = 0;
+  size_t responseBytes = 0;
+};
+
+static BenchResult runEndpoint(AsyncWebServer &server, const BenchEndpoint &endpoint, unsigned long iterations)
+{
+  typedef std::chrono::steady_clock Clock;
+  BenchResult result;
+  result.iterations = iterations;
+  result.minMicros = 1e12;
+  size_t totalBytes = 0;
+  size_t totalAllocations = 0;
+  double totalMicros = 0;
+
+  for (unsigned long i = 0; i < iterations; i++)
+  {
+    String ids = String("ClientID=1&ClientTransactionID=") + String(i + 1);
+    String args = endpoint.args.length() > 0 ? endpoint.args + "&" + ids : ids;
+    bool isGet = endpoint.method == HTTP_GET;
+    // Request parsing is the web server's job, so it happens outside the window
+    AsyncWebServerRequest request(endpoint.method, isGet ? endpoint.path + "?" + args : endpoint.path,
+                                  isGet ? String() : args);
+
+    size_t bytesBefore = heapStats.allocatedBytes;
+    size_t allocationsBefore = heapStats.allocations;
+    size_t liveBefore = heapStats.liveBytes;
+    heapStats.peakLiveBytes = liveBefore;
+
+    Clock::time_point start = Clock::now();
+    server.handle(&request);
+    double micros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    totalMicros += micros;
+    result.minMicros = std::min(result.minMicros, micros);
+    result.maxMicros = std::max(result.maxMicros, micros);
+    totalBytes += heapStats.allocatedBytes - bytesBefore;
+    totalAllocations += heapStats.allocations - allocationsBefore;
+    result.peakHeapBytes = std::max(result.peakHeapBytes, heapStats.peakLiveBytes - liveBefore);
+    result.code = request.responseCode();
+    result.responseBytes = request.responseBody().length();
+  }
+
+  if (iterations > 0)
+  {
+    result.meanMicros = totalMicros / iterations;
+    result.bytesPerRequest = totalBytes / iterations;
+    result.allocationsPerRequest = totalAllocations / iterations;
+  }
+  return result;
+}
+
+static void printResult(const BenchEndpoint &endpoint, const char *label, const BenchResult &result)
+{
+  printf("%s,%s%s,%d,%lu,%.2f,%.2f,%.2f,%lu,%lu,%lu,%lu\n",
+         endpoint.method == HTTP_GET ? "GET" : "PUT", endpoint.path.c_str(), label, result.code,
+         result.iterations, result.meanMicros, result.minMicros, result.maxMicros,
+         (unsigned long)result.bytesPerRequest, (unsigned long)result.allocationsPerRequest,
+         (unsigned long)result.peakHeapBytes, (unsigned long)result.responseBytes);
+}
+
+// ==================== Entry point ====================
+
+int main(int argc, char **argv)
+{
+  unsigned long iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200;
+  String filter = argc > 2 ? String(argv[2]) : String();
+
+  persistentStore.begin();
+
+  AsyncWebServer server(80);
+  AlpacaManagement management;
+  management.registerManagementHandlers(server);
+
+  ArduinoFocuser arduinoFocuser("Arduino Focuser", 0, "Bench focuser", server, 10000, 10);
+  MyFocuser focuser("My Focuser", 1, "Bench focuser", server);
+  MyCoverCalibrator coverCalibrator("My CoverCalibrator", 0, "Bench cover calibrator", server);
+  MyDome dome("My Dome", 0, "Bench dome", server);
+  MyFilterWheel filterWheel("My FilterWheel", 0, "Bench filter wheel", server);
+  MyObservingConditions observingConditions("My ObservingConditions", 0, "Bench observing conditions", server);
+  MyRotator rotator("My Rotator", 0, "Bench rotator", server);
+  MySafetyMonitor safetyMonitor("My SafetyMonitor", 0, "Bench safety monitor", server);
+  MySwitch switches("My Switch", 0, "Bench switch", server, 4);
+
+  AplacaDevice *devices[] = {&arduinoFocuser, &focuser, &coverCalibrator, &dome, &filterWheel,
+                             &observingConditions, &rotator, &safetyMonitor, &switches};
+  for (AplacaDevice *device : devices)
+  {
+    management.registerDevice(server, device->GetDeviceName(), device->GetDeviceType(), device->GetDeviceNumber(), device);
+  }
+  server.begin();
+
+  // Handler cost is measured without rate limiting; the throttled paths are measured below
+  AlpacaAdmission &admission = AlpacaRouter::forServer(server).admission();
+  admission.configure(0, ALPACA_ADMISSION_BURST, 0);
+
+  std::vector<BenchEndpoint> endpoints;
+  endpoints.push_back({HTTP_GET, "/management/apiversions", ""});
+  endpoints.push_back({HTTP_GET, "/management/v1/configureddevices", ""});
+  endpoints.push_back({HTTP_GET, "/management/v1/description", ""});
+  endpoints.push_back({HTTP_GET, "/metrics", ""});
+  addDeviceEndpoints(endpoints, &arduinoFocuser, focuserEndpoints);
+  addDeviceEndpoints(endpoints, &focuser, focuserEndpoints);
+  addDeviceEndpoints(endpoints, &coverCalibrator, coverCalibratorEndpoints);
+  addDeviceEndpoints(endpoints, &dome, domeEndpoints);
+  addDeviceEndpoints(endpoints, &filterWheel, filterWheelEndpoints);
+  addDeviceEndpoints(endpoints, &observingConditions, observingConditionsEndpoints);
+  addDeviceEndpoints(endpoints, &rotator, rotatorEndpoints);
+  addDeviceEndpoints(endpoints, &safetyMonitor, safetyMonitorEndpoints);
+  addDeviceEndpoints(endpoints, &switches, switchEndpoints);
+
+  printf("# %lu handlers registered, %lu iterations per endpoint\n",
+         (unsigned long)server.handlerCount(), iterations);
+  printf("method,path,code,iterations,mean_us,min_us,max_us,bytes_per_req,allocs_per_req,peak_heap_bytes,response_bytes\n");
+
+  size_t benchmarked = 0;
+  for (const BenchEndpoint &endpoint : endpoints)
+  {
+    if (filter.length() > 0 && endpoint.path.indexOf(filter) < 0)
+    {
+      continue;
+    }
+    BenchResult result = runEndpoint(server, endpoint, iterations);
+    printResult(endpoint, "", result);
+    benchmarked++;
+  }
+
+  // A client over its budget: DeviceState reads come from the snapshot,
+  // other reads get 429, control verbs still run
+  admission.configure(1, 1, 0);
+  const BenchEndpoint throttled[] = {
+      {HTTP_GET, "/api/v1/focuser/0/position", ""},
+      {HTTP_GET, "/api/v1/focuser/0/maxstep", ""},
+      {HTTP_PUT, "/api/v1/focuser/0/halt", ""},
+  };
+  for (const BenchEndpoint &endpoint : throttled)
+  {
+    if (filter.length() > 0 && endpoint.path.indexOf(filter) < 0)
+    {
+      continue;
+    }
+    printResult(endpoint, " (throttled)", runEndpoint(server, endpoint, iterations));
+    benchmarked++;
+  }
+
+  printf("# %lu endpoints benchmarked\n", (unsigned long)benchmarked);
+  return 0;
+}
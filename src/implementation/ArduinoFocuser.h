@@ -5,14 +5,31 @@
 
 #include "alpaca_api/Alpaca_Device_Focuser.h"
 #include "ArduinoStepper.h"
-#include <OneWire.h>
-#include <DallasTemperature.h>
-#include <EEPROM.h>
+#include "Persistent_Store.h"
+#include <ESP8266WiFi.h>
 #include "WiFi_Config.h"
+#include "Mqtt_Bridge.h"
+#include "Deferred_Log.h"
+#include "Task_Scheduler.h"
+#include "ArduinoFocuser_Setup_Page.h"
+#include "ArduinoFocuser_TempComp.h"
+#include "ArduinoFocuser_TempFilter.h"
+#include "ArduinoFocuser_TempBus.h"
 
 // Forward declaration for accessing global WiFiConfig
 extern WiFiConfig wifiConfig;
 
+#define MAX_BACKLASH_STEPS 1000
+
+/**
+ * @brief How ArduinoFocuser takes up gear backlash
+ */
+enum eBACKLASHMODE {
+  BacklashOff = 0,
+  BacklashOvershoot = 1, // moves against the approach direction go past the target and come back
+  BacklashOffset = 2     // after a reversal the motor turns the backlash extra before the position counts
+};
+
 
 /**
  * @file ArduinoFocuser.h
@@ -27,10 +44,7 @@ private:
 
   ArduinoStepper* stepper; // Stepper motor control object
   // Focuser configuration
-  //OneWire oneWire = OneWire(4); // OneWire bus for temperature sensor
-  //DallasTemperature sensors =DallasTemperature(&oneWire);
-    OneWire oneWire; // OneWire bus for temperature sensor
-  DallasTemperature sensors; // DallasTemperature object for reading temperature
+  TemperatureBus temperatureBus; // DS18B20 probes, the tube probe drives temperature
   double TEMPOFFSET = 0.0; // Temperature offset for compensation (adjustable) 
 
   bool absolute;                    // Supports absolute positioning
@@ -48,142 +62,168 @@ private:
   bool tempComp;                    // Temperature compensation enabled
   double temperature;               // Current temperature in Celsius
   double lastRawTemperature;        // Last raw sensor temperature
+  TemperatureFilter temperatureFilter; // smooths raw readings into temperature
   bool temperatureSensorValid;      // Last sensor validity state
   int TEMP_PIN = 4;              // GPIO pin for temperature sensor (DS18B20)
+  uint8_t TEMP_RESOLUTION = 10;  // DS18B20 resolution in bits (9..12, 94..750 ms conversion)
+
+  // Non-blocking temperature conversion
+  enum TemperatureState { TEMP_IDLE, TEMP_CONVERTING };
+  TemperatureState temperatureState = TEMP_IDLE;
+  unsigned long lastTempUpdate = 0;     // Start of the last conversion
+  unsigned long lastTempPoll = 0;       // Last conversion-complete poll
+  static const unsigned long TEMP_UPDATE_INTERVAL_MS = 2000;
+  static const unsigned long TEMP_POLL_INTERVAL_MS = 10;
+
+  // Backlash compensation, applied by Move()
+  eBACKLASHMODE backlashMode = BacklashOff;
+  int backlashSteps = 0;
+  int backlashApproach = 1;   // direction every move ends with in overshoot mode: +1 outward, -1 inward
+  int lastMoveDirection = 0;  // of the last move, 0 = unknown since boot
+
+  // Learned temperature compensation: a position the client moved to and
+  // kept for TEMPCOMP_FOCUS_HOLD_MS is taken as in focus at that temperature
+  FocuserTempComp tempCompModel;
+  bool clientMovePending = false;   // a client Move() has not completed yet
+  bool focusSamplePending = false;  // record the reference once held long enough
+  unsigned long referenceSince = 0; // completion of the last client move
   // Motor control pins (optional - for stepper motor control)
   //int stepPin;
   //int dirPin;
   //int enablePin;
 
-  DeviceAddress Probe = { 0x28, 0xCC, 0xA7, 0xB3, 0x00, 0x00, 0x00, 0x87 };
-  // Movement parameters
-  unsigned long lastStepTime;       // Time of last step
-  unsigned long stepDelayMicros;    // Delay between steps (microseconds)
-  
-  // EEPROM storage (ArduinoStepper uses addresses 0-7 for position and mode)
-  static const int EEPROM_TEMPOFFSET_ADDR = 8;  // EEPROM address for temperature offset (8 bytes, double)
-  static const int EEPROM_TEMP_PIN_ADDR = 154;  // EEPROM address for temperature sensor pin (1 byte)
-  static const int EEPROM_SIZE = 512;            // Total EEPROM size to allocate
-  
-  /**
-   * @brief Update focuser movement
-   * Called periodically to advance motor one step at a time
-   */
-  void updateMovement() {
-    if (stepper == nullptr || !stepper->isMoving() || stepper->getPosition() == stepper->getTarget()) {
-      if (stepper != nullptr) {
-        stepper->releaseDrive(); // Disable motor
-      }
-      return;
-    }
-    
-    unsigned long currentTime = micros();
-    if (currentTime - lastStepTime < stepDelayMicros) {
-      return; // Not time for next step yet
-    }
-    
-    lastStepTime = currentTime;
-    
-   
-    
-    // Check if movement is complete
-    if (stepper->getPosition() == stepper->getTarget()) {
-      stepper->releaseDrive(); // Disable motor
-      LOG_DEBUG("Focuser movement complete - Position: " + String(stepper->getPosition()));
-    }
-  }
-  
   /**
-   * @brief Simulate temperature reading
-   * In a real implementation, read from temperature sensor (e.g., DS18B20, DHT22)
+   * @brief Advance the DS18B20 conversion state machine
+   *
+   * Starts a conversion every TEMP_UPDATE_INTERVAL_MS without waiting for it
+   * (setWaitForConversion(false)), then polls for completion at most every
+   * TEMP_POLL_INTERVAL_MS and reads the result once it is ready, so each call
+   * costs microseconds instead of the 94..750 ms conversion time. All probes
+   * convert together; the tube probe's reading is filtered into temperature.
    */
   void updateTemperature() {
-    // Simulate temperature reading - replace with actual sensor code
-    // Example for DS18B20: temperature = sensors.getTempCByIndex(0);
-    // For now, just add a small random fluctuation
-    static unsigned long lastTempUpdate = 0;
     unsigned long currentTime = millis();
-    
-    if (currentTime - lastTempUpdate > 2000) { // Update every 5 seconds
-      lastTempUpdate = currentTime;
 
-      sensors.requestTemperatures();
-      double rawTemperature = sensors.getTempCByIndex(0);
-      lastRawTemperature = rawTemperature;
-
-      // DS18B20 invalid values: disconnected (-127), power-up default (85)
-      if (rawTemperature == DEVICE_DISCONNECTED_C ||
-          rawTemperature == 85.0 ||
-          isnan(rawTemperature) ||
-          isinf(rawTemperature) ||
-          rawTemperature < -55.0 ||
-          rawTemperature > 125.0) {
+    if (temperatureState == TEMP_IDLE) {
+      if (currentTime - lastTempUpdate < TEMP_UPDATE_INTERVAL_MS) {
+        return;
+      }
+      lastTempUpdate = currentTime;
+      lastTempPoll = currentTime;
+      if (!temperatureBus.request()) {
         temperatureSensorValid = false;
-        LOG_WARN("Invalid temperature sensor value: " + String(rawTemperature));
         return;
       }
+      temperatureState = TEMP_CONVERTING;
+      return;
+    }
+
+    // Poll the bus sparingly; give up waiting after the datasheet conversion time
+    bool timedOut = currentTime - lastTempUpdate >= temperatureBus.conversionMillis();
+    if (!timedOut) {
+      if (currentTime - lastTempPoll < TEMP_POLL_INTERVAL_MS) {
+        return;
+      }
+      lastTempPoll = currentTime;
+      if (!temperatureBus.conversionComplete()) {
+        return;
+      }
+    }
+    temperatureState = TEMP_IDLE;
 
-      temperatureSensorValid = true;
-      temperature = rawTemperature + TEMPOFFSET;
+    temperatureBus.read();
+    double rawTemperature = temperatureBus.raw(ProbeTube);
+    lastRawTemperature = rawTemperature;
+
+    if (!temperatureBus.valid(ProbeTube)) {
+      temperatureSensorValid = false;
+      LOG_WARN("Invalid temperature sensor value: " + String(rawTemperature));
+      return;
+    }
 
-     // LOG_DEBUG("1Wire Device connected: " + String(sensors.isConnected(0)));
-      //LOG_DEBUG("1Wire Device count: " + String(sensors.getDeviceCount()));
-      LOG_INFO("Temperature updated: " + String(temperature) + " °C");
+    temperatureSensorValid = true;
+    if (!temperatureFilter.add(rawTemperature, currentTime)) {
+      LOG_DEFERRED_WARN("Temperature outlier ignored: %.2f °C", rawTemperature);
+      return;
     }
+    temperature = temperatureFilter.value() + TEMPOFFSET;
+
+    LOG_DEFERRED_INFO("Temperature updated: %.2f °C (raw %.2f °C)", temperature, rawTemperature);
   }
   
   /**
-   * @brief Load temperature offset from EEPROM
+   * @brief Load temperature offset from the persistent store
    */
-  void loadTemperatureOffsetFromEEPROM() {
-    // Read the double value from EEPROM
-    double storedOffset = 0.0;
-    EEPROM.get(EEPROM_TEMPOFFSET_ADDR, storedOffset);
+  void loadTemperatureOffset() {
+    double storedOffset = NAN;
+    persistentStore.get(STORE_KEY_FOCUSER_TEMPOFFSET, storedOffset);
     
     // Validate the read value (check if it's a reasonable number)
-    // NaN or infinity would indicate uninitialized EEPROM
+    // NaN would indicate that nothing is stored yet
     if (isnan(storedOffset) || isinf(storedOffset) || storedOffset < -50.0 || storedOffset > 50.0) {
-      LOG_WARN("Invalid temperature offset in EEPROM, using default 0.0");
+      LOG_WARN("No valid stored temperature offset, using default 0.0");
       TEMPOFFSET = 0.0;
-      saveTemperatureOffsetToEEPROM(); // Initialize EEPROM with default
+      saveTemperatureOffset(); // Initialize with default
     } else {
       TEMPOFFSET = storedOffset;
-      LOG_INFO("Loaded temperature offset from EEPROM: " + String(TEMPOFFSET) + " °C");
+      LOG_INFO("Loaded temperature offset: " + String(TEMPOFFSET) + " °C");
     }
   }
   
   /**
-   * @brief Save temperature offset to EEPROM
+   * @brief Save temperature offset to the persistent store
    */
-  void saveTemperatureOffsetToEEPROM() {
-    EEPROM.put(EEPROM_TEMPOFFSET_ADDR, TEMPOFFSET);
-    EEPROM.commit(); // Commit changes to EEPROM (required for ESP8266)
-    LOG_INFO("Saved temperature offset to EEPROM: " + String(TEMPOFFSET) + " °C");
+  void saveTemperatureOffset() {
+    persistentStore.put(STORE_KEY_FOCUSER_TEMPOFFSET, TEMPOFFSET);
+    LOG_INFO("Saved temperature offset: " + String(TEMPOFFSET) + " °C");
   }
 
-  void loadTemperaturePinFromEEPROM() {
-    uint8_t storedPin = EEPROM.read(EEPROM_TEMP_PIN_ADDR);
+  void loadTemperaturePin() {
+    uint8_t storedPin = 0xFF;
+    persistentStore.get(STORE_KEY_FOCUSER_TEMP_PIN, storedPin);
     if (storedPin <= 16) {
       TEMP_PIN = storedPin;
-      LOG_INFO("Loaded temperature sensor pin from EEPROM: GPIO " + String(TEMP_PIN));
+      LOG_INFO("Loaded temperature sensor pin: GPIO " + String(TEMP_PIN));
     } else {
-      LOG_WARN("Invalid temperature sensor pin in EEPROM, using default GPIO " + String(TEMP_PIN));
-      saveTemperaturePinToEEPROM();
+      LOG_WARN("No valid stored temperature sensor pin, using default GPIO " + String(TEMP_PIN));
+      saveTemperaturePin();
+    }
+  }
+
+  void saveTemperaturePin() {
+    persistentStore.put(STORE_KEY_FOCUSER_TEMP_PIN, static_cast<uint8_t>(TEMP_PIN));
+    LOG_INFO("Saved temperature sensor pin: GPIO " + String(TEMP_PIN));
+  }
+
+  void loadTemperatureResolution() {
+    uint8_t storedResolution = 0;
+    persistentStore.get(STORE_KEY_FOCUSER_TEMP_RESOLUTION, storedResolution);
+    if (storedResolution >= 9 && storedResolution <= 12) {
+      TEMP_RESOLUTION = storedResolution;
     }
   }
 
-  void saveTemperaturePinToEEPROM() {
-    EEPROM.write(EEPROM_TEMP_PIN_ADDR, static_cast<uint8_t>(TEMP_PIN));
-    EEPROM.commit();
-    LOG_INFO("Saved temperature sensor pin to EEPROM: GPIO " + String(TEMP_PIN));
+  void loadBacklash() {
+    int32_t backlash[3];
+    if (persistentStore.get(STORE_KEY_FOCUSER_BACKLASH, backlash, sizeof(backlash)) &&
+        backlash[0] >= BacklashOff && backlash[0] <= BacklashOffset &&
+        backlash[1] >= 0 && backlash[1] <= MAX_BACKLASH_STEPS &&
+        (backlash[2] == 1 || backlash[2] == -1)) {
+      backlashMode = (eBACKLASHMODE)backlash[0];
+      backlashSteps = backlash[1];
+      backlashApproach = backlash[2];
+      LOG_INFO("Loaded backlash compensation: mode " + String(backlashMode) + ", " + String(backlashSteps) + " steps");
+    }
   }
 
   void initializeTemperatureSensor() {
     LOG_INFO("Initializing temperature sensor on GPIO " + String(TEMP_PIN));
-    oneWire = OneWire(TEMP_PIN);
-    sensors = DallasTemperature(&oneWire);
-    sensors.begin();
-    sensors.setResolution(Probe, 10);
+    temperatureBus.begin(TEMP_PIN, TEMP_RESOLUTION);
+    temperatureFilter.reset();
+    if (!temperatureBus.present(ProbeTube)) {
+      LOG_WARN("No DS18B20 found on GPIO " + String(TEMP_PIN));
+    }
+    temperatureState = TEMP_IDLE;
   }
 
 public:
@@ -211,20 +251,21 @@ public:
       tempComp(false),
       temperature(20.0),
       lastRawTemperature(DEVICE_DISCONNECTED_C),
-      temperatureSensorValid(false),
-      lastStepTime(0),
-      stepDelayMicros(2000) { // 2ms between steps = 500 steps/sec
+      temperatureSensorValid(false) {
     
-    // Initialize motor control (this also initializes EEPROM)
+    // Initialize motor control (this also loads the persistent store)
     LOG_INFO("Initializing ArduinoFocuser with maxStep: " + String(maxStep) + " stepSize: " + String(stepSize) + " microns");
     stepper = new ArduinoStepper();
     stepper->setStepMode(FullStep2Phase); // Set stepping mode (e.g., full step, half step)
     
-    // Load temperature offset from EEPROM (now that EEPROM is initialized by ArduinoStepper)
-    loadTemperatureOffsetFromEEPROM();
-
-    // Load and initialize temperature sensor pin
-    loadTemperaturePinFromEEPROM();
+    // Load temperature offset (the store was loaded by ArduinoStepper)
+    loadTemperatureOffset();
+    loadBacklash();
+    tempCompModel.begin();
+
+    // Load and initialize temperature sensor pin and resolution
+    loadTemperaturePin();
+    loadTemperatureResolution();
     initializeTemperatureSensor();
 
     LOG_DEBUG("ArduinoFocuser created - MaxStep: " + String(maxStep) + " StepSize: " + String(stepSize) + " microns");
@@ -311,6 +352,72 @@ public:
   double GetLastRawTemperature() const {
     return lastRawTemperature;
   }
+
+  /**
+   * @brief Last reading of the probe in @p role (eTEMPPROBE), DEVICE_DISCONNECTED_C if none
+   */
+  double GetProbeTemperature(int role) const {
+    return temperatureBus.valid(role) ? temperatureBus.raw(role) : DEVICE_DISCONNECTED_C;
+  }
+
+  /**
+   * @brief Put the DS18B20 with ROM @p rom (16 hex digits) in @p role, persisted
+   * @return false if the role or ROM is invalid
+   */
+  bool AssignTemperatureProbe(int role, const String &rom) {
+    if (!temperatureBus.assign(role, rom)) {
+      return false;
+    }
+    temperatureFilter.reset();
+    temperatureState = TEMP_IDLE;
+    LOG_INFO("DS18B20 " + rom + " is now the " + TemperatureBus::roleName(role) + " probe");
+    return true;
+  }
+
+  /**
+   * @brief Search the 1-Wire bus again before the next conversion, e.g. after adding a probe
+   */
+  void RescanTemperatureProbes() {
+    temperatureBus.rescan();
+  }
+
+  /**
+   * @brief Serve the temperature filter stages at /debug/{devicetype}/{devicenumber}/temperature
+   */
+  void enableTemperatureDiagnostics(AsyncWebServer &server) {
+    String url = String("/debug/") + GetDeviceType() + "/" + String(GetDeviceNumber()) + "/temperature";
+    server.on(url.c_str(), HTTP_GET, [this](AsyncWebServerRequest *request) { handleTemperatureDiagnostics(request); });
+  }
+
+  /**
+   * @brief Raw reading, each filter stage and the filter counters as one JSON object (°C)
+   */
+  void handleTemperatureDiagnostics(AsyncWebServerRequest *request) {
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->addHeader("Cache-Control", "no-store");
+    AlpacaJsonObjectWriter out(*response);
+    out.field("valid", temperatureSensorValid);
+    out.field("raw", lastRawTemperature);
+    out.field("median", (double)temperatureFilter.medianValue());
+    out.field("rate_limited", (double)temperatureFilter.limitedValue());
+    out.field("filtered", (double)temperatureFilter.value());
+    out.field("offset", TEMPOFFSET);
+    out.field("temperature", temperature);
+    out.field("readings", (unsigned long)temperatureFilter.readingCount());
+    out.field("outliers", (unsigned long)temperatureFilter.outlierCount());
+    out.field("rate_limited_readings", (unsigned long)temperatureFilter.rateLimitedCount());
+    out.field("probes", (int)temperatureBus.deviceCount());
+    out.field("bus_scans", (unsigned long)temperatureBus.scanCount());
+    for (uint8_t role = 0; role < TEMP_PROBE_COUNT; role++) {
+      String name = String(TemperatureBus::roleName(role));
+      out.field((name + "_rom").c_str(), temperatureBus.romString(role));
+      out.field((name + "_present").c_str(), temperatureBus.present(role));
+      out.field((name + "_valid").c_str(), temperatureBus.valid(role));
+      out.field((name + "_raw").c_str(), (double)temperatureBus.raw(role));
+    }
+    out.end();
+    request->send(response);
+  }
   
   /**
    * @brief Set temperature compensation state
@@ -320,8 +427,10 @@ public:
     this->tempComp = tempComp;
     LOG_DEBUG("Temperature compensation " + String(tempComp ? "enabled" : "disabled"));
     
-    // In a real implementation, apply temperature compensation logic here
-    // For example, adjust focus based on temperature changes
+    // Follow the temperature from here if no client move set a reference yet
+    if (tempComp && temperatureSensorValid && !stepper->isMoving() && !clientMovePending) {
+      tempCompModel.setReference(temperature, stepper->getPosition());
+    }
   }
   
   /**
@@ -330,6 +439,8 @@ public:
   void Halt() override {
     LOG_DEBUG("Halt command received - stopping at position: " + String(GetPosition()));
     stepper->halt();
+    // Where a halted move stops is neither in focus nor a position to follow
+    forgetFocus();
   }
   
   /**
@@ -351,50 +462,129 @@ public:
 
     }
     
-    LOG_INFO("Moving focuser from " + String(stepper->getPosition()) + " to " + String(position));
-    
-    stepper->setTarget(position);
-    
+    LOG_DEFERRED_INFO("Moving focuser from %d to %d", stepper->getPosition(), position);
+    clientMovePending = true;
+    focusSamplePending = false;
+    startMove(position);
+  }
+
+  /**
+   * @brief Drop the compensation reference and any pending focus sample
+   * Compensation resumes after the next client move, RecordFocus() or
+   * enabling TempComp again.
+   */
+  void forgetFocus() {
+    clientMovePending = false;
+    focusSamplePending = false;
+    tempCompModel.clearReference();
+  }
+
+  /**
+   * @brief Start a move to @p position with backlash compensation
+   */
+  void startMove(int position) {
+    int current = stepper->getPosition();
+    int direction = position > current ? 1 : (position < current ? -1 : 0);
+    if (backlashMode == BacklashOvershoot && direction != 0 && direction != backlashApproach) {
+      // Go past the target and come back, so the move ends in the approach direction
+      int overshoot = constrain(position - backlashApproach * backlashSteps, 0, maxStep);
+      stepper->setTarget(overshoot, position);
+    } else {
+      if (backlashMode == BacklashOffset && direction != 0 && lastMoveDirection != 0 && direction != lastMoveDirection) {
+        stepper->takeUpSlack(backlashSteps);
+      }
+      stepper->setTarget(position);
+    }
+    if (direction != 0) {
+      lastMoveDirection = direction;
+    }
   }
   
   // ==================== Additional Methods ====================
   
   /**
    * @brief Update focuser state
-   * Call this periodically from loop() to handle movement and temperature updates
+   * Call this periodically from loop() to handle movement and temperature
+   * updates, or use registerTasks() to let the task scheduler do it
    */
   void update() {
     stepper->Update();
-    updateMovement();
     updateTemperature();
-    
-    // If temperature compensation is enabled, adjust focus based on temperature
-    if (tempComp && tempCompAvailable) {
-      // Example: Compensate for temperature changes
-      // In a real implementation, calculate and apply compensation
-      // based on temperature delta and thermal coefficient
-      static double lastCompTemp = temperature;
-      static unsigned long lastCompTime = 0;
-      unsigned long currentTime = millis();
-      
-      if (currentTime - lastCompTime > 30000) { // Check every 30 seconds
-        double tempDelta = temperature - lastCompTemp;
-        if (abs(tempDelta) > 0.5) { // Significant temperature change
-          // Example: 5 steps per degree C
-          int compensation = (int)(tempDelta * 5.0);
-          if (!stepper->isMoving() && abs(compensation) > 0) {
-            int newPosition = stepper->getPosition() + compensation;
-            if (newPosition >= 0 && newPosition <= maxStep) {
-              LOG_DEBUG("Temperature compensation: moving " + String(compensation) + " steps");
-              Move(newPosition);
-            }
-          }
-          lastCompTemp = temperature;
-        }
-        lastCompTime = currentTime;
+    updateTemperatureCompensation();
+  }
+
+  /**
+   * @brief Register coil phase generation, sensor polling and temperature
+   * compensation as separate tasks
+   */
+  void registerTasks(TaskScheduler &scheduler) override {
+    AlpacaDeviceFocuser::registerTasks(scheduler);
+    ArduinoStepper::registerTasks(scheduler); // one task steps every motor on the board
+    scheduler.every("focuser.temperature", TEMP_POLL_INTERVAL_MS * 1000, TASK_PRIORITY_NORMAL, [this]() { updateTemperature(); });
+    scheduler.every("focuser.tempcomp", 1000000, TASK_PRIORITY_LOW, [this]() { updateTemperatureCompensation(); });
+  }
+
+  /**
+   * @brief Learn from and follow temperature changes
+   *
+   * When a client move completes, its position becomes the reference for
+   * corrections, and a sample of the model once it has been kept for
+   * TEMPCOMP_FOCUS_HOLD_MS. While compensation is enabled, small moves keep
+   * the position on the model's line through the reference.
+   */
+  void updateTemperatureCompensation() {
+    if (stepper->isMoving() || !temperatureSensorValid) {
+      return;
+    }
+    unsigned long now = millis();
+    if (clientMovePending) {
+      clientMovePending = false;
+      tempCompModel.setReference(temperature, stepper->getPosition());
+      focusSamplePending = true;
+      referenceSince = now;
+      return;
+    }
+    if (focusSamplePending && TEMPCOMP_FOCUS_HOLD_MS > 0 && now - referenceSince >= TEMPCOMP_FOCUS_HOLD_MS) {
+      focusSamplePending = false;
+      tempCompModel.recordReference();
+    }
+
+    long target;
+    if (tempComp && tempCompAvailable &&
+        tempCompModel.correction(temperature, stepper->getPosition(), target)) {
+      target = constrain(target, 0L, (long)maxStep);
+      if (target != stepper->getPosition()) {
+        LOG_DEFERRED_DEBUG("Temperature compensation: moving to %ld", target);
+        startMove(target);
       }
     }
   }
+
+  /**
+   * @brief Record the current position as in focus at the current temperature
+   * @return false while moving or without a valid temperature
+   */
+  bool RecordFocus() {
+    if (stepper->isMoving() || !temperatureSensorValid) {
+      return false;
+    }
+    focusSamplePending = false;
+    tempCompModel.setReference(temperature, stepper->getPosition());
+    tempCompModel.recordReference();
+    return true;
+  }
+
+  /**
+   * @brief Forget the learned temperature coefficient
+   */
+  void ResetTempCompModel() {
+    tempCompModel.reset();
+    LOG_INFO("Temperature compensation samples cleared");
+  }
+
+  double GetTempCompCoefficient() const { return tempCompModel.coefficient(); }
+  int GetTempCompSamples() const { return tempCompModel.sampleCount(); }
+  bool IsTempCompFitted() const { return tempCompModel.fitted(); }
   
   /**
    * @brief Get the target position
@@ -405,14 +595,21 @@ public:
   }
   
   /**
-   * @brief Set motor speed (steps per second)
+   * @brief Set maximum motor speed (steps per second), persisted by the stepper
    * @param stepsPerSecond Speed in steps per second
+   * @return true if accepted
    */
-  void SetSpeed(int stepsPerSecond) {
-    if (stepsPerSecond > 0 && stepsPerSecond <= 5000) {
-      stepDelayMicros = 1000000 / stepsPerSecond;
-      LOG_INFO("Motor speed set to " + String(stepsPerSecond) + " steps/sec");
-    }
+  bool SetSpeed(int stepsPerSecond) {
+    return stepper->setMaxSpeed(stepsPerSecond);
+  }
+
+  /**
+   * @brief Set motor acceleration (steps per second^2), persisted by the stepper
+   * @param stepsPerSecond2 Acceleration in steps per second^2
+   * @return true if accepted
+   */
+  bool SetAcceleration(int stepsPerSecond2) {
+    return stepper->setAcceleration(stepsPerSecond2);
   }
   
   /**
@@ -430,7 +627,9 @@ public:
    */
   void Home() {
     LOG_DEBUG("Homing focuser to position 0");
-    Move(0);
+    // Not a client focus move: position 0 must not become a sample or the reference
+    forgetFocus();
+    startMove(0);
   }
   
   /**
@@ -440,6 +639,8 @@ public:
   void SetCurrentPosition(int position) {
     if (position >= 0 && position <= maxStep) {
       stepper->setActualPosition(position);
+      // The old reference is in the old position scale
+      forgetFocus();
       LOG_DEBUG("Current position set to: " + String(stepper->getPosition()));
     }
   }
@@ -458,8 +659,11 @@ public:
    */
   void SetTemperatureOffset(double offset) {
     TEMPOFFSET = offset;
-    saveTemperatureOffsetToEEPROM(); // Persist to EEPROM
-    LOG_INFO("Temperature offset set to: " + String(TEMPOFFSET) + " °C (saved to EEPROM)");
+    if (temperatureFilter.ready()) {
+      temperature = temperatureFilter.value() + TEMPOFFSET;
+    }
+    saveTemperatureOffset(); // Persist
+    LOG_INFO("Temperature offset set to: " + String(TEMPOFFSET) + " °C (saved)");
   }
   
   /**
@@ -470,15 +674,59 @@ public:
     return TEMPOFFSET;
   }
 
+  eBACKLASHMODE GetBacklashMode() const { return backlashMode; }
+  int GetBacklashSteps() const { return backlashSteps; }
+  int GetBacklashApproach() const { return backlashApproach; }
+
+  /**
+   * @brief Set backlash compensation, persisted
+   * @param mode BacklashOff, BacklashOvershoot or BacklashOffset
+   * @param steps Backlash in steps, 0..MAX_BACKLASH_STEPS
+   * @param approach Final direction of overshoot moves, +1 (outward) or -1 (inward)
+   * @return false if a value is out of range
+   */
+  bool SetBacklash(int mode, int steps, int approach) {
+    if (mode < BacklashOff || mode > BacklashOffset || steps < 0 || steps > MAX_BACKLASH_STEPS ||
+        (approach != 1 && approach != -1)) {
+      return false;
+    }
+    backlashMode = (eBACKLASHMODE)mode;
+    backlashSteps = steps;
+    backlashApproach = approach;
+    int32_t backlash[3] = {mode, steps, approach};
+    persistentStore.put(STORE_KEY_FOCUSER_BACKLASH, backlash, sizeof(backlash));
+    LOG_INFO("Backlash compensation set: mode " + String(mode) + ", " + String(steps) + " steps");
+    return true;
+  }
+
   int GetTemperaturePin() const {
     return TEMP_PIN;
   }
 
+  int GetTemperatureResolution() const {
+    return TEMP_RESOLUTION;
+  }
+
+  /**
+   * @brief Set the DS18B20 resolution (9..12 bits), persisted
+   * Lower resolutions convert faster (94 ms at 9 bits, 750 ms at 12 bits).
+   * @return false if out of range
+   */
+  bool SetTemperatureResolution(int bits) {
+    if (bits < 9 || bits > 12) {
+      LOG_WARN("Invalid temperature resolution requested: " + String(bits));
+      return false;
+    }
+    TEMP_RESOLUTION = bits;
+    persistentStore.put(STORE_KEY_FOCUSER_TEMP_RESOLUTION, TEMP_RESOLUTION);
+    temperatureBus.setResolution(TEMP_RESOLUTION);
+    LOG_INFO("Temperature resolution set to " + String(TEMP_RESOLUTION) + " bits");
+    return true;
+  }
+
+  // Pins of this focuser's motor and of any other motor on the board
   bool IsStepperDrivePin(int pin) const {
-    return pin == stepper->getPin1() ||
-           pin == stepper->getPin2() ||
-           pin == stepper->getPin3() ||
-           pin == stepper->getPin4();
+    return ArduinoStepper::findByPin(pin) != nullptr;
   }
 
   bool SetTemperaturePin(int pin) {
@@ -497,293 +745,259 @@ public:
     }
 
     TEMP_PIN = pin;
-    saveTemperaturePinToEEPROM();
+    saveTemperaturePin();
     initializeTemperatureSensor();
     LOG_INFO("Temperature sensor pin changed to GPIO " + String(TEMP_PIN));
     return true;
   }
   
   /**
-   * @brief Override setup handler to provide web configuration interface
+   * @brief Serve the setup page (web/focuser_setup.html) from flash
    */
   void setupHandler(AsyncWebServerRequest *request) override {
-    // Check if this is a POST request (form submission)
+    if (request->method() == HTTP_POST) {
+      // Plain form posts from scripts or older pages: apply, then back to the page
+      AlpacaSetupResult result;
+      applySetupConfig(request, result);
+      LOG_INFO("Focuser setup form applied, ok: " + String(result.ok() ? "yes" : "no"));
+      AsyncWebServerResponse *response = request->beginResponse(303);
+      response->addHeader("Location", "/setup/v1/focuser/" + String(GetDeviceNumber()) + "/setup");
+      request->send(response);
+      return;
+    }
 
-    LOG_INFO("Received setup request - Method: " + String(request->method() == HTTP_POST ? "POST" : "GET"));
+    sendAlpacaSetupAsset(request, ARDUINO_FOCUSER_SETUP_PAGE);
+  }
 
+  void setupConfigHandler(AsyncWebServerRequest *request) override {
     if (request->method() == HTTP_POST) {
-      // Process form data
-      LOG_INFO("Processing focuser setup form submission");
-
-      String message = "";
-      
-      // Check for position update
-      if (request->hasParam("position", true)) {
-        String posStr = request->getParam("position", true)->value();
-        int newPos = posStr.toInt();
-        if (newPos >= 0 && newPos <= maxStep) {
-          SetCurrentPosition(newPos);
-          message += "Position set to: " + String(newPos) + "<br>";
-        } else {
-          message += "Error: Position must be between 0 and " + String(maxStep) + "<br>";
-        }
+      AlpacaSetupResult result;
+      applySetupConfig(request, result);
+      result.send(request);
+      return;
+    }
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    response->addHeader("Cache-Control", "no-store");
+    AlpacaJsonObjectWriter config(*response);
+
+    // Current status
+    config.field("name", GetDeviceName());
+    config.field("position", GetPosition());
+    config.field("max_step", maxStep);
+    config.field("step_size", stepSize);
+    config.field("moving", GetIsMoving());
+    config.field("temperature", GetTemperature());
+    config.field("raw_temperature", GetLastRawTemperature());
+    config.field("sensor_valid", IsTemperatureSensorValid());
+    config.field("tempoffset", GetTemperatureOffset());
+    config.field("temp_pin", GetTemperaturePin());
+    config.field("temp_resolution", GetTemperatureResolution());
+    config.field("temp_probes", (int)temperatureBus.deviceCount());
+    config.field("temp_tube_rom", temperatureBus.romString(ProbeTube));
+    config.field("temp_ambient", GetProbeTemperature(ProbeAmbient));
+    config.field("temp_ambient_rom", temperatureBus.romString(ProbeAmbient));
+    config.field("temp_mirror", GetProbeTemperature(ProbeMirror));
+    config.field("temp_mirror_rom", temperatureBus.romString(ProbeMirror));
+    config.field("tempcomp", tempComp);
+    config.field("tempcomp_coefficient", GetTempCompCoefficient());
+    config.field("tempcomp_samples", GetTempCompSamples());
+    config.field("tempcomp_fitted", IsTempCompFitted());
+
+    // WiFi
+    bool accessPoint = WiFi.getMode() == WIFI_AP;
+    config.field("wifi_ap", accessPoint);
+    config.field("wifi_network", accessPoint ? WiFi.softAPSSID() : WiFi.SSID());
+    config.field("wifi_ip", (accessPoint ? WiFi.softAPIP() : WiFi.localIP()).toString());
+    config.field("wifi_rssi", accessPoint ? 0 : (int)WiFi.RSSI());
+    config.field("hostname", WiFi.hostname());
+    config.field("wifi_ssid", wifiConfig.getSSID());
+
+    // MQTT
+    config.field("mqtt_host", mqttBridge.getHost());
+    config.field("mqtt_port", (int)mqttBridge.getPort());
+    config.field("mqtt_prefix", mqttBridge.getPrefix());
+    config.field("mqtt_interval", (unsigned long)mqttBridge.getInterval());
+    config.field("mqtt_connected", mqttBridge.connected());
+    config.field("mqtt_published", (unsigned long)mqttBridge.publishCount());
+
+    // Stepper
+    config.field("stepper_mode", (int)stepper->getStepMode());
+    config.field("max_speed", stepper->getMaxSpeed());
+    config.field("acceleration", stepper->getAcceleration());
+    config.field("max_speed_limit", (long)MAX_SPEED_LIMIT);
+    config.field("max_acceleration_limit", (long)MAX_ACCELERATION_LIMIT);
+    config.field("pin1", stepper->getPin1());
+    config.field("pin2", stepper->getPin2());
+    config.field("pin3", stepper->getPin3());
+    config.field("pin4", stepper->getPin4());
+    config.field("backlash_mode", (int)backlashMode);
+    config.field("backlash_steps", backlashSteps);
+    config.field("backlash_approach", backlashApproach);
+    config.field("max_backlash_steps", MAX_BACKLASH_STEPS);
+    config.end();
+
+    request->send(response);
+  }
+
+private:
+  /**
+   * @brief Apply the setup form fields present in @p request
+   * Each form of the setup page posts one group of fields; every group found
+   * is validated and applied on its own and adds one message to @p result.
+   */
+  void applySetupConfig(AsyncWebServerRequest *request, AlpacaSetupResult &result) {
+    auto param = [request](const char *name) { return findAlpacaParam(request, name, true); };
+
+    if (const AsyncWebParameter *position = param("position")) {
+      int newPos = position->value().toInt();
+      if (newPos >= 0 && newPos <= maxStep) {
+        SetCurrentPosition(newPos);
+        result.done("Position set");
+      } else {
+        result.fail("Error: Position must be between 0 and the max position");
       }
-      
-      // Check for temperature offset update
-      if (request->hasParam("tempoffset", true)) {
-        String offsetStr = request->getParam("tempoffset", true)->value();
-        double newOffset = offsetStr.toDouble();
-        SetTemperatureOffset(newOffset);
-        message += "Temperature offset set to: " + String(newOffset) + " °C<br>";
+    }
+
+    if (const AsyncWebParameter *offset = param("tempoffset")) {
+      SetTemperatureOffset(offset->value().toDouble());
+      result.done("Temperature offset set");
+    }
+
+    if (param("tempcomp_record") != nullptr) {
+      if (RecordFocus()) {
+        result.done("In-focus position recorded");
+      } else {
+        result.fail("Error: Cannot record while moving or without a valid temperature");
       }
+    }
 
-      if (request->hasParam("temp_pin", true)) {
-        int newTempPin = request->getParam("temp_pin", true)->value().toInt();
-        if (SetTemperaturePin(newTempPin)) {
-          message += "Temperature sensor pin set to GPIO: " + String(newTempPin) + "<br>";
-        } else {
-          message += "Error: Temperature sensor pin must be GPIO 0..16 and must not match any stepper drive pin<br>";
-        }
+    if (param("tempcomp_reset") != nullptr) {
+      ResetTempCompModel();
+      result.done("Temperature compensation samples cleared");
+    }
+
+    if (const AsyncWebParameter *pin = param("temp_pin")) {
+      if (SetTemperaturePin(pin->value().toInt())) {
+        result.done("Temperature sensor pin set");
+      } else {
+        result.fail("Error: Temperature sensor pin must be GPIO 0..16 and must not match any stepper drive pin");
       }
-      
-      // Check for WiFi configuration update
-      if (request->hasParam("wifi_ssid", true) && request->hasParam("wifi_password", true)) {
-        String newSSID = request->getParam("wifi_ssid", true)->value();
-        String newPassword = request->getParam("wifi_password", true)->value();
-        
-        if (newSSID.length() > 0) {
-          if (wifiConfig.saveToEEPROM(newSSID, newPassword)) {
-            message += "WiFi credentials saved! SSID: " + newSSID + "<br>";
-            message += "<strong>Please restart the device to connect to the new network.</strong><br>";
-            ESP.reset();
-          } else {
-            message += "Error: Failed to save WiFi credentials<br>";
-          }
-        } else {
-          message += "Error: SSID cannot be empty<br>";
-        }
+    }
+
+    if (const AsyncWebParameter *resolution = param("temp_resolution")) {
+      if (SetTemperatureResolution(resolution->value().toInt())) {
+        result.done("Temperature sensor resolution set");
+      } else {
+        result.fail("Error: Temperature sensor resolution must be 9..12 bits");
       }
-      
-      // Check for stepper configuration update
-      if (request->hasParam("stepper_mode", true)) {
-        int newMode = request->getParam("stepper_mode", true)->value().toInt();
-        if (newMode >= FullStep && newMode <= FullStep2Phase) {
-          stepper->setStepMode((eSTEPMODE)newMode);
-          message += "Stepper mode updated to: " + String(newMode) + "<br>";
-        } else {
-          message += "Error: Invalid stepper mode<br>";
-        }
+    }
+
+    const AsyncWebParameter *probeRole = param("temp_probe_role");
+    const AsyncWebParameter *probeRom = param("temp_probe_rom");
+    if (probeRole != nullptr && probeRom != nullptr) {
+      String rom = probeRom->value();
+      rom.trim();
+      rom.toUpperCase();
+      if (AssignTemperatureProbe(probeRole->value().toInt(), rom)) {
+        result.done("Temperature probe assigned");
+      } else {
+        result.fail("Error: Invalid probe role or ROM (16 hex digits with a valid CRC)");
       }
-      
-      // Check for stepper pins update
-      if (request->hasParam("pin1", true) && request->hasParam("pin2", true) && 
-          request->hasParam("pin3", true) && request->hasParam("pin4", true)) {
-        int pin1 = request->getParam("pin1", true)->value().toInt();
-        int pin2 = request->getParam("pin2", true)->value().toInt();
-        int pin3 = request->getParam("pin3", true)->value().toInt();
-        int pin4 = request->getParam("pin4", true)->value().toInt();
-        
-        // Validate pin numbers (ESP8266 GPIO 0-16)
-        if (pin1 >= 0 && pin1 <= 16 && pin2 >= 0 && pin2 <= 16 && 
-            pin3 >= 0 && pin3 <= 16 && pin4 >= 0 && pin4 <= 16) {
-          // Check for duplicate pins
-          if (pin1 != pin2 && pin1 != pin3 && pin1 != pin4 && 
-              pin2 != pin3 && pin2 != pin4 && pin3 != pin4) {
-            if (pin1 == TEMP_PIN || pin2 == TEMP_PIN || pin3 == TEMP_PIN || pin4 == TEMP_PIN) {
-              message += "Error: Stepper drive pins must not include the configured temperature sensor pin (GPIO " + String(TEMP_PIN) + ")<br>";
-            } else {
-              stepper->setPins(pin1, pin2, pin3, pin4);
-              message += "Stepper pins updated!<br>";
-              message += "<strong>Warning: Please verify motor connections before moving!</strong><br>";
-            }
-          } else {
-            message += "Error: Duplicate pin numbers not allowed<br>";
-          }
-        } else {
-          message += "Error: Pin numbers must be between 0 and 16<br>";
-        }
+    }
+
+    if (param("temp_rescan") != nullptr) {
+      RescanTemperatureProbes();
+      result.done("Temperature sensor bus will be searched again");
+    }
+
+    const AsyncWebParameter *ssid = param("wifi_ssid");
+    const AsyncWebParameter *password = param("wifi_password");
+    if (ssid != nullptr && password != nullptr) {
+      if (ssid->value().length() == 0) {
+        result.fail("Error: SSID cannot be empty");
+      } else if (wifiConfig.save(ssid->value(), password->value())) {
+        result.done("WiFi credentials saved, restarting to connect to the new network");
+        result.restart();
+        // Restart once the response has gone out
+        taskScheduler.after("restart", 500000, TASK_PRIORITY_LOW, []() { ESP.reset(); });
+      } else {
+        result.fail("Error: Failed to save WiFi credentials");
       }
-      
-      // Redirect back to GET after POST
-      String html = "<html><head><meta http-equiv='refresh' content='2;url=/setup/v1/focuser/" + 
-                    String(GetDeviceNumber()) + "/setup'></head><body>";
-      html += "<h1>Focuser Setup</h1>";
-      html += "<p>" + message + "</p>";
-      html += "<p>Redirecting back to setup page...</p>";
-      html += "</body></html>";
-      request->send(200, "text/html", html);
-      return;
     }
-    
-    LOG_INFO("Serving focuser setup page");
-    // GET request - show the form
-    String html = "<!DOCTYPE html><html><head>";
-    html += "<meta charset='UTF-8'>";
-    html += "<meta name='viewport' content='width=device-width, initial-scale=1.0'>";
-    html += "<title>Focuser Setup</title>";
-    html += "<style>";
-    html += "body { font-family: Arial, sans-serif; margin: 20px; background-color: #f0f0f0; }";
-    html += "h1 { color: #333; }";
-    html += ".container { max-width: 600px; margin: 0 auto; background-color: white; padding: 20px; border-radius: 8px; box-shadow: 0 2px 4px rgba(0,0,0,0.1); }";
-    html += ".info-section { background-color: #e8f4f8; padding: 15px; border-radius: 5px; margin-bottom: 20px; }";
-    html += ".info-row { display: flex; justify-content: space-between; margin: 8px 0; }";
-    html += ".info-label { font-weight: bold; color: #555; }";
-    html += ".info-value { color: #0066cc; }";
-    html += ".form-section { background-color: #f9f9f9; padding: 15px; border-radius: 5px; margin-bottom: 15px; }";
-    html += "h2 { color: #555; font-size: 1.2em; margin-top: 0; }";
-    html += "label { display: block; margin: 10px 0 5px 0; font-weight: bold; }";
-    html += "input[type='number'], input[type='text'], input[type='password'], select { width: 100%; padding: 8px; border: 1px solid #ddd; border-radius: 4px; box-sizing: border-box; }";
-    html += "input[type='submit'] { background-color: #0066cc; color: white; padding: 10px 20px; border: none; border-radius: 4px; cursor: pointer; margin-top: 10px; }";
-    html += "input[type='submit']:hover { background-color: #0052a3; }";
-    html += ".help-text { font-size: 0.9em; color: #666; margin-top: 5px; }";
-    html += "</style>";
-    html += "</head><body>";
-    html += "<div class='container'>";
-    html += "<h1>Focuser Setup - " + GetDeviceName() + "</h1>";
-    
-    // Current status section
-    html += "<div class='info-section'>";
-    html += "<h2>Current Status</h2>";
-    html += "<div class='info-row'><span class='info-label'>Position:</span><span class='info-value'>" + String(GetPosition()) + " steps</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Temperature:</span><span class='info-value'>" + String(GetTemperature(), 2) + " °C</span></div>";
-    if (IsTemperatureSensorValid()) {
-      html += "<div class='info-row'><span class='info-label'>Temperature Sensor:</span><span class='info-value' style='color: #00aa00;'>Valid</span></div>";
-      html += "<div class='info-row'><span class='info-label'>Raw Sensor Value:</span><span class='info-value'>" + String(GetLastRawTemperature(), 2) + " °C</span></div>";
-    } else {
-      html += "<div class='info-row'><span class='info-label'>Temperature Sensor:</span><span class='info-value' style='color: #cc0000;'>Invalid</span></div>";
-      html += "<div class='info-row'><span class='info-label'>Raw Sensor Value:</span><span class='info-value' style='color: #cc0000;'>" + String(GetLastRawTemperature(), 2) + " °C</span></div>";
-    }
-    html += "<div class='info-row'><span class='info-label'>Temperature Offset:</span><span class='info-value'>" + String(GetTemperatureOffset(), 2) + " °C</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Temperature Sensor Pin:</span><span class='info-value'>GPIO " + String(GetTemperaturePin()) + "</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Max Position:</span><span class='info-value'>" + String(maxStep) + " steps</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Step Size:</span><span class='info-value'>" + String(stepSize, 2) + " microns</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Moving:</span><span class='info-value'>" + String(GetIsMoving() ? "Yes" : "No") + "</span></div>";
-    html += "</div>";
-    
-    // WiFi status section
-    html += "<div class='info-section'>";
-    html += "<h2>WiFi Status</h2>";
-    if (WiFi.getMode() == WIFI_AP) {
-      html += "<div class='info-row'><span class='info-label'>Mode:</span><span class='info-value' style='color: #ff9900;'>Access Point (Fallback)</span></div>";
-      html += "<div class='info-row'><span class='info-label'>AP SSID:</span><span class='info-value'>" + String(WiFi.softAPSSID()) + "</span></div>";
-      html += "<div class='info-row'><span class='info-label'>AP IP:</span><span class='info-value'>" + WiFi.softAPIP().toString() + "</span></div>";
-    } else {
-      html += "<div class='info-row'><span class='info-label'>Mode:</span><span class='info-value' style='color: #00aa00;'>Station (Connected)</span></div>";
-      html += "<div class='info-row'><span class='info-label'>SSID:</span><span class='info-value'>" + String(WiFi.SSID()) + "</span></div>";
-      html += "<div class='info-row'><span class='info-label'>IP Address:</span><span class='info-value'>" + WiFi.localIP().toString() + "</span></div>";
-      html += "<div class='info-row'><span class='info-label'>Signal:</span><span class='info-value'>" + String(WiFi.RSSI()) + " dBm</span></div>";
+
+    const AsyncWebParameter *mqttHost = param("mqtt_host");
+    const AsyncWebParameter *mqttPort = param("mqtt_port");
+    const AsyncWebParameter *mqttPrefix = param("mqtt_prefix");
+    const AsyncWebParameter *mqttInterval = param("mqtt_interval");
+    if (mqttHost != nullptr && mqttPort != nullptr && mqttPrefix != nullptr && mqttInterval != nullptr) {
+      String newHost = mqttHost->value();
+      String newPrefix = mqttPrefix->value();
+      newHost.trim();
+      newPrefix.trim();
+      if (mqttBridge.configure(newHost, mqttPort->value().toInt(), newPrefix, mqttInterval->value().toInt())) {
+        result.done(newHost.length() > 0 ? "MQTT broker set" : "MQTT publishing disabled");
+      } else {
+        result.fail("Error: Invalid MQTT settings (port 1..65535, interval 100..3600000 ms, prefix without '/', '+' or '#' at the end)");
+      }
+    }
+
+    if (const AsyncWebParameter *mode = param("stepper_mode")) {
+      int newMode = mode->value().toInt();
+      if (newMode >= FullStep && newMode <= FullStep2Phase) {
+        stepper->setStepMode((eSTEPMODE)newMode);
+        result.done("Stepper mode updated");
+      } else {
+        result.fail("Error: Invalid stepper mode");
+      }
+    }
+
+    const AsyncWebParameter *speed = param("max_speed");
+    const AsyncWebParameter *acceleration = param("acceleration");
+    if (speed != nullptr && acceleration != nullptr) {
+      if (SetSpeed(speed->value().toInt()) && SetAcceleration(acceleration->value().toInt())) {
+        result.done("Motion profile updated");
+      } else {
+        result.fail("Error: Speed or acceleration out of range");
+      }
+    }
+
+    const AsyncWebParameter *backlashModeParam = param("backlash_mode");
+    const AsyncWebParameter *backlashStepsParam = param("backlash_steps");
+    const AsyncWebParameter *backlashApproachParam = param("backlash_approach");
+    if (backlashModeParam != nullptr && backlashStepsParam != nullptr && backlashApproachParam != nullptr) {
+      if (SetBacklash(backlashModeParam->value().toInt(), backlashStepsParam->value().toInt(),
+                      backlashApproachParam->value().toInt())) {
+        result.done("Backlash compensation updated");
+      } else {
+        result.fail("Error: Invalid backlash settings (0..1000 steps, approach 1 or -1)");
+      }
+    }
+
+    const AsyncWebParameter *pins[] = {param("pin1"), param("pin2"), param("pin3"), param("pin4")};
+    if (pins[0] != nullptr && pins[1] != nullptr && pins[2] != nullptr && pins[3] != nullptr) {
+      int pin1 = pins[0]->value().toInt();
+      int pin2 = pins[1]->value().toInt();
+      int pin3 = pins[2]->value().toInt();
+      int pin4 = pins[3]->value().toInt();
+
+      // Validate pin numbers (ESP8266 GPIO 0-16)
+      if (pin1 < 0 || pin1 > 16 || pin2 < 0 || pin2 > 16 ||
+          pin3 < 0 || pin3 > 16 || pin4 < 0 || pin4 > 16) {
+        result.fail("Error: Pin numbers must be between 0 and 16");
+      } else if (pin1 == pin2 || pin1 == pin3 || pin1 == pin4 ||
+                 pin2 == pin3 || pin2 == pin4 || pin3 == pin4) {
+        result.fail("Error: Duplicate pin numbers not allowed");
+      } else if (pin1 == TEMP_PIN || pin2 == TEMP_PIN || pin3 == TEMP_PIN || pin4 == TEMP_PIN) {
+        result.fail("Error: Stepper drive pins must not include the temperature sensor pin");
+      } else if (ArduinoStepper::findByPin(pin1, stepper) || ArduinoStepper::findByPin(pin2, stepper) ||
+                 ArduinoStepper::findByPin(pin3, stepper) || ArduinoStepper::findByPin(pin4, stepper)) {
+        result.fail("Error: Pin already drives another stepper motor");
+      } else {
+        stepper->setPins(pin1, pin2, pin3, pin4);
+        result.done("Stepper pins updated, verify motor connections before moving");
+      }
     }
-    html += "<div class='info-row'><span class='info-label'>Hostname:</span><span class='info-value'>" + String(WiFi.hostname()) + "</span></div>";
-    html += "</div>";
-    
-    // Stepper configuration status section
-    html += "<div class='info-section'>";
-    html += "<h2>Stepper Configuration</h2>";
-    html += "<div class='info-row'><span class='info-label'>Mode:</span><span class='info-value'>";
-    switch(stepper->getStepMode()) {
-      case FullStep: html += "Full Step (1)"; break;
-      case HalfStep: html += "Half Step (1/2)"; break;
-      case QuaterStep: html += "Quarter Step (1/4)"; break;
-      case EighthStep: html += "Eighth Step (1/8)"; break;
-      case SixteenthStep: html += "Sixteenth Step (1/16)"; break;
-      case FullStep2Phase: html += "Full Step 2-Phase"; break;
-      default: html += "Unknown"; break;
-    }
-    html += "</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Pin 1:</span><span class='info-value'>GPIO " + String(stepper->getPin1()) + "</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Pin 2:</span><span class='info-value'>GPIO " + String(stepper->getPin2()) + "</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Pin 3:</span><span class='info-value'>GPIO " + String(stepper->getPin3()) + "</span></div>";
-    html += "<div class='info-row'><span class='info-label'>Pin 4:</span><span class='info-value'>GPIO " + String(stepper->getPin4()) + "</span></div>";
-    html += "</div>";
-    
-    // Set Position form
-    html += "<div class='form-section'>";
-    html += "<form method='POST' action='/setup/v1/focuser/" + String(GetDeviceNumber()) + "/setup'>";
-    html += "<h2>Set Current Position</h2>";
-    html += "<label for='position'>New Position (steps):</label>";
-    html += "<input type='number' id='position' name='position' min='0' max='" + String(maxStep) + "' value='" + String(GetPosition()) + "' required>";
-    html += "<div class='help-text'>Set the current position value (useful after manual adjustment or homing)</div>";
-    html += "<input type='submit' value='Set Position'>";
-    html += "</form>";
-    html += "</div>";
-    
-    // Set Temperature Offset form
-    html += "<div class='form-section'>";
-    html += "<form method='POST' action='/setup/v1/focuser/" + String(GetDeviceNumber()) + "/setup'>";
-    html += "<h2>Calibrate Temperature Sensor</h2>";
-    html += "<label for='tempoffset'>Temperature Offset (°C):</label>";
-    html += "<input type='number' id='tempoffset' name='tempoffset' step='0.1' value='" + String(GetTemperatureOffset(), 2) + "' required>";
-    html += "<div class='help-text'>Adjust this offset to calibrate the temperature sensor reading</div>";
-    html += "<input type='submit' value='Set Temperature Offset'>";
-    html += "</form>";
-    html += "</div>";
-
-    // Temperature Sensor Pin form
-    html += "<div class='form-section'>";
-    html += "<form method='POST' action='/setup/v1/focuser/" + String(GetDeviceNumber()) + "/setup'>";
-    html += "<h2>Temperature Sensor Pin</h2>";
-    html += "<label for='temp_pin'>GPIO Pin (DS18B20 Data):</label>";
-    html += "<input type='number' id='temp_pin' name='temp_pin' min='0' max='16' value='" + String(GetTemperaturePin()) + "' required>";
-    html += "<div class='help-text'>Set the GPIO pin used by the DS18B20 data line. Sensor bus will be reinitialized immediately.</div>";
-    html += "<input type='submit' value='Set Temperature Pin'>";
-    html += "</form>";
-    html += "</div>";
-    
-    // WiFi Configuration form
-    html += "<div class='form-section'>";
-    html += "<form method='POST' action='/setup/v1/focuser/" + String(GetDeviceNumber()) + "/setup'>";
-    html += "<h2>WiFi Configuration</h2>";
-    html += "<label for='wifi_ssid'>WiFi SSID:</label>";
-    html += "<input type='text' id='wifi_ssid' name='wifi_ssid' maxlength='31' value='" + String(wifiConfig.getSSID()) + "' required>";
-    html += "<label for='wifi_password'>WiFi Password:</label>";
-    html += "<input type='password' id='wifi_password' name='wifi_password' maxlength='63' value='' placeholder='Enter new password or leave empty'>";
-    html += "<div class='help-text' style='color: #ff6600;'><strong>Warning:</strong> Device will restart after saving WiFi settings to connect to the new network.</div>";
-    html += "<input type='submit' value='Save WiFi Settings'>";
-    html += "</form>";
-    html += "</div>";
-    
-    // Stepper Mode Configuration form
-    html += "<div class='form-section'>";
-    html += "<form method='POST' action='/setup/v1/focuser/" + String(GetDeviceNumber()) + "/setup'>";
-    html += "<h2>Stepper Mode Configuration</h2>";
-    html += "<label for='stepper_mode'>Stepping Mode:</label>";
-    html += "<select id='stepper_mode' name='stepper_mode' style='width: 100%; padding: 8px; border: 1px solid #ddd; border-radius: 4px; box-sizing: border-box;'>";
-    html += "<option value='0'" + String(stepper->getStepMode() == FullStep ? " selected" : "") + ">Full Step (1)</option>";
-    html += "<option value='1'" + String(stepper->getStepMode() == HalfStep ? " selected" : "") + ">Half Step (1/2)</option>";
-    html += "<option value='2'" + String(stepper->getStepMode() == QuaterStep ? " selected" : "") + ">Quarter Step (1/4)</option>";
-    html += "<option value='3'" + String(stepper->getStepMode() == EighthStep ? " selected" : "") + ">Eighth Step (1/8)</option>";
-    html += "<option value='4'" + String(stepper->getStepMode() == SixteenthStep ? " selected" : "") + ">Sixteenth Step (1/16)</option>";
-    html += "<option value='5'" + String(stepper->getStepMode() == FullStep2Phase ? " selected" : "") + ">Full Step 2-Phase</option>";
-    html += "</select>";
-    html += "<div class='help-text'>Select the stepping mode for your motor driver. Higher resolution = smoother but slower movement.</div>";
-    html += "<input type='submit' value='Set Stepper Mode'>";
-    html += "</form>";
-    html += "</div>";
-    
-    // Stepper Pins Configuration form
-    html += "<div class='form-section'>";
-    html += "<form method='POST' action='/setup/v1/focuser/" + String(GetDeviceNumber()) + "/setup'>";
-    html += "<h2>Stepper Pin Configuration</h2>";
-    html += "<label for='pin1'>Pin 1 (GPIO):</label>";
-    html += "<input type='number' id='pin1' name='pin1' min='0' max='16' value='" + String(stepper->getPin1()) + "' required>";
-    html += "<label for='pin2'>Pin 2 (GPIO):</label>";
-    html += "<input type='number' id='pin2' name='pin2' min='0' max='16' value='" + String(stepper->getPin2()) + "' required>";
-    html += "<label for='pin3'>Pin 3 (GPIO):</label>";
-    html += "<input type='number' id='pin3' name='pin3' min='0' max='16' value='" + String(stepper->getPin3()) + "' required>";
-    html += "<label for='pin4'>Pin 4 (GPIO):</label>";
-    html += "<input type='number' id='pin4' name='pin4' min='0' max='16' value='" + String(stepper->getPin4()) + "' required>";
-    html += "<div class='help-text' style='color: #ff6600;'><strong>Warning:</strong> Changing pins will immediately reconfigure GPIO. Verify motor connections!</div>";
-    html += "<input type='submit' value='Set Stepper Pins'>";
-    html += "</form>";
-    html += "</div>";
-    
-    html += "<p style='text-align: center; color: #888; font-size: 0.9em; margin-top: 30px;'>";
-    html += "<a href='/management/v1/description' style='color: #0066cc; text-decoration: none;'>Back to Management API</a>";
-    html += "</p>";
-    html += "</div>";
-    html += "</body></html>";
-    
-    request->send(200, "text/html", html);
   }
 };
 
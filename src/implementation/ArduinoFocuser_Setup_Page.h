@@ -0,0 +1,296 @@
+// Generated by tools/embed_web_assets.py from web/focuser_setup.html - do not edit
+#ifndef ARDUINO_FOCUSER_SETUP_PAGE_H
+#define ARDUINO_FOCUSER_SETUP_PAGE_H
+
+#include <Arduino.h>
+#include "alpaca_api/Alpaca_Setup_Page.h"
+
+// 16442 bytes, 4500 bytes gzipped
+static const uint8_t ARDUINO_FOCUSER_SETUP_PAGE_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x5c, 0x7d, 0x73, 0xdb, 0xb8,
+  0xd1, 0xff, 0xdf, 0x9f, 0x02, 0xa7, 0xeb, 0x13, 0xc9, 0x53, 0xeb, 0xd5, 0x2f, 0x75, 0x6c, 0xcb,
+  0x1d, 0xc7, 0x49, 0x7a, 0x79, 0x26, 0xb9, 0xb8, 0x71, 0xee, 0x3a, 0x9d, 0xf4, 0xc6, 0x03, 0x91,
+  0xa0, 0x84, 0x9a, 0x24, 0x78, 0x04, 0x69, 0xd9, 0x97, 0xe6, 0xbb, 0x3f, 0xbb, 0x0b, 0x90, 0x84,
+  0x64, 0x4a, 0xa6, 0xe4, 0x4c, 0x9f, 0xcb, 0x24, 0x92, 0x40, 0x60, 0x77, 0xf1, 0xdb, 0xc5, 0x62,
+  0x77, 0x01, 0xde, 0xd9, 0x0f, 0xaf, 0x3f, 0x5e, 0x7e, 0xfe, 0xe7, 0xd5, 0x1b, 0x36, 0xcb, 0xa2,
+  0xf0, 0x7c, 0xe7, 0xac, 0xf8, 0x10, 0xdc, 0x87, 0x8f, 0x48, 0x64, 0x9c, 0x79, 0x33, 0x9e, 0x6a,
+  0x91, 0x8d, 0x5b, 0xbf, 0x7c, 0x7e, 0xdb, 0x3d, 0x6e, 0x15, 0xcd, 0x31, 0x8f, 0xc4, 0xb8, 0x75,
+  0x27, 0xc5, 0x3c, 0x51, 0x69, 0xd6, 0x62, 0x9e, 0x8a, 0x33, 0x11, 0x43, 0xb7, 0xb9, 0xf4, 0xb3,
+  0xd9, 0xd8, 0x17, 0x77, 0xd2, 0x13, 0x5d, 0xfa, 0xb1, 0xc7, 0x64, 0x2c, 0x33, 0xc9, 0xc3, 0xae,
+  0xf6, 0x78, 0x28, 0xc6, 0xc3, 0xde, 0x00, 0xc9, 0x64, 0x32, 0x0b, 0xc5, 0xf9, 0x5b, 0xe5, 0xe5,
+  0x5a, 0xa4, 0xec, 0x5a, 0x64, 0x79, 0x72, 0xd6, 0x37, 0x8d, 0x3b, 0x67, 0x3f, 0x74, 0xbb, 0x3b,
+  0xcc, 0x34, 0xb2, 0x84, 0x4f, 0x05, 0x53, 0x01, 0xbb, 0x48, 0xfd, 0x5c, 0xc6, 0xca, 0x8e, 0xe8,
+  0xc1, 0xd3, 0xf4, 0x4e, 0xf8, 0x6c, 0xfa, 0x87, 0x4c, 0x12, 0xf8, 0x0c, 0x52, 0x15, 0xb1, 0x20,
+  0xe4, 0x7a, 0x76, 0xca, 0x84, 0x2f, 0x33, 0x96, 0xcd, 0xa4, 0x66, 0x81, 0x0c, 0x05, 0xe3, 0xb1,
+  0x0f, 0xd4, 0xd2, 0x3c, 0x66, 0x99, 0x52, 0xa1, 0xee, 0x8b, 0x68, 0x22, 0xfc, 0x9b, 0xb9, 0x98,
+  0xdc, 0x70, 0x0d, 0x73, 0xd3, 0xbd, 0xe4, 0x81, 0x75, 0x78, 0xa8, 0x15, 0xf5, 0x99, 0x88, 0x40,
+  0xa5, 0x82, 0x89, 0x3b, 0x91, 0x3e, 0xb0, 0xab, 0x90, 0x67, 0xf0, 0x33, 0x7a, 0xf7, 0x91, 0x4d,
+  0x72, 0x19, 0xfa, 0xbb, 0x3d, 0xa0, 0x74, 0x11, 0x86, 0xec, 0x8e, 0x87, 0xb9, 0xd0, 0x8c, 0x43,
+  0xcf, 0x14, 0xe0, 0x32, 0xec, 0x81, 0x11, 0x9b, 0xa7, 0x32, 0x03, 0x28, 0x80, 0x15, 0x3b, 0x23,
+  0xd1, 0xf3, 0x34, 0x3c, 0xef, 0x03, 0x3e, 0x81, 0x9c, 0x32, 0xae, 0xd9, 0xff, 0x5e, 0x7f, 0xfc,
+  0xb9, 0xb7, 0xd3, 0xed, 0xc2, 0x2c, 0x75, 0xf6, 0x80, 0xb3, 0x9d, 0x28, 0xff, 0x81, 0x7d, 0x65,
+  0x01, 0x40, 0xd8, 0x0d, 0x78, 0x24, 0xc3, 0x87, 0x13, 0x98, 0x2c, 0x00, 0xb6, 0xc7, 0x34, 0x8f,
+  0x75, 0x17, 0x66, 0x2b, 0x83, 0x53, 0x16, 0xf1, 0x74, 0x2a, 0xe3, 0x13, 0x36, 0x1a, 0x24, 0xf7,
+  0xa7, 0x6c, 0xc2, 0xbd, 0xdb, 0x69, 0xaa, 0xf2, 0xd8, 0xef, 0x7a, 0x2a, 0x54, 0xe9, 0x09, 0xfb,
+  0x31, 0x18, 0xe0, 0x9f, 0x53, 0xf6, 0x6d, 0x67, 0x36, 0x04, 0x7a, 0x45, 0xf3, 0xfe, 0xfe, 0x3e,
+  0xb6, 0xf5, 0x50, 0x45, 0x5c, 0xc6, 0x00, 0xf6, 0x57, 0xa0, 0x75, 0x6f, 0x94, 0x73, 0xc2, 0x8e,
+  0x06, 0x44, 0xaf, 0xa0, 0x3e, 0x60, 0x3c, 0xcf, 0x54, 0x1d, 0xfd, 0xf9, 0x4c, 0x66, 0xe2, 0x14,
+  0xd4, 0xe1, 0xfb, 0x32, 0x9e, 0x96, 0x72, 0xa8, 0xd4, 0x17, 0x69, 0x37, 0xe5, 0xbe, 0xcc, 0xf5,
+  0x09, 0x3b, 0x36, 0x6d, 0xf7, 0x5d, 0x3d, 0xe3, 0xbe, 0x9a, 0x23, 0xbd, 0x51, 0x72, 0xcf, 0x0e,
+  0xe0, 0x6f, 0x3a, 0x9d, 0xf0, 0xce, 0x60, 0x8f, 0xfe, 0xf4, 0x86, 0xbb, 0x24, 0x93, 0x8c, 0x03,
+  0x05, 0xf3, 0xf3, 0x32, 0xa9, 0x62, 0x10, 0xab, 0x66, 0x52, 0xe2, 0x38, 0x38, 0x08, 0x8e, 0x1d,
+  0xb6, 0xc3, 0xc3, 0x1a, 0xb6, 0x87, 0xd5, 0x14, 0xba, 0x13, 0x95, 0x65, 0x2a, 0x2a, 0xe4, 0x2b,
+  0x98, 0xa4, 0x6a, 0x0e, 0x0c, 0x7c, 0xa9, 0x93, 0x90, 0x03, 0xbe, 0x41, 0x28, 0xe0, 0xe1, 0xbf,
+  0x73, 0x9d, 0xc9, 0xe0, 0xa1, 0x6b, 0xad, 0xf7, 0x84, 0xe9, 0x84, 0x83, 0xd9, 0x4e, 0x44, 0x36,
+  0x17, 0x22, 0xae, 0x40, 0x81, 0x59, 0xb1, 0x41, 0x45, 0x2b, 0xe4, 0x13, 0x11, 0x16, 0x1a, 0x9b,
+  0x0b, 0x39, 0x9d, 0xc1, 0xd0, 0x89, 0x0a, 0xfd, 0xd3, 0x12, 0xf4, 0xc3, 0xc3, 0xc3, 0xaa, 0x3f,
+  0xd9, 0x8a, 0xa3, 0x91, 0xc1, 0xe0, 0xe8, 0xc8, 0xf3, 0xe8, 0xb9, 0xba, 0x5d, 0x68, 0xe7, 0x7c,
+  0x60, 0xf8, 0x4c, 0xc0, 0xa4, 0xaa, 0x07, 0x9e, 0x37, 0x18, 0xd8, 0x07, 0x73, 0x9e, 0xc6, 0xce,
+  0x93, 0x20, 0x38, 0x3a, 0xb2, 0x4f, 0xd0, 0x4c, 0xd7, 0x63, 0x19, 0xbc, 0xc4, 0x3f, 0xdb, 0x60,
+  0x69, 0x3a, 0x82, 0x61, 0x8d, 0x1c, 0xde, 0x34, 0x47, 0xc2, 0x40, 0xcb, 0x3f, 0x04, 0x74, 0xea,
+  0x8d, 0x44, 0x54, 0x0e, 0xcd, 0x54, 0x72, 0x62, 0x40, 0x2b, 0xe0, 0x2a, 0xc1, 0x9f, 0x84, 0xca,
+  0xbb, 0xad, 0xd0, 0x1d, 0x0e, 0x10, 0x5e, 0xe4, 0x8b, 0xfd, 0x6b, 0x40, 0xfd, 0xb6, 0x23, 0xe3,
+  0x24, 0xcf, 0xbe, 0x64, 0x0f, 0x89, 0x18, 0xb7, 0xe3, 0x1c, 0x96, 0x6f, 0xda, 0xfe, 0x0d, 0xfd,
+  0x4a, 0xd5, 0x9a, 0x89, 0xfb, 0x6c, 0xb9, 0x2d, 0x81, 0xe5, 0x3d, 0x87, 0xc9, 0x61, 0xbb, 0x16,
+  0x21, 0x40, 0x03, 0x52, 0x58, 0xb3, 0x1f, 0x0e, 0x06, 0xff, 0xe3, 0x20, 0x71, 0x5c, 0x01, 0x01,
+  0xcf, 0x40, 0x12, 0xad, 0x42, 0xe9, 0xb3, 0x1f, 0x7d, 0xdf, 0x7f, 0x04, 0xd0, 0x41, 0x69, 0xe3,
+  0xf2, 0x0f, 0x1a, 0x6c, 0x9f, 0x43, 0xd3, 0xb2, 0xac, 0x3a, 0x9f, 0x44, 0x12, 0xe4, 0xaa, 0xd7,
+  0x47, 0x61, 0x07, 0x2b, 0x16, 0x18, 0xe1, 0xe2, 0xae, 0xb2, 0x13, 0x16, 0xab, 0x58, 0xd4, 0xcb,
+  0xe3, 0xe5, 0xa9, 0x46, 0x22, 0x89, 0x92, 0x60, 0xcb, 0xe9, 0xa2, 0x1a, 0x86, 0x76, 0x29, 0xd4,
+  0x89, 0x76, 0x32, 0x53, 0x77, 0xe4, 0x13, 0x6a, 0x05, 0x3c, 0x1c, 0x71, 0xe3, 0x3d, 0x66, 0x22,
+  0x4c, 0xba, 0x08, 0x72, 0x61, 0xf7, 0x46, 0xe7, 0x83, 0xde, 0x4b, 0xd4, 0x79, 0x31, 0xe0, 0xe8,
+  0xe8, 0x68, 0x91, 0xb3, 0xb5, 0x9b, 0x1f, 0x23, 0xa1, 0x35, 0x38, 0x43, 0xed, 0x9a, 0x81, 0x9d,
+  0x4c, 0x8d, 0x9d, 0x06, 0xc1, 0xb1, 0x18, 0x2c, 0x23, 0xb1, 0xb1, 0xb1, 0x9e, 0xf5, 0xad, 0x83,
+  0x3d, 0xeb, 0xdb, 0x1d, 0x0d, 0x3d, 0x2d, 0x7c, 0xf8, 0xf2, 0x8e, 0x79, 0xb0, 0x53, 0xe8, 0x71,
+  0xab, 0x74, 0x8a, 0xb8, 0x25, 0xcd, 0x86, 0x8b, 0xfb, 0x11, 0xeb, 0xb2, 0x33, 0xf0, 0x08, 0x31,
+  0xf3, 0x79, 0xc6, 0xbb, 0x3a, 0xe3, 0x59, 0x0e, 0x43, 0x70, 0xeb, 0x6b, 0x9d, 0x03, 0x71, 0x78,
+  0x02, 0x1f, 0x30, 0xc8, 0x50, 0x94, 0xfe, 0xb8, 0x55, 0x4c, 0x13, 0x9f, 0x43, 0xdb, 0xf9, 0xce,
+  0x02, 0x33, 0xd7, 0xdb, 0x11, 0xbf, 0xd1, 0xf9, 0x65, 0x9e, 0xa6, 0xe0, 0x79, 0xd8, 0x35, 0x11,
+  0x07, 0x6a, 0xa3, 0xf3, 0xc7, 0x43, 0xc0, 0x77, 0x01, 0x41, 0x92, 0xc4, 0x6d, 0xa6, 0x75, 0xd5,
+  0x3a, 0xbf, 0x52, 0x5a, 0x22, 0xc5, 0x93, 0x42, 0xa4, 0x47, 0x1d, 0xc9, 0xff, 0x14, 0x14, 0x16,
+  0xe6, 0x92, 0xd8, 0xb1, 0xe5, 0x7c, 0x98, 0xce, 0x44, 0xa2, 0xcb, 0xc9, 0xd1, 0x1c, 0x36, 0x94,
+  0xe7, 0xb3, 0x88, 0x12, 0x91, 0x02, 0xfd, 0x54, 0x6c, 0x23, 0x52, 0x56, 0x0d, 0x6f, 0x99, 0x27,
+  0xbe, 0xf0, 0x64, 0x04, 0xdb, 0xf3, 0xb8, 0x35, 0xaa, 0xe4, 0x7c, 0xe1, 0x8b, 0xe9, 0xe9, 0xe5,
+  0xf7, 0x12, 0x14, 0xf4, 0x1d, 0xe3, 0xf2, 0x79, 0x42, 0x5e, 0xd2, 0xb1, 0xa6, 0xae, 0x8e, 0x05,
+  0x6c, 0xc3, 0xfb, 0x13, 0x9f, 0x5b, 0x9e, 0xec, 0x57, 0x24, 0xbd, 0x0d, 0x52, 0x29, 0x9f, 0xdf,
+  0xfc, 0xff, 0xa0, 0xf5, 0x31, 0x08, 0x20, 0x6e, 0xda, 0x56, 0xbb, 0x8a, 0x46, 0xff, 0xd7, 0x95,
+  0xcb, 0xae, 0xe4, 0xd3, 0x6b, 0xe4, 0x6f, 0x57, 0x10, 0xe9, 0xad, 0x90, 0xfb, 0x26, 0x91, 0xb1,
+  0xa3, 0xf6, 0xef, 0x24, 0xdc, 0x27, 0x01, 0x5b, 0x4d, 0xbe, 0xed, 0x02, 0x26, 0xb9, 0xd2, 0x92,
+  0x44, 0x05, 0xe1, 0x44, 0x66, 0xdf, 0x6d, 0x19, 0xb3, 0xab, 0x54, 0x4d, 0x84, 0xde, 0x5a, 0xbe,
+  0x84, 0x86, 0x57, 0xb2, 0x05, 0xe8, 0xed, 0xf7, 0x58, 0x96, 0x4f, 0x84, 0xc5, 0x1a, 0xd7, 0x15,
+  0x75, 0xc5, 0xb6, 0x1b, 0x08, 0xa5, 0xbf, 0x0f, 0xce, 0x17, 0xd1, 0x44, 0xa2, 0x77, 0x25, 0xf9,
+  0x1b, 0x2d, 0x6e, 0x12, 0x82, 0x9b, 0x61, 0xcf, 0x5c, 0xe2, 0x1f, 0x64, 0x9a, 0xa2, 0xd5, 0x6d,
+  0xc6, 0x3b, 0xa2, 0x51, 0xcf, 0x65, 0xcd, 0xef, 0xd9, 0x73, 0xb6, 0x05, 0x48, 0x0f, 0x6e, 0x70,
+  0x23, 0xf8, 0x9e, 0xdb, 0xc2, 0x35, 0x50, 0x60, 0xd7, 0x18, 0x34, 0x6c, 0x21, 0x10, 0xb2, 0xbf,
+  0xc1, 0x88, 0x63, 0x9d, 0xd7, 0x88, 0xa4, 0x97, 0xaa, 0xf8, 0x79, 0x52, 0x7e, 0x50, 0x77, 0x18,
+  0x71, 0x3c, 0xa5, 0xae, 0x45, 0xb4, 0x68, 0x4c, 0xeb, 0xfb, 0xb9, 0x84, 0x4b, 0x05, 0xdf, 0x63,
+  0xcd, 0x9b, 0xa8, 0xef, 0xf1, 0x72, 0xf3, 0x60, 0xf4, 0x33, 0x85, 0x71, 0x05, 0x00, 0x69, 0x44,
+  0x10, 0x48, 0x0f, 0x57, 0xc4, 0xb6, 0x1e, 0x00, 0x45, 0xba, 0xf1, 0x2a, 0x3a, 0xeb, 0xb4, 0x48,
+  0x96, 0xd6, 0x37, 0x3b, 0x00, 0xeb, 0x2c, 0xba, 0x07, 0xa2, 0x13, 0x29, 0x1f, 0x65, 0xb4, 0xfd,
+  0x77, 0x97, 0x26, 0xda, 0x2c, 0xec, 0xfa, 0x87, 0x7c, 0x2b, 0x9f, 0x13, 0x73, 0x7d, 0x00, 0x19,
+  0x1a, 0xad, 0xe9, 0xb9, 0x0c, 0x24, 0x49, 0xfc, 0x4c, 0x8d, 0x5c, 0x5f, 0xbf, 0x7b, 0xbd, 0x99,
+  0x29, 0x10, 0xe7, 0x18, 0x32, 0x59, 0x95, 0xde, 0x3e, 0x93, 0xf9, 0xbb, 0x2b, 0x76, 0xe1, 0xfb,
+  0xb0, 0xcb, 0xe8, 0x2d, 0x44, 0x90, 0xcd, 0x8c, 0x91, 0xd0, 0x4a, 0xb5, 0x96, 0x37, 0x4f, 0x00,
+  0x21, 0xa7, 0x31, 0x0f, 0xb7, 0x31, 0x44, 0x92, 0x06, 0x39, 0x54, 0xb6, 0xe6, 0xbf, 0x8a, 0x9e,
+  0x05, 0xcc, 0x4f, 0x4a, 0x67, 0x98, 0x0e, 0x6c, 0x06, 0xcb, 0xcc, 0x8e, 0x7a, 0x84, 0x4b, 0x33,
+  0xdb, 0xfd, 0xf0, 0xf7, 0xcf, 0x9f, 0x9f, 0x63, 0xbb, 0xaf, 0x52, 0x75, 0x2b, 0x9a, 0x85, 0xba,
+  0xd1, 0xef, 0x59, 0x76, 0x33, 0xa1, 0xfe, 0xcf, 0xf6, 0x28, 0x71, 0x6c, 0x66, 0xd1, 0x9c, 0xb1,
+  0x57, 0x8e, 0x79, 0x26, 0xf3, 0xab, 0x7c, 0x12, 0x4a, 0x3d, 0x13, 0xfe, 0x56, 0x7b, 0x21, 0x8a,
+  0x92, 0x14, 0x14, 0x2a, 0xdb, 0x49, 0xf8, 0x43, 0xa8, 0xb8, 0xaf, 0x57, 0xe8, 0x10, 0xab, 0x31,
+  0x05, 0x07, 0xb7, 0x32, 0x63, 0x95, 0x08, 0xf9, 0x25, 0x2b, 0x72, 0xbf, 0x62, 0xa7, 0xb6, 0xda,
+  0x34, 0xe5, 0x12, 0x18, 0xe3, 0xa6, 0x67, 0x3f, 0x8b, 0x79, 0xd9, 0x8f, 0x75, 0xc8, 0x47, 0xee,
+  0xc2, 0x6c, 0xa8, 0x2f, 0x8c, 0xa1, 0xc4, 0x9e, 0x51, 0x62, 0xdf, 0x32, 0xf5, 0x11, 0x83, 0x63,
+  0x49, 0xc0, 0x16, 0x6c, 0xab, 0xdf, 0x91, 0x8c, 0xc7, 0xad, 0x81, 0xb5, 0x4c, 0xd8, 0xef, 0x9d,
+  0x4d, 0x9f, 0xa5, 0xe2, 0xf7, 0x5c, 0xa6, 0xc2, 0x5f, 0x04, 0xba, 0xac, 0x00, 0xb4, 0x48, 0xfa,
+  0x6c, 0x26, 0xb0, 0xe8, 0x40, 0x33, 0x28, 0xc8, 0x9a, 0xaa, 0x28, 0xeb, 0x40, 0x0a, 0x1d, 0xe4,
+  0x21, 0xe3, 0x41, 0x06, 0xa9, 0x74, 0xc4, 0xe3, 0x9c, 0xc3, 0x0f, 0x1f, 0xab, 0x6d, 0x11, 0x76,
+  0x87, 0xa8, 0x68, 0xa6, 0x40, 0x80, 0xe9, 0x6e, 0x81, 0x9a, 0x2b, 0xbf, 0x29, 0x4c, 0xb4, 0x0c,
+  0xad, 0x71, 0x0b, 0x79, 0x5d, 0x95, 0x38, 0x00, 0xc0, 0x88, 0x66, 0x03, 0x84, 0x2f, 0x79, 0x28,
+  0x27, 0xb0, 0xa1, 0x0a, 0xf6, 0x38, 0x15, 0x78, 0x8c, 0xb4, 0x93, 0x97, 0xd4, 0x64, 0x3a, 0xac,
+  0x63, 0xf6, 0xa3, 0x26, 0x90, 0xbb, 0x19, 0x8e, 0x01, 0xdd, 0x6d, 0x41, 0x80, 0x01, 0xf7, 0xde,
+  0xb0, 0x01, 0xca, 0x17, 0x84, 0x98, 0xa9, 0x63, 0x9b, 0xf1, 0x58, 0x54, 0xf6, 0xca, 0x79, 0xa1,
+  0x06, 0x9c, 0xfc, 0x8f, 0x99, 0xc4, 0x94, 0xca, 0xd1, 0x80, 0x6d, 0x43, 0x68, 0x1f, 0x4f, 0x76,
+  0x13, 0x90, 0xeb, 0xb3, 0xac, 0x7a, 0x78, 0x4d, 0xfa, 0x44, 0x09, 0x16, 0xf4, 0x61, 0x9d, 0xd7,
+  0xd7, 0xc3, 0xe3, 0x57, 0xa3, 0x01, 0x7b, 0x0d, 0x16, 0xd8, 0x14, 0x58, 0xa2, 0xe1, 0xc0, 0x6a,
+  0x7e, 0x17, 0xb6, 0x4c, 0x66, 0x3c, 0x3c, 0xda, 0xc0, 0x80, 0x49, 0x1a, 0xa0, 0xc1, 0xc0, 0x62,
+  0x7d, 0x36, 0x79, 0xa0, 0xc6, 0x42, 0x30, 0x5c, 0x1a, 0x2c, 0x94, 0xb1, 0xe8, 0x15, 0x73, 0x9b,
+  0xe4, 0x9a, 0xcd, 0x65, 0x18, 0xb2, 0x09, 0x56, 0xfd, 0xed, 0xb1, 0x06, 0x44, 0xa5, 0x3e, 0x93,
+  0x51, 0x24, 0x7c, 0x09, 0x5a, 0x09, 0x1f, 0x7a, 0x5b, 0x20, 0x7f, 0x25, 0xe3, 0x67, 0xc2, 0x5e,
+  0xa5, 0x91, 0x2b, 0xd0, 0x77, 0x93, 0xc4, 0xaa, 0x33, 0xeb, 0x60, 0xa2, 0xd8, 0x18, 0x7e, 0x87,
+  0x88, 0xab, 0x05, 0xb7, 0x99, 0x94, 0xf1, 0xb2, 0x50, 0xc6, 0xa8, 0x81, 0x32, 0x5e, 0x52, 0xb2,
+  0xca, 0xc6, 0x6c, 0xd0, 0x3b, 0xb4, 0xa9, 0x3f, 0x03, 0x95, 0xbc, 0x3c, 0x60, 0x91, 0xde, 0x63,
+  0xc3, 0x51, 0xf5, 0x78, 0x70, 0x34, 0x72, 0x7b, 0xfc, 0xe5, 0x70, 0x00, 0x5d, 0x7a, 0x10, 0xa1,
+  0xc6, 0x77, 0x22, 0xd5, 0xc0, 0x5e, 0xd3, 0x09, 0x0e, 0x3c, 0x42, 0x3d, 0x56, 0x95, 0xc5, 0x6d,
+  0x54, 0xf2, 0xc9, 0xc1, 0x6b, 0x3b, 0xcd, 0x98, 0xac, 0x79, 0xd5, 0x62, 0xc0, 0x87, 0x10, 0xeb,
+  0x84, 0xb0, 0xeb, 0x7c, 0x82, 0x7f, 0x1d, 0x0d, 0xd8, 0x52, 0x75, 0x65, 0xf3, 0x55, 0xd7, 0x05,
+  0xd3, 0x77, 0x28, 0xec, 0x9c, 0xa9, 0xa4, 0x72, 0xc0, 0xb8, 0x18, 0xce, 0x3f, 0x63, 0x76, 0xdd,
+  0x09, 0xb0, 0x9e, 0xe9, 0x7a, 0x09, 0x70, 0xb9, 0xa6, 0xeb, 0xa3, 0x31, 0xc3, 0x32, 0x5f, 0x5e,
+  0xd9, 0x65, 0x54, 0x64, 0xb5, 0x4e, 0x8f, 0xbe, 0x11, 0x77, 0xcd, 0x14, 0x21, 0x99, 0x27, 0x28,
+  0xd8, 0xa7, 0x8f, 0x1f, 0x58, 0x67, 0x78, 0xc4, 0x66, 0xe2, 0x9e, 0xf9, 0x72, 0xba, 0xc6, 0xf0,
+  0xc8, 0x30, 0x1e, 0x23, 0x10, 0xd5, 0x02, 0x00, 0xad, 0x09, 0xcf, 0x60, 0xab, 0x01, 0xc3, 0xfb,
+  0x32, 0xe8, 0xbe, 0xbc, 0xe8, 0xbe, 0xe5, 0xdd, 0xe0, 0xb7, 0xaf, 0xc3, 0xa3, 0x6f, 0x0d, 0xac,
+  0x0f, 0x77, 0x56, 0x53, 0xa0, 0x60, 0x19, 0xbf, 0x35, 0x5e, 0x35, 0x90, 0x29, 0x38, 0xde, 0x20,
+  0x15, 0xb0, 0xcc, 0x01, 0x5f, 0x36, 0x9f, 0x09, 0x6b, 0x52, 0x00, 0x26, 0x78, 0x63, 0x2d, 0x78,
+  0xea, 0x41, 0x34, 0x70, 0x6a, 0x7c, 0x30, 0x22, 0x4d, 0x24, 0x98, 0x9f, 0xca, 0x3b, 0x24, 0x84,
+  0x34, 0x6c, 0x25, 0xd9, 0xc1, 0xbe, 0xc7, 0x2e, 0x20, 0xfc, 0x9c, 0xc6, 0xe0, 0x9d, 0x19, 0x27,
+  0x34, 0xb2, 0x19, 0xcf, 0xd8, 0x8c, 0x6b, 0xc6, 0x63, 0x05, 0x83, 0x52, 0xc3, 0x4e, 0xcf, 0x79,
+  0x62, 0x88, 0x40, 0xf4, 0x6e, 0x85, 0x6b, 0x62, 0xc2, 0x86, 0xba, 0xb1, 0xbb, 0x4d, 0x8c, 0xf6,
+  0x9a, 0xa6, 0xc3, 0x56, 0xda, 0xae, 0xcb, 0x72, 0x26, 0x7d, 0x5f, 0x3c, 0x5a, 0xfd, 0x1e, 0x8f,
+  0x5b, 0x8e, 0x1d, 0xad, 0x76, 0xbb, 0xc4, 0x08, 0x67, 0xa6, 0x2b, 0x8f, 0xca, 0xa7, 0x5c, 0xc6,
+  0x7b, 0x4c, 0xf4, 0xa6, 0x3d, 0x1b, 0x32, 0x14, 0x91, 0x1f, 0xe1, 0x44, 0xf3, 0xef, 0xb1, 0xcf,
+  0x15, 0xfc, 0x74, 0x54, 0x5b, 0xe8, 0xc0, 0x0e, 0x49, 0x45, 0x22, 0xc0, 0xfd, 0xfa, 0x2c, 0xe0,
+  0x32, 0x84, 0x0f, 0xbb, 0x0b, 0xea, 0x66, 0x4b, 0x9f, 0xc4, 0x7a, 0x95, 0xeb, 0x4d, 0x50, 0x7b,
+  0x2f, 0xf0, 0x28, 0x6e, 0x55, 0xde, 0xde, 0x08, 0x3a, 0xca, 0x67, 0x53, 0xe1, 0xa9, 0xd4, 0x6f,
+  0x02, 0xdf, 0x27, 0xea, 0x59, 0x1f, 0x79, 0x81, 0x0d, 0x81, 0xdb, 0x33, 0xcb, 0x9d, 0x2f, 0x46,
+  0x67, 0x0b, 0x16, 0x58, 0x84, 0x52, 0xc6, 0xbe, 0xbc, 0x90, 0xea, 0x63, 0x91, 0x22, 0xab, 0x55,
+  0x74, 0x80, 0x7d, 0x2b, 0x20, 0xb8, 0xc4, 0x65, 0x4c, 0xd6, 0x07, 0xee, 0x3c, 0xcf, 0xca, 0x83,
+  0x6e, 0xe4, 0x8f, 0x90, 0xe7, 0x99, 0x8a, 0x60, 0x9a, 0x10, 0x8b, 0xc0, 0x7e, 0x47, 0xaa, 0x71,
+  0xb2, 0x7b, 0x46, 0xe7, 0xee, 0x19, 0x2a, 0x03, 0x48, 0x22, 0x1b, 0x98, 0x49, 0xc6, 0x60, 0xe1,
+  0x1b, 0x02, 0x10, 0xcd, 0xc4, 0x1e, 0x2d, 0xb4, 0x07, 0x46, 0xf1, 0x36, 0x67, 0x29, 0x8f, 0xcd,
+  0x21, 0xbf, 0x23, 0x6b, 0x23, 0xd5, 0x59, 0x48, 0xde, 0xc5, 0x5d, 0x3a, 0xb9, 0xd9, 0x2a, 0x52,
+  0x04, 0x4f, 0xbf, 0xe4, 0xfb, 0xb7, 0x55, 0x24, 0x85, 0x78, 0x4f, 0xeb, 0xf1, 0xad, 0x4a, 0xa7,
+  0xc0, 0x11, 0xc0, 0x2b, 0x10, 0x59, 0xb4, 0xfe, 0x19, 0xa0, 0x81, 0xb6, 0x8f, 0xd0, 0xa1, 0x9f,
+  0x05, 0x98, 0x59, 0x96, 0xc2, 0x22, 0xe9, 0x2d, 0x48, 0x06, 0xa6, 0x1e, 0x86, 0x9a, 0xb6, 0xb9,
+  0x02, 0x68, 0x5f, 0x04, 0x3c, 0x0f, 0x33, 0x57, 0x1b, 0xcd, 0x50, 0x44, 0x04, 0xc8, 0xa0, 0x41,
+  0x69, 0x4e, 0xc1, 0x67, 0x13, 0x18, 0xa9, 0xa6, 0x72, 0x49, 0xf7, 0x1c, 0xf2, 0x94, 0xd7, 0x47,
+  0x22, 0x94, 0x83, 0x83, 0x97, 0x82, 0x3c, 0xca, 0x94, 0x60, 0x4c, 0x59, 0x63, 0xfd, 0x16, 0x50,
+  0x0d, 0xb2, 0x88, 0x3b, 0x0d, 0x10, 0x65, 0x84, 0x22, 0x9e, 0x66, 0xb3, 0x71, 0x6b, 0x7f, 0x31,
+  0xa6, 0x5e, 0xe6, 0x5a, 0x1c, 0x06, 0x5b, 0xce, 0x57, 0xf6, 0xe7, 0x0a, 0xee, 0x65, 0xef, 0x4a,
+  0x82, 0xaa, 0xc9, 0x91, 0xa2, 0x6a, 0x74, 0x24, 0x39, 0xda, 0x87, 0x1d, 0x29, 0xe4, 0x9e, 0x98,
+  0xa9, 0xd0, 0x17, 0x20, 0xc0, 0x1b, 0x3c, 0x92, 0x65, 0x31, 0xee, 0x34, 0xb6, 0x3f, 0xe6, 0x40,
+  0xa1, 0xe0, 0x77, 0x82, 0x81, 0xf5, 0x64, 0x0f, 0xab, 0x6c, 0x85, 0xe1, 0x71, 0x3f, 0xa6, 0xa5,
+  0x59, 0xaa, 0xe2, 0xe9, 0xf9, 0x3f, 0xe0, 0x97, 0x2d, 0x4f, 0x9a, 0x06, 0xf6, 0x9a, 0x2e, 0xda,
+  0x98, 0xa0, 0x14, 0xec, 0x2f, 0xe3, 0x69, 0x66, 0xad, 0x48, 0x73, 0xac, 0x4a, 0x32, 0x9a, 0x2c,
+  0x68, 0x17, 0x9d, 0x29, 0x2d, 0x71, 0xeb, 0x5b, 0x0b, 0x8b, 0x41, 0xa1, 0x6c, 0x95, 0xa8, 0x91,
+  0xab, 0x44, 0x91, 0x8d, 0xea, 0x2c, 0xcd, 0x4d, 0x4c, 0x84, 0x4a, 0x17, 0x4f, 0x98, 0x08, 0xe5,
+  0xdb, 0x58, 0x22, 0x29, 0x2a, 0x15, 0x0c, 0xab, 0x2c, 0x4f, 0x1a, 0x49, 0x35, 0xcc, 0xaa, 0xc7,
+  0x69, 0x58, 0xa7, 0x9a, 0xf7, 0x95, 0x12, 0x10, 0x12, 0x5f, 0x6a, 0x3e, 0x31, 0x11, 0xd5, 0xb2,
+  0x4c, 0x74, 0xd1, 0xa9, 0x90, 0xe9, 0x0a, 0x7e, 0x34, 0x08, 0x9a, 0xab, 0x81, 0xae, 0x54, 0xa6,
+  0x81, 0x02, 0xe5, 0xa1, 0x0d, 0x94, 0x8f, 0x0e, 0x0f, 0xf7, 0x0f, 0x57, 0xd9, 0xaf, 0x19, 0x94,
+  0x8a, 0x40, 0xde, 0x43, 0x5c, 0xa7, 0x12, 0xe9, 0xc1, 0xfe, 0x8c, 0xbf, 0x9a, 0xa1, 0x62, 0x47,
+  0x2e, 0x48, 0x60, 0x9b, 0x96, 0x90, 0x59, 0xc3, 0x9e, 0x6e, 0x15, 0x80, 0x11, 0x94, 0xd5, 0x14,
+  0xf0, 0xb9, 0xa6, 0x85, 0x75, 0xa2, 0x46, 0x09, 0xc4, 0x22, 0x19, 0x57, 0x9a, 0xaa, 0xd1, 0x60,
+  0x32, 0x28, 0x72, 0xb9, 0xfd, 0x23, 0xbc, 0xf7, 0x32, 0x68, 0x10, 0xc5, 0x5d, 0xa2, 0xcf, 0x04,
+  0xdf, 0x55, 0xec, 0x87, 0x7b, 0xcc, 0x54, 0xe5, 0x19, 0x96, 0x71, 0xe8, 0x06, 0xd8, 0x42, 0xaa,
+  0x8c, 0xbb, 0x59, 0x59, 0xd3, 0xc1, 0xbd, 0x53, 0xc5, 0x82, 0x6e, 0x66, 0x15, 0x65, 0x1d, 0x06,
+  0x5d, 0x59, 0x21, 0x17, 0x1a, 0xc6, 0x8b, 0x30, 0x3b, 0x35, 0xa8, 0xbd, 0x98, 0x66, 0xa7, 0x7d,
+  0x22, 0xdb, 0x78, 0xc1, 0x98, 0x92, 0xdd, 0x16, 0x0b, 0x06, 0x0f, 0x4d, 0x50, 0x12, 0xac, 0x37,
+  0x3f, 0xb5, 0x70, 0xb4, 0xe9, 0x6b, 0xab, 0xcd, 0x34, 0x12, 0x01, 0xb0, 0xa5, 0xea, 0x9a, 0xe4,
+  0x62, 0x61, 0x80, 0xd5, 0xc7, 0x22, 0x91, 0x9a, 0xb4, 0xe2, 0x6d, 0x0e, 0x9e, 0x86, 0xce, 0x72,
+  0x3a, 0xc3, 0xb5, 0xb9, 0xc4, 0x4f, 0x3c, 0x0c, 0x8a, 0x8e, 0xfd, 0xd1, 0xee, 0xba, 0x9c, 0xe2,
+  0xef, 0x39, 0xb8, 0x2d, 0xbc, 0x74, 0x61, 0x7b, 0x1f, 0xac, 0xee, 0xbd, 0xdf, 0x3a, 0x7f, 0x83,
+  0x57, 0x83, 0x66, 0x65, 0xe7, 0xe3, 0xd5, 0x9d, 0x0f, 0xb0, 0x5c, 0x7c, 0x9f, 0x09, 0xd8, 0xc8,
+  0xaa, 0xfe, 0xc3, 0xa3, 0xd5, 0x03, 0x0e, 0xdd, 0xf9, 0x8d, 0xba, 0x57, 0x10, 0x99, 0x8b, 0xda,
+  0x54, 0x67, 0x55, 0x78, 0x4b, 0xd8, 0x52, 0x78, 0x5b, 0xc0, 0x8f, 0x40, 0x52, 0x30, 0xf5, 0xa0,
+  0xf2, 0x14, 0x7e, 0x65, 0xf0, 0x95, 0xb2, 0x84, 0xb4, 0xc7, 0x7e, 0x82, 0x99, 0x50, 0xe8, 0x5a,
+  0x66, 0xe3, 0x63, 0xa6, 0x23, 0x65, 0x32, 0x81, 0x09, 0x58, 0x94, 0x0e, 0xd5, 0x1c, 0x2b, 0x68,
+  0x10, 0x9e, 0x45, 0x0d, 0xb7, 0x72, 0x4c, 0x63, 0x5d, 0xab, 0xd9, 0xc8, 0x3d, 0x2b, 0x12, 0x02,
+  0x62, 0x7f, 0xbc, 0x36, 0x59, 0xe3, 0x9a, 0xb1, 0x42, 0x98, 0x08, 0xac, 0x82, 0xe2, 0x09, 0xe3,
+  0x35, 0x7e, 0xb5, 0xc5, 0xc8, 0x7e, 0x33, 0x17, 0x50, 0x12, 0x28, 0x96, 0x7f, 0xd5, 0x50, 0xb8,
+  0xc3, 0xa5, 0x82, 0x24, 0x3e, 0xbc, 0x09, 0x25, 0x4d, 0xb1, 0xde, 0x3d, 0x71, 0xcf, 0x03, 0xdc,
+  0xcd, 0xaa, 0x80, 0x14, 0xd6, 0xf9, 0x55, 0xca, 0xf6, 0x42, 0xe7, 0xc9, 0xe8, 0xb4, 0x89, 0x84,
+  0x0b, 0xc4, 0xac, 0x90, 0x8b, 0x6d, 0xf5, 0x72, 0xba, 0x7d, 0x6a, 0xc4, 0xad, 0xb7, 0x97, 0x0f,
+  0x14, 0x76, 0xa7, 0x3c, 0x4a, 0x58, 0x9e, 0x14, 0x1b, 0x32, 0x50, 0x63, 0x34, 0x6b, 0x72, 0x5a,
+  0x93, 0x14, 0x73, 0x52, 0x7b, 0x25, 0x95, 0x32, 0x42, 0x8e, 0xb1, 0x63, 0x8f, 0xbd, 0x27, 0xcb,
+  0xc0, 0x16, 0x7b, 0x13, 0x55, 0x06, 0x66, 0x38, 0x59, 0x58, 0xa8, 0x34, 0x34, 0xd1, 0xec, 0x9b,
+  0x1a, 0xcd, 0xa2, 0xf2, 0x37, 0x31, 0x9b, 0x57, 0x10, 0x80, 0xe2, 0xbd, 0xdb, 0xba, 0xb0, 0xd9,
+  0xd1, 0xd3, 0xc4, 0x76, 0xb3, 0xbe, 0x65, 0xb5, 0x5f, 0x5a, 0xec, 0x68, 0x95, 0xb0, 0x34, 0xba,
+  0xc6, 0x33, 0x7d, 0x0c, 0x82, 0x75, 0xfe, 0xe8, 0x23, 0x96, 0x88, 0x66, 0xb0, 0xb8, 0x08, 0xd7,
+  0x54, 0xc0, 0x3e, 0x10, 0xaf, 0x73, 0x4a, 0x6f, 0xe5, 0x3d, 0xe8, 0xc0, 0xd6, 0x5d, 0xe1, 0x49,
+  0x8a, 0x17, 0x82, 0x35, 0x0f, 0x9f, 0x2a, 0x7d, 0x94, 0x82, 0x12, 0xfa, 0xad, 0x0a, 0x9d, 0xe6,
+  0x55, 0xfb, 0x25, 0x12, 0xcb, 0x08, 0xd8, 0xd6, 0xfa, 0x0a, 0xfe, 0x72, 0xaf, 0xfa, 0x35, 0x53,
+  0xf6, 0xe2, 0x09, 0xa4, 0xd7, 0xdc, 0x9b, 0xe1, 0x7c, 0x63, 0xd8, 0xe9, 0x2e, 0xec, 0xef, 0x27,
+  0x34, 0x53, 0x0e, 0x5b, 0x96, 0xad, 0xa2, 0x57, 0xa7, 0x82, 0x3c, 0x83, 0x78, 0x16, 0x5c, 0x86,
+  0x8c, 0x3d, 0xc8, 0xcf, 0x35, 0xfa, 0xc7, 0x62, 0xc3, 0x5e, 0xed, 0x94, 0xbb, 0x30, 0xf2, 0x5d,
+  0x6c, 0x06, 0xfa, 0x62, 0xed, 0xc0, 0xa7, 0x1c, 0x74, 0x9d, 0x0d, 0x9c, 0xd8, 0xec, 0x97, 0xaa,
+  0x10, 0x3a, 0xb3, 0xf5, 0x1f, 0xc4, 0xa2, 0x98, 0x0b, 0x9b, 0x2a, 0x8c, 0xdb, 0x33, 0x67, 0xfd,
+  0x15, 0xa5, 0xe2, 0x62, 0xde, 0x44, 0x0f, 0x92, 0x40, 0xd3, 0xb2, 0xc7, 0xb4, 0xb2, 0xf7, 0xc7,
+  0x91, 0x36, 0x13, 0x31, 0xe4, 0xbc, 0x74, 0x41, 0x9c, 0xb6, 0x06, 0x40, 0x8c, 0x41, 0xf2, 0x02,
+  0xc9, 0xb8, 0x6b, 0x63, 0x27, 0x36, 0x6e, 0xe7, 0x10, 0x83, 0xa6, 0xf6, 0x16, 0x2f, 0x65, 0x82,
+  0xc2, 0x59, 0xd7, 0x28, 0xb0, 0x5e, 0xe4, 0x0c, 0x13, 0x4b, 0xb9, 0xeb, 0x21, 0xca, 0x92, 0x00,
+  0x65, 0x03, 0x1a, 0xc4, 0xca, 0x63, 0x0c, 0x3c, 0x9a, 0x3a, 0x82, 0xda, 0xe5, 0xbc, 0x4d, 0xd0,
+  0x82, 0x55, 0xfe, 0x27, 0x62, 0x16, 0xd8, 0x22, 0x41, 0xbb, 0xd8, 0x71, 0xc8, 0x3a, 0x58, 0x8c,
+  0x6f, 0x74, 0xa8, 0x85, 0x83, 0x8a, 0x03, 0x2d, 0xfa, 0xbe, 0xee, 0x00, 0x60, 0x91, 0xdb, 0xc8,
+  0x70, 0x1b, 0x6d, 0xc4, 0x6d, 0xe4, 0x70, 0x1b, 0x6d, 0xc2, 0x6d, 0xdf, 0x70, 0xdb, 0xdf, 0x88,
+  0xdb, 0xbe, 0xc3, 0x6d, 0x7f, 0x13, 0x6e, 0x07, 0x86, 0xdb, 0xc1, 0x46, 0xdc, 0x0e, 0x1c, 0x6e,
+  0x07, 0x9b, 0x1f, 0xa5, 0x3c, 0x99, 0xa0, 0x5e, 0x16, 0xc5, 0x0c, 0xa0, 0x6f, 0x0f, 0x4f, 0x9c,
+  0xb3, 0x12, 0xaa, 0x7f, 0x18, 0x0b, 0x31, 0x87, 0x31, 0x3d, 0xf6, 0x2b, 0xbe, 0xed, 0xf0, 0x60,
+  0xed, 0xbd, 0x3a, 0x02, 0xd6, 0x3f, 0x6c, 0x18, 0xfc, 0x00, 0x14, 0x8b, 0xa1, 0x76, 0xc2, 0xe8,
+  0x3a, 0xb0, 0x49, 0x8f, 0xba, 0x3c, 0x94, 0x53, 0x58, 0xfb, 0x9e, 0x30, 0xb7, 0xa5, 0x8b, 0xab,
+  0xc7, 0xc7, 0xc7, 0xc7, 0xa7, 0x35, 0xf7, 0x9b, 0xdd, 0x2b, 0xcd, 0xfb, 0x78, 0x99, 0x1a, 0x29,
+  0x73, 0x36, 0x83, 0x84, 0x60, 0xdc, 0xea, 0x47, 0x3c, 0xe6, 0x53, 0x8a, 0xd0, 0xfa, 0x77, 0xc3,
+  0xbe, 0x2f, 0xb4, 0x97, 0xca, 0xc4, 0x44, 0x0b, 0x96, 0xe5, 0xf2, 0x8d, 0x6f, 0x12, 0xc1, 0xc7,
+  0xda, 0x8f, 0xb9, 0xe4, 0x63, 0xee, 0x42, 0x9b, 0xcd, 0x02, 0x03, 0x81, 0x0f, 0x25, 0x45, 0x76,
+  0x71, 0xf5, 0xee, 0xac, 0xcf, 0x71, 0x22, 0x49, 0x79, 0xbc, 0x7c, 0x66, 0x38, 0x9c, 0xef, 0xdc,
+  0x71, 0xc2, 0x08, 0x00, 0xfc, 0x25, 0x0d, 0x21, 0x7a, 0x0c, 0x95, 0x47, 0x04, 0x7b, 0x09, 0xcf,
+  0x66, 0xa8, 0xd7, 0x5e, 0x2a, 0x28, 0xdd, 0xed, 0xf4, 0xff, 0xd5, 0xff, 0x53, 0x7f, 0x8f, 0xb5,
+  0xdb, 0xbb, 0xec, 0xcf, 0xac, 0x6d, 0xdf, 0x47, 0x69, 0x9f, 0xee, 0xec, 0x04, 0x79, 0x6c, 0x9c,
+  0x0d, 0x38, 0xc6, 0x79, 0xc7, 0xb4, 0xef, 0xe1, 0x7b, 0x33, 0xe1, 0x5b, 0x00, 0x4e, 0xef, 0xb2,
+  0xaf, 0x3b, 0x8c, 0xf9, 0xca, 0xcb, 0x29, 0x02, 0xfd, 0x3d, 0x07, 0xaf, 0x66, 0xe2, 0x5c, 0x95,
+  0x5e, 0x84, 0x61, 0xa7, 0xfd, 0xc5, 0x39, 0x2d, 0xff, 0xad, 0xbd, 0x8b, 0xaf, 0x21, 0xbc, 0x01,
+  0xa7, 0xd9, 0x29, 0xe9, 0x76, 0x44, 0x68, 0x88, 0x30, 0x86, 0xe2, 0x9a, 0x23, 0xe2, 0xb1, 0x15,
+  0xfb, 0x8b, 0x08, 0x7b, 0x48, 0x00, 0x1c, 0x60, 0xcf, 0xd2, 0x38, 0xa5, 0xae, 0x10, 0xce, 0x74,
+  0x50, 0xc7, 0x2a, 0x28, 0x46, 0x8c, 0xc7, 0xac, 0x3d, 0x51, 0x2a, 0x14, 0x3c, 0x6e, 0x17, 0x04,
+  0x59, 0x49, 0xce, 0x7c, 0xfe, 0x95, 0xb5, 0xff, 0x29, 0x74, 0x9b, 0x9d, 0xb0, 0xf6, 0xcf, 0xaa,
+  0x6d, 0x28, 0x7d, 0x63, 0x22, 0xd4, 0x82, 0x08, 0x3a, 0xcc, 0x8a, 0xbb, 0x47, 0xec, 0xc5, 0x0b,
+  0xf6, 0x98, 0x8f, 0x7d, 0xc7, 0x60, 0x05, 0x9b, 0x5e, 0xa6, 0xc8, 0x73, 0x77, 0xfe, 0x5c, 0x43,
+  0x70, 0xd7, 0x72, 0xa5, 0x7f, 0xe1, 0x39, 0xaa, 0xfa, 0xd2, 0xbc, 0x5f, 0x52, 0x8a, 0x89, 0x3c,
+  0xf2, 0xd8, 0x87, 0x6c, 0x12, 0xeb, 0x6d, 0x20, 0x34, 0x4a, 0x4c, 0x8f, 0x70, 0xf0, 0x37, 0x22,
+  0x81, 0x58, 0xd9, 0x22, 0xf9, 0xb8, 0xc2, 0x1f, 0xf6, 0x9e, 0x37, 0x21, 0x19, 0xc6, 0xab, 0x87,
+  0x77, 0x7e, 0xa7, 0x6d, 0x7a, 0xb4, 0x69, 0x84, 0xf9, 0xbe, 0xc4, 0xd0, 0xc0, 0xdc, 0x33, 0xcf,
+  0x6e, 0x80, 0x87, 0x24, 0x86, 0xbf, 0xe2, 0x17, 0xc2, 0xe9, 0x5d, 0x4c, 0x8d, 0x6d, 0x87, 0x02,
+  0x2d, 0xf2, 0x9f, 0x71, 0x9b, 0x02, 0x28, 0x9c, 0x37, 0x58, 0xda, 0x60, 0x3a, 0x9d, 0x15, 0x04,
+  0xd5, 0x2d, 0x51, 0x9b, 0x70, 0xbf, 0x5d, 0x8a, 0x4f, 0xb9, 0xcf, 0x1a, 0xe1, 0xcb, 0xcb, 0x51,
+  0x66, 0x08, 0x7e, 0xab, 0x97, 0x9e, 0x3a, 0xf2, 0x04, 0xf9, 0x60, 0x7c, 0xaf, 0xb1, 0xce, 0x0b,
+  0xc9, 0x39, 0xeb, 0xbc, 0xe5, 0x61, 0x88, 0x3b, 0xe1, 0x2e, 0x31, 0xc7, 0x4b, 0x31, 0x64, 0x71,
+  0xf6, 0xb6, 0x89, 0xf0, 0x77, 0xdb, 0x25, 0xe1, 0x26, 0x93, 0x72, 0xf8, 0xa0, 0x5f, 0x23, 0xa2,
+  0x30, 0x31, 0x92, 0x6e, 0xe5, 0x2c, 0x8a, 0x4b, 0x4b, 0x60, 0xfb, 0xb4, 0xda, 0x7b, 0xf6, 0x05,
+  0x87, 0x5a, 0xf1, 0x71, 0x9d, 0x13, 0xd9, 0xf6, 0x5a, 0x9a, 0x8b, 0x97, 0xdd, 0x80, 0xf2, 0x02,
+  0x2c, 0x64, 0x5a, 0x96, 0x76, 0xd9, 0xd3, 0x56, 0xdc, 0x81, 0x47, 0x68, 0xeb, 0xb8, 0x14, 0x71,
+  0xe0, 0xf4, 0x96, 0xbb, 0x42, 0x04, 0x92, 0x84, 0x10, 0xf2, 0x80, 0x23, 0x28, 0x0a, 0xd0, 0x24,
+  0x93, 0xad, 0x1e, 0xef, 0x35, 0x1e, 0x84, 0x73, 0xf8, 0xd2, 0xc6, 0xf3, 0xaf, 0x36, 0x0c, 0xb2,
+  0xd7, 0x66, 0xf1, 0xab, 0xb9, 0xc5, 0xda, 0xfe, 0xad, 0xc6, 0x1b, 0xe0, 0x09, 0x97, 0xeb, 0x0f,
+  0x50, 0xc8, 0xd2, 0x1b, 0xd0, 0xc4, 0x6f, 0x90, 0x3d, 0x1d, 0x84, 0x01, 0x2f, 0x3c, 0xdf, 0x6b,
+  0x5b, 0x9f, 0x50, 0xe3, 0x3e, 0x16, 0x07, 0x38, 0xfd, 0x68, 0x73, 0x1a, 0x13, 0xf5, 0xff, 0xfc,
+  0xc7, 0xe2, 0x5e, 0x79, 0x16, 0xa2, 0xfe, 0x03, 0xae, 0x74, 0x12, 0x1e, 0x9d, 0x00, 0xf4, 0xac,
+  0x96, 0xbb, 0x1d, 0xdd, 0x31, 0xdc, 0xce, 0x59, 0x77, 0x38, 0xfa, 0x0b, 0x40, 0xbb, 0xb8, 0xfa,
+  0x47, 0xe4, 0x4a, 0xd9, 0xbf, 0xf2, 0xc1, 0x60, 0x32, 0xb8, 0x24, 0x04, 0x63, 0x55, 0x1c, 0x3c,
+  0x19, 0x3f, 0xcb, 0x3a, 0x46, 0xb4, 0x08, 0x7f, 0xec, 0xb6, 0x5d, 0xd7, 0xb0, 0x56, 0xf7, 0x2e,
+  0x04, 0x46, 0xd8, 0x71, 0x25, 0xec, 0x5f, 0x2d, 0x2a, 0x64, 0x46, 0xbb, 0x4b, 0xb6, 0x41, 0xa2,
+  0x57, 0x5e, 0x64, 0x25, 0x17, 0xe7, 0x6a, 0xd7, 0x3a, 0xf3, 0x2a, 0xab, 0xa8, 0xc0, 0xf5, 0x51,
+  0x13, 0xcc, 0xe9, 0xc4, 0x31, 0x95, 0xb2, 0xb6, 0x89, 0x82, 0xbd, 0x36, 0x85, 0x54, 0xbf, 0xfd,
+  0xb4, 0x14, 0xd5, 0x26, 0xdf, 0x54, 0x92, 0x8e, 0xdb, 0xe6, 0x15, 0x8b, 0x1d, 0x81, 0x29, 0x57,
+  0x7e, 0xdb, 0x0a, 0x51, 0x3e, 0x05, 0x85, 0x40, 0x4b, 0x17, 0xb7, 0xbc, 0x06, 0xfb, 0x19, 0xc4,
+  0x3f, 0x4f, 0x6d, 0x66, 0xe0, 0xdb, 0x31, 0x57, 0xaf, 0xdb, 0xc9, 0x70, 0x74, 0xa5, 0x03, 0x34,
+  0xb8, 0xa5, 0xfd, 0x74, 0xad, 0x04, 0x14, 0x5e, 0x7f, 0xc1, 0xdd, 0xfb, 0x29, 0x11, 0x58, 0xb1,
+  0xab, 0x61, 0x67, 0x3c, 0xff, 0xb3, 0xaf, 0x99, 0x82, 0x39, 0xe3, 0xce, 0x03, 0xdb, 0x9a, 0x31,
+  0xf2, 0xf2, 0x45, 0xb8, 0x6a, 0x20, 0xc9, 0xff, 0x78, 0x2f, 0x26, 0xae, 0xa7, 0xb6, 0x8f, 0x31,
+  0x54, 0x33, 0x89, 0x6f, 0x3b, 0xdf, 0x9c, 0x58, 0x01, 0x4b, 0xa4, 0xcb, 0x73, 0x32, 0xe9, 0x14,
+  0x0b, 0x44, 0x06, 0xd2, 0x96, 0x41, 0x09, 0x68, 0x74, 0x26, 0x62, 0x77, 0xfd, 0x43, 0xef, 0xa2,
+  0x6f, 0xda, 0xfb, 0xb7, 0x56, 0x71, 0x07, 0xdf, 0x05, 0x7d, 0xd4, 0xcf, 0x50, 0x28, 0x04, 0x5e,
+  0x11, 0x9c, 0x14, 0x20, 0xbb, 0xb2, 0x41, 0xc4, 0x03, 0x36, 0xd8, 0x49, 0x85, 0x06, 0x5f, 0x66,
+  0xc6, 0xa3, 0x43, 0x98, 0xa8, 0xfb, 0x75, 0x7b, 0x51, 0xf1, 0xe6, 0x96, 0x71, 0xf6, 0xd0, 0xb9,
+  0x27, 0xc1, 0x70, 0xd2, 0x9f, 0x3e, 0x7f, 0x78, 0x8f, 0x1b, 0x06, 0x99, 0xb1, 0x21, 0xd9, 0x2b,
+  0xba, 0xd6, 0xa8, 0x06, 0xad, 0xd7, 0x75, 0x6e, 0x78, 0x7b, 0xc8, 0xe5, 0x8a, 0xd9, 0x6b, 0x26,
+  0x2c, 0xe3, 0x4e, 0x1b, 0x82, 0xb9, 0xb6, 0x8d, 0x17, 0xe8, 0x9e, 0x51, 0xfd, 0x4a, 0x36, 0xe2,
+  0x40, 0x36, 0x0a, 0x79, 0xe4, 0xe5, 0x4c, 0x86, 0x7e, 0x07, 0x3b, 0xef, 0x56, 0x06, 0x86, 0x8f,
+  0xdd, 0xed, 0xcd, 0xca, 0xa9, 0x6e, 0x97, 0x36, 0xe6, 0xa2, 0xef, 0xf2, 0x36, 0xd5, 0xa6, 0x17,
+  0x32, 0xdb, 0x04, 0xe3, 0x13, 0x76, 0x59, 0x6b, 0x90, 0xf8, 0xc0, 0xcc, 0x1a, 0xbf, 0xf5, 0xb8,
+  0xef, 0xbf, 0xb9, 0x03, 0x12, 0xef, 0xa5, 0x86, 0x99, 0x88, 0xb4, 0x53, 0xbc, 0x6b, 0x08, 0x9a,
+  0xab, 0x8c, 0x18, 0x7b, 0x94, 0x4b, 0x09, 0x7f, 0xf4, 0x92, 0x94, 0x3e, 0x5f, 0x9b, 0x5d, 0xa8,
+  0x63, 0x81, 0x59, 0xb2, 0xa7, 0x3d, 0x7c, 0x7b, 0x59, 0x64, 0x33, 0xe5, 0xc3, 0xa4, 0xae, 0x3e,
+  0x5e, 0x7f, 0x06, 0xaa, 0xf8, 0x5a, 0xdf, 0x09, 0x9d, 0x64, 0xfd, 0xf2, 0xe9, 0xbd, 0x39, 0xcc,
+  0xbf, 0xe2, 0x29, 0x8f, 0x74, 0x07, 0xdb, 0xd0, 0x52, 0xf0, 0x8e, 0x99, 0x11, 0x73, 0x17, 0x30,
+  0xb3, 0xe6, 0xdd, 0xd4, 0x32, 0x57, 0x75, 0x77, 0x0c, 0xcc, 0xfc, 0xb7, 0x68, 0x79, 0xa7, 0x4e,
+  0x3b, 0xd1, 0xa4, 0x45, 0x93, 0xa5, 0xb9, 0x28, 0x1f, 0x55, 0xb4, 0x21, 0x6c, 0x5f, 0x80, 0xd4,
+  0x88, 0x42, 0xe4, 0xbe, 0x32, 0x75, 0x7b, 0x82, 0x67, 0xbd, 0x5a, 0xec, 0xb1, 0xc2, 0xf6, 0x4e,
+  0x60, 0xdf, 0xfd, 0x04, 0xa9, 0x99, 0xc0, 0x7b, 0x2a, 0x74, 0xe3, 0xa1, 0xfd, 0x1b, 0x5a, 0x43,
+  0xb1, 0x5a, 0x71, 0x4d, 0xc0, 0xdf, 0x1d, 0x97, 0x27, 0x78, 0xa6, 0xe2, 0xcc, 0x66, 0x89, 0x93,
+  0x59, 0xce, 0xc8, 0x01, 0x29, 0xec, 0xb1, 0xc3, 0xc1, 0x60, 0x00, 0x03, 0x20, 0x8b, 0xb3, 0x79,
+  0xc6, 0x59, 0xdf, 0xbe, 0x3a, 0xd9, 0x37, 0xff, 0x8b, 0x80, 0xff, 0x03, 0xed, 0x21, 0x83, 0x30,
+  0x3a, 0x40, 0x00, 0x00,
+};
+
+static const AlpacaSetupAsset ARDUINO_FOCUSER_SETUP_PAGE = {ARDUINO_FOCUSER_SETUP_PAGE_GZ, sizeof(ARDUINO_FOCUSER_SETUP_PAGE_GZ), "text/html", "\"1033d7fce91a88be\""};
+
+#endif // ARDUINO_FOCUSER_SETUP_PAGE_H
@@ -0,0 +1,277 @@
+#ifndef ARDUINO_FOCUSER_TEMPBUS_H
+#define ARDUINO_FOCUSER_TEMPBUS_H
+
+#include <Arduino.h>
+#include <OneWire.h>
+#include <DallasTemperature.h>
+#include "Persistent_Store.h"
+#include "Log_Filter.h"
+
+/**
+ * @file ArduinoFocuser_TempBus.h
+ * @brief DS18B20 probes on the focuser's 1-Wire bus
+ *
+ * The bus is searched once at start and the ROM addresses are kept, so a
+ * reading costs one addressed scratchpad read instead of a bus search per
+ * sample (getTempCByIndex() searches the whole bus on every call).
+ *
+ * Up to TEMP_PROBE_COUNT probes are used, each in a role: the tube probe
+ * drives the focuser temperature and compensation, ambient and mirror are
+ * reported alongside. The ROM of each role is persisted, so roles survive a
+ * restart and a probe being unplugged; a probe found on the bus that no role
+ * knows takes the first role without a probe present.
+ *
+ * One skip-ROM conversion command starts all probes at once. The bus is
+ * searched again only after TEMP_BUS_MAX_FAILURES bad readings in a row
+ * from a probe, or every TEMP_BUS_RESCAN_MS while no probe is present.
+ */
+
+#ifndef TEMP_BUS_MAX_FAILURES
+#define TEMP_BUS_MAX_FAILURES 3
+#endif
+
+#ifndef TEMP_BUS_RESCAN_MS
+#define TEMP_BUS_RESCAN_MS 30000
+#endif
+
+enum eTEMPPROBE {
+  ProbeTube = 0,
+  ProbeAmbient = 1,
+  ProbeMirror = 2,
+  TEMP_PROBE_COUNT
+};
+
+class TemperatureBus
+{
+private:
+  struct Probe {
+    DeviceAddress rom;  // assigned ROM, all zero if none
+    bool present;       // found at the last search
+    bool valid;         // last reading valid
+    uint8_t failures;   // bad readings in a row
+    float raw;          // last reading, DEVICE_DISCONNECTED_C if none
+  };
+
+  OneWire Wire;
+  DallasTemperature Sensors;
+  Probe Probes[TEMP_PROBE_COUNT];
+  uint8_t Resolution = 10;
+  uint8_t Found = 0;         // DS18B20s on the bus at the last search
+  bool RescanDue = false;
+  unsigned long LastScan = 0;
+  uint32_t Scans = 0;
+
+  static bool assigned(const uint8_t *rom) {
+    for (uint8_t i = 0; i < 8; i++) {
+      if (rom[i] != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void save() const {
+    uint8_t roms[TEMP_PROBE_COUNT][8];
+    for (uint8_t role = 0; role < TEMP_PROBE_COUNT; role++) {
+      memcpy(roms[role], Probes[role].rom, 8);
+    }
+    persistentStore.put(STORE_KEY_FOCUSER_TEMP_PROBES, roms, sizeof(roms));
+  }
+
+  void load() {
+    uint8_t roms[TEMP_PROBE_COUNT][8];
+    if (!persistentStore.get(STORE_KEY_FOCUSER_TEMP_PROBES, roms, sizeof(roms))) {
+      memset(roms, 0, sizeof(roms));
+    }
+    for (uint8_t role = 0; role < TEMP_PROBE_COUNT; role++) {
+      memcpy(Probes[role].rom, roms[role], 8);
+    }
+  }
+
+  /**
+   * @brief Search the bus and match the probes found to the roles
+   */
+  void scan() {
+    RescanDue = false;
+    LastScan = millis();
+    Scans++;
+    Sensors.begin();
+
+    DeviceAddress roms[TEMP_PROBE_COUNT];
+    bool claimed[TEMP_PROBE_COUNT] = {};
+    uint8_t count = Sensors.getDeviceCount();
+    Found = 0;
+    for (uint8_t i = 0; i < count && Found < TEMP_PROBE_COUNT; i++) {
+      if (Sensors.getAddress(roms[Found], i)) {
+        Found++;
+      }
+    }
+
+    // Roles keep their probe if it is still there...
+    for (uint8_t role = 0; role < TEMP_PROBE_COUNT; role++) {
+      Probe &probe = Probes[role];
+      probe.present = false;
+      probe.valid = false;
+      probe.failures = 0;
+      probe.raw = DEVICE_DISCONNECTED_C;
+      for (uint8_t i = 0; i < Found && assigned(probe.rom); i++) {
+        if (!claimed[i] && memcmp(probe.rom, roms[i], 8) == 0) {
+          claimed[i] = true;
+          probe.present = true;
+          break;
+        }
+      }
+    }
+    // ...and new probes take the roles left without one
+    bool changed = false;
+    for (uint8_t role = 0, i = 0; role < TEMP_PROBE_COUNT; role++) {
+      Probe &probe = Probes[role];
+      while (!probe.present && i < Found) {
+        if (!claimed[i]) {
+          claimed[i] = true;
+          memcpy(probe.rom, roms[i], 8);
+          probe.present = true;
+          changed = true;
+          LOG_INFO("DS18B20 " + romString(role) + " assigned to the " + roleName(role) + " probe");
+        }
+        i++;
+      }
+    }
+    if (changed) {
+      save();
+    }
+
+    for (uint8_t role = 0; role < TEMP_PROBE_COUNT; role++) {
+      if (Probes[role].present) {
+        Sensors.setResolution(Probes[role].rom, Resolution, true);
+      }
+    }
+    LOG_INFO("Found " + String(Found) + " DS18B20 on GPIO " + String(Wire.pin()));
+  }
+
+public:
+  /**
+   * @brief Attach to the bus on @p pin and search it
+   */
+  void begin(uint8_t pin, uint8_t resolution) {
+    Wire = OneWire(pin);
+    Sensors = DallasTemperature(&Wire);
+    Sensors.setWaitForConversion(false);
+    Resolution = resolution;
+    load();
+    scan();
+  }
+
+  void setResolution(uint8_t bits) {
+    Resolution = bits;
+    for (uint8_t role = 0; role < TEMP_PROBE_COUNT; role++) {
+      if (Probes[role].present) {
+        Sensors.setResolution(Probes[role].rom, Resolution, true);
+      }
+    }
+  }
+
+  /**
+   * @brief Search the bus again before the next conversion
+   */
+  void rescan() { RescanDue = true; }
+
+  /**
+   * @brief Start a conversion on all probes, searching the bus first if due
+   * @return false if no probe is present
+   */
+  bool request() {
+    if (RescanDue || (Found == 0 && millis() - LastScan >= TEMP_BUS_RESCAN_MS)) {
+      scan();
+    }
+    if (Found == 0) {
+      return false;
+    }
+    Sensors.requestTemperatures();
+    return true;
+  }
+
+  bool conversionComplete() { return Sensors.isConversionComplete(); }
+  unsigned long conversionMillis() { return Sensors.millisToWaitForConversion(Resolution); }
+
+  /**
+   * @brief Read the converted temperature of every present probe by ROM
+   */
+  void read() {
+    for (uint8_t role = 0; role < TEMP_PROBE_COUNT; role++) {
+      Probe &probe = Probes[role];
+      if (!probe.present) {
+        continue;
+      }
+      probe.raw = Sensors.getTempC(probe.rom);
+      // DS18B20 invalid values: disconnected (-127), power-up default (85)
+      probe.valid = !(probe.raw == DEVICE_DISCONNECTED_C || probe.raw == 85.0f || isnan(probe.raw) ||
+                      probe.raw < -55.0f || probe.raw > 125.0f);
+      if (probe.valid) {
+        probe.failures = 0;
+      } else if (++probe.failures >= TEMP_BUS_MAX_FAILURES) {
+        LOG_WARN("No valid reading from the " + String(roleName(role)) + " probe, searching the bus again");
+        RescanDue = true;
+      }
+    }
+  }
+
+  /**
+   * @brief Move the probe with ROM @p rom (16 hex digits) to @p role, persisted
+   * A probe in that role before swaps with it.
+   * @return false if @p role or @p rom is invalid
+   */
+  bool assign(int role, const String &rom) {
+    DeviceAddress address;
+    if (role < 0 || role >= TEMP_PROBE_COUNT || rom.length() != 16) {
+      return false;
+    }
+    for (uint8_t i = 0; i < 8; i++) {
+      char digits[3] = {rom[2 * i], rom[2 * i + 1], 0};
+      char *end;
+      address[i] = (uint8_t)strtoul(digits, &end, 16);
+      if (end != digits + 2) {
+        return false;
+      }
+    }
+    if (OneWire::crc8(address, 7) != address[7]) {
+      return false;
+    }
+    for (uint8_t other = 0; other < TEMP_PROBE_COUNT; other++) {
+      if (memcmp(Probes[other].rom, address, 8) == 0) {
+        memcpy(Probes[other].rom, Probes[role].rom, 8);
+      }
+    }
+    memcpy(Probes[role].rom, address, 8);
+    save();
+    scan();
+    return true;
+  }
+
+  uint8_t deviceCount() const { return Found; }
+  uint32_t scanCount() const { return Scans; }
+  bool present(uint8_t role) const { return Probes[role].present; }
+  bool valid(uint8_t role) const { return Probes[role].present && Probes[role].valid; }
+  float raw(uint8_t role) const { return Probes[role].raw; }
+
+  /**
+   * @brief ROM of the probe in @p role as 16 hex digits, empty if none
+   */
+  String romString(uint8_t role) const {
+    if (!assigned(Probes[role].rom)) {
+      return String();
+    }
+    char text[17];
+    for (uint8_t i = 0; i < 8; i++) {
+      snprintf(text + 2 * i, 3, "%02X", Probes[role].rom[i]);
+    }
+    return String(text);
+  }
+
+  static const char *roleName(uint8_t role) {
+    static const char *const names[TEMP_PROBE_COUNT] = {"tube", "ambient", "mirror"};
+    return role < TEMP_PROBE_COUNT ? names[role] : "";
+  }
+};
+
+#endif /* ARDUINO_FOCUSER_TEMPBUS_H */
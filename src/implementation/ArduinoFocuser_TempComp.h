@@ -0,0 +1,231 @@
+#ifndef ARDUINO_FOCUSER_TEMPCOMP_H
+#define ARDUINO_FOCUSER_TEMPCOMP_H
+
+#include <Arduino.h>
+#include "Persistent_Store.h"
+#include "Log_Filter.h"
+
+/**
+ * @file ArduinoFocuser_TempComp.h
+ * @brief Learned temperature compensation for ArduinoFocuser
+ *
+ * The model keeps the last TEMPCOMP_SAMPLES (temperature, in-focus position)
+ * pairs in a ring buffer and fits position = a + coefficient * temperature
+ * by least squares. The sums are updated incrementally: a new sample is
+ * added and the one it replaces is subtracted, so a fit costs no pass over
+ * the buffer. The samples are persisted, so learning survives a restart.
+ *
+ * Until TEMPCOMP_MIN_SAMPLES samples with a temperature standard deviation
+ * of at least TEMPCOMP_MIN_STDDEV_C are collected,
+ * TEMPCOMP_DEFAULT_STEPS_PER_C is used.
+ *
+ * Corrections are relative to a reference (temperature, position), set
+ * when the client last moved the focuser: the target is
+ * reference position + coefficient * (temperature - reference temperature).
+ * The target stays within TEMPCOMP_MAX_CORRECTION_STEPS of the reference
+ * position, so neither a sensor glitch nor a slow drift can walk the focus
+ * far off, and a move is only due once the target differs from the current
+ * position by more than TEMPCOMP_DEADBAND_STEPS.
+ *
+ * The focuser has no way to know that the image is in focus, so it takes a
+ * position that a client Move() reached and that was then left alone for
+ * TEMPCOMP_FOCUS_HOLD_MS as in focus and records it as a sample. Halted and
+ * homing moves never count. Setups where a client parks the focuser between
+ * sessions should raise the hold time, or set it to 0 to learn only from
+ * explicit RecordFocus() calls (the tempcomp_record setup field).
+ */
+
+#ifndef TEMPCOMP_SAMPLES
+#define TEMPCOMP_SAMPLES 16
+#endif
+
+#ifndef TEMPCOMP_MIN_SAMPLES
+#define TEMPCOMP_MIN_SAMPLES 3
+#endif
+
+#ifndef TEMPCOMP_MIN_STDDEV_C
+#define TEMPCOMP_MIN_STDDEV_C 0.5
+#endif
+
+#ifndef TEMPCOMP_DEFAULT_STEPS_PER_C
+#define TEMPCOMP_DEFAULT_STEPS_PER_C 5.0
+#endif
+
+#ifndef TEMPCOMP_DEADBAND_STEPS
+#define TEMPCOMP_DEADBAND_STEPS 3
+#endif
+
+#ifndef TEMPCOMP_MAX_CORRECTION_STEPS
+#define TEMPCOMP_MAX_CORRECTION_STEPS 50
+#endif
+
+#ifndef TEMPCOMP_FOCUS_HOLD_MS
+#define TEMPCOMP_FOCUS_HOLD_MS 120000
+#endif
+
+class FocuserTempComp
+{
+private:
+  struct Sample {
+    float temperature;
+    int32_t position;
+  };
+
+  // Persisted as one value: samples oldest first
+  struct Stored {
+    uint8_t count;
+    uint8_t reserved[3];
+    Sample samples[TEMPCOMP_SAMPLES];
+  };
+
+  Sample Samples[TEMPCOMP_SAMPLES];
+  uint8_t Count = 0;
+  uint8_t Next = 0; // slot of the next sample, the oldest once full
+
+  // Least squares sums over the buffered samples
+  double SumT = 0;
+  double SumP = 0;
+  double SumTT = 0;
+  double SumTP = 0;
+
+  bool HasReference = false;
+  float ReferenceTemperature = 0;
+  long ReferencePosition = 0;
+
+  void add(const Sample &sample, int sign) {
+    SumT += sign * (double)sample.temperature;
+    SumP += sign * (double)sample.position;
+    SumTT += sign * (double)sample.temperature * sample.temperature;
+    SumTP += sign * (double)sample.temperature * sample.position;
+  }
+
+  void push(const Sample &sample) {
+    if (Count == TEMPCOMP_SAMPLES) {
+      add(Samples[Next], -1);
+    } else {
+      Count++;
+    }
+    Samples[Next] = sample;
+    add(sample, 1);
+    Next = (Next + 1) % TEMPCOMP_SAMPLES;
+  }
+
+  void save() const {
+    Stored stored = {};
+    stored.count = Count;
+    uint8_t oldest = Count == TEMPCOMP_SAMPLES ? Next : 0;
+    for (uint8_t i = 0; i < Count; i++) {
+      stored.samples[i] = Samples[(oldest + i) % TEMPCOMP_SAMPLES];
+    }
+    persistentStore.put(STORE_KEY_FOCUSER_TEMPCOMP, &stored, sizeof(stored));
+  }
+
+  // n * Var(T), 0 if all samples share one temperature
+  double spread() const {
+    return Count > 0 ? SumTT - SumT * SumT / Count : 0;
+  }
+
+public:
+  /**
+   * @brief Load the persisted samples
+   */
+  void begin() {
+    Stored stored;
+    if (!persistentStore.get(STORE_KEY_FOCUSER_TEMPCOMP, &stored, sizeof(stored)) ||
+        stored.count > TEMPCOMP_SAMPLES) {
+      return;
+    }
+    for (uint8_t i = 0; i < stored.count; i++) {
+      push(stored.samples[i]);
+    }
+    LOG_INFO("Loaded " + String(Count) + " temperature compensation samples");
+  }
+
+  /**
+   * @brief Add an in-focus position at @p temperature and refit
+   */
+  void record(float temperature, long position) {
+    push({temperature, (int32_t)position});
+    // Recompute the sums from the buffer now and then to shed rounding drift
+    if (Next == 0) {
+      SumT = SumP = SumTT = SumTP = 0;
+      for (uint8_t i = 0; i < Count; i++) {
+        add(Samples[i], 1);
+      }
+    }
+    save();
+    LOG_INFO("Temperature compensation sample " + String(temperature, 2) + " °C at " + String(position) +
+             ", coefficient " + String(coefficient(), 2) + " steps/°C");
+  }
+
+  /**
+   * @brief Forget all samples, back to TEMPCOMP_DEFAULT_STEPS_PER_C
+   */
+  void reset() {
+    Count = 0;
+    Next = 0;
+    SumT = SumP = SumTT = SumTP = 0;
+    save();
+  }
+
+  /**
+   * @brief Whether the samples determine the coefficient
+   */
+  bool fitted() const {
+    return Count >= TEMPCOMP_MIN_SAMPLES &&
+           spread() >= Count * TEMPCOMP_MIN_STDDEV_C * TEMPCOMP_MIN_STDDEV_C;
+  }
+
+  /**
+   * @brief Position change per degree Celsius
+   */
+  double coefficient() const {
+    if (!fitted()) {
+      return TEMPCOMP_DEFAULT_STEPS_PER_C;
+    }
+    return (SumTP - SumT * SumP / Count) / spread();
+  }
+
+  uint8_t sampleCount() const { return Count; }
+
+  /**
+   * @brief Anchor corrections at an in-focus @p position at @p temperature
+   */
+  void setReference(float temperature, long position) {
+    HasReference = true;
+    ReferenceTemperature = temperature;
+    ReferencePosition = position;
+  }
+
+  void clearReference() { HasReference = false; }
+
+  /**
+   * @brief Record the reference as an in-focus sample
+   */
+  void recordReference() {
+    if (HasReference) {
+      record(ReferenceTemperature, ReferencePosition);
+    }
+  }
+
+  /**
+   * @brief Position to move to at @p temperature
+   * @param current Current position
+   * @param target Set to the corrected position if a move is due
+   * @return false while within the deadband or without a reference
+   */
+  bool correction(float temperature, long current, long &target) const {
+    if (!HasReference) {
+      return false;
+    }
+    long offset = lround(coefficient() * (temperature - ReferenceTemperature));
+    long wanted = ReferencePosition + constrain(offset, -TEMPCOMP_MAX_CORRECTION_STEPS, TEMPCOMP_MAX_CORRECTION_STEPS);
+    if (labs(wanted - current) <= TEMPCOMP_DEADBAND_STEPS) {
+      return false;
+    }
+    target = wanted;
+    return true;
+  }
+};
+
+#endif /* ARDUINO_FOCUSER_TEMPCOMP_H */
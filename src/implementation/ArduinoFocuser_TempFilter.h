@@ -0,0 +1,158 @@
+#ifndef ARDUINO_FOCUSER_TEMPFILTER_H
+#define ARDUINO_FOCUSER_TEMPFILTER_H
+
+#include <Arduino.h>
+
+/**
+ * @file ArduinoFocuser_TempFilter.h
+ * @brief Smoothing of the focuser's DS18B20 readings
+ *
+ * Readings pass through integer stages in 1/100 °C:
+ *
+ * 1. Outlier rejection: a reading more than TEMP_FILTER_OUTLIER_CENTI away
+ *    from the current median is dropped. TEMP_FILTER_MEDIAN drops in a row
+ *    are taken as a real jump (e.g. the probe was moved) and restart the
+ *    filter at the new value.
+ * 2. Median of the last TEMP_FILTER_MEDIAN readings.
+ * 3. Rate limit: the median may move the output by at most
+ *    TEMP_FILTER_MAX_RATE_CENTI_PER_MIN, pro rata to the time since the last
+ *    reading. The fraction of a step left over is carried to the next
+ *    reading, so the limit holds exactly at any reading interval.
+ * 4. Exponential moving average with weight 1 / 2^TEMP_FILTER_EMA_SHIFT,
+ *    kept with 4 extra fraction bits.
+ *
+ * At one reading every 2 s the output settles in about 20 s; a single bad
+ * reading does not move it at all.
+ */
+
+#ifndef TEMP_FILTER_MEDIAN
+#define TEMP_FILTER_MEDIAN 5
+#endif
+
+#ifndef TEMP_FILTER_OUTLIER_CENTI
+#define TEMP_FILTER_OUTLIER_CENTI 200
+#endif
+
+#ifndef TEMP_FILTER_MAX_RATE_CENTI_PER_MIN
+#define TEMP_FILTER_MAX_RATE_CENTI_PER_MIN 100
+#endif
+
+#ifndef TEMP_FILTER_EMA_SHIFT
+#define TEMP_FILTER_EMA_SHIFT 2
+#endif
+
+class TemperatureFilter
+{
+private:
+  static const int EMA_FRACTION_BITS = 4;
+
+  int16_t Window[TEMP_FILTER_MEDIAN]; // last accepted readings
+  uint8_t Count = 0;
+  uint8_t Next = 0;
+  uint8_t Rejections = 0;             // outliers in a row
+  int32_t Median = 0;
+  int32_t Limited = 0;                // rate-limited median
+  int32_t Ema = 0;                    // << EMA_FRACTION_BITS
+  int16_t Raw = 0;
+  unsigned long LastMillis = 0;
+  uint32_t Budget = 0;                // unused rate limit, 1/60000 of 1/100 °C
+
+  uint32_t Readings = 0;
+  uint32_t Outliers = 0;
+  uint32_t RateLimited = 0;
+
+  int32_t median() const {
+    int16_t sorted[TEMP_FILTER_MEDIAN];
+    for (uint8_t i = 0; i < Count; i++) {
+      int16_t value = Window[i];
+      uint8_t j = i;
+      for (; j > 0 && sorted[j - 1] > value; j--) {
+        sorted[j] = sorted[j - 1];
+      }
+      sorted[j] = value;
+    }
+    return sorted[Count / 2];
+  }
+
+  void restart(int16_t centi, unsigned long now) {
+    Window[0] = centi;
+    Count = 1;
+    Next = 1 % TEMP_FILTER_MEDIAN;
+    Rejections = 0;
+    Median = Limited = centi;
+    Ema = (int32_t)centi << EMA_FRACTION_BITS;
+    LastMillis = now;
+    Budget = 0;
+  }
+
+public:
+  /**
+   * @brief Add a valid sensor reading
+   * @return false if it was rejected as an outlier
+   */
+  bool add(float celsius, unsigned long now) {
+    int16_t centi = (int16_t)lroundf(celsius * 100.0f);
+    Raw = centi;
+    Readings++;
+    if (Count == 0) {
+      restart(centi, now);
+      return true;
+    }
+
+    if (labs((long)centi - Median) > TEMP_FILTER_OUTLIER_CENTI) {
+      Outliers++;
+      if (++Rejections < TEMP_FILTER_MEDIAN) {
+        return false;
+      }
+      restart(centi, now);
+      return true;
+    }
+    Rejections = 0;
+
+    Window[Next] = centi;
+    Next = (Next + 1) % TEMP_FILTER_MEDIAN;
+    if (Count < TEMP_FILTER_MEDIAN) {
+      Count++;
+    }
+    Median = median();
+
+    // Rate times elapsed milliseconds, plus the fraction of a step carried over
+    uint64_t budget = Budget + (uint64_t)TEMP_FILTER_MAX_RATE_CENTI_PER_MIN * (now - LastMillis);
+    LastMillis = now;
+    int32_t step = Median - Limited;
+    int32_t maxStep = (int32_t)min(budget / 60000, (uint64_t)INT16_MAX);
+    if (step > maxStep || step < -maxStep) {
+      step = step > 0 ? maxStep : -maxStep;
+      RateLimited++;
+    }
+    Limited += step;
+    // Only the fraction is carried, so a quiet spell cannot save up for a jump
+    Budget = (uint32_t)min(budget - (uint64_t)abs(step) * 60000, (uint64_t)59999);
+
+    Ema += (((int32_t)Limited << EMA_FRACTION_BITS) - Ema) >> TEMP_FILTER_EMA_SHIFT;
+    return true;
+  }
+
+  /**
+   * @brief Forget all readings, e.g. after switching sensors
+   */
+  void reset() {
+    Count = 0;
+    Next = 0;
+    Rejections = 0;
+  }
+
+  bool ready() const { return Count > 0; }
+
+  // Stage outputs in °C
+  float value() const { return Ema / (float)(100 << EMA_FRACTION_BITS); }
+  float raw() const { return Raw / 100.0f; }
+  float medianValue() const { return Median / 100.0f; }
+  float limitedValue() const { return Limited / 100.0f; }
+
+  uint32_t readingCount() const { return Readings; }
+  uint32_t outlierCount() const { return Outliers; }
+  uint32_t rateLimitedCount() const { return RateLimited; }
+};
+
+#endif /* ARDUINO_FOCUSER_TEMPFILTER_H */
@@ -2,33 +2,57 @@
 #define A5BDF2AE_8CDD_4DFA_B4AE_E98D3FB81323
 
 #include <Arduino.h>
-#include <EEPROM.h>
+#include "Persistent_Store.h"
+#include "Deferred_Log.h"
+#include "Metrics.h"
+#include "Task_Scheduler.h"
 #include "ArduinoStepper_Types.h"
 
+// Motors one firmware image can drive; each axis has its own persisted settings
+#ifndef STEPPER_MAX_AXES
+#define STEPPER_MAX_AXES 3
+#endif
+
+// Axes 1.. take four keys each from STORE_KEY_STEPPER_AXIS1; store keys are a uint8_t
+static_assert(STEPPER_MAX_AXES >= 1, "STEPPER_MAX_AXES must be at least 1");
+static_assert(STORE_KEY_STEPPER_AXIS1 + (STEPPER_MAX_AXES - 1) * 4 + 3 <= 255,
+              "STEPPER_MAX_AXES too large: the axis store keys would not fit in a uint8_t");
+
+/**
+ * @brief ULN2003 stepper motor, one instance per axis
+ *
+ * Every instance has its own pins, step mode, motion profile and step
+ * timing, and persists them under its own store keys: axis 0 uses the
+ * STORE_KEY_STEPPER_* keys, axis n > 0 four keys from STORE_KEY_STEPPER_AXIS1;
+ * axes from STEPPER_MAX_AXES on are not persisted.
+ * Instances link themselves into a list so that one scheduler task
+ * (registerTasks()) steps all motors.
+ */
 class ArduinoStepper
 {
 private:
     /* data */
+uint8_t Axis;
+ArduinoStepper *NextAxis; // next instance in axes()
+uint8_t DefaultPins[4];   // used if nothing valid is stored
+
 eSTEPMODE StepperMode = FullStep2Phase;
 
-#define POSSAVETOEEPROMTIME 2000
+#define POSSAVETIME 2000
 
-int pulseWidthMicrosULN2003 = 2000;  //100 microseconds
-int pulseWidthMicros = 100;  //100 microseconds
-int millisbetweenSteps = 5; // milliseconds - or try 1000 for sfalseer steps
-#define EEADDRESS_POS 0
-#define EEPROM_POS_ADDRESS 0
-#define EEPROM_MODE_ADDRESS 4
-#define EEPROM_PINS_ADDRESS 149
-#define EEPROM_PINS_VALID_MARKER 153
+// Default motion profile (used if nothing valid is stored)
+#define DEFAULT_MAX_SPEED 500          // steps per second
+#define DEFAULT_ACCELERATION 1000      // steps per second^2
+#define MAX_SPEED_LIMIT 2000
+#define MAX_ACCELERATION_LIMIT 20000
 
-// Default pin values (used if EEPROM is invalid/empty)
+// Default pin values (used if nothing valid is stored)
 #define DEFAULT_ULN2003_Pin1 5
 #define DEFAULT_ULN2003_Pin2 14
 #define DEFAULT_ULN2003_Pin3 12
 #define DEFAULT_ULN2003_Pin4 13
 
-// Actual pin variables (loaded from EEPROM or defaults)
+// Actual pin variables (loaded from the persistent store or defaults)
 int ULN2003_Pin1;
 int ULN2003_Pin2;
 int ULN2003_Pin3;
@@ -36,10 +60,7 @@ int ULN2003_Pin4;
 
 #define STEPSPERROUND 2048
 
-#define SPEED_FAST 60
-#define SPEED_false 10
-
-uint32_t LastEEPROMPosition=0;
+uint32_t LastSavedPosition=0;
 
 uint32_t DrivePosition=0; // Drive Position in Steps
 uint32_t TargetPosition=0; // Target Position 
@@ -50,8 +71,21 @@ uint32_t target = 0;
 bool releaseMove = false;
 bool bStop=false;
 
-int StepPosition;
-int MaxPositions;
+// Backlash handling (driven by the focuser): SlackSteps coil steps are
+// driven before the position starts to count, and a move can continue to
+// NextTarget once target is reached, to end every move from the same side
+uint32_t SlackSteps=0;
+uint32_t NextTarget=0;
+bool HasNextTarget=false;
+
+// Coil phases of the current step mode resolved to GPIO masks for the current
+// pins (see updatePhaseMasks()), so a phase is one GPOC and one GPOS write
+// instead of four digitalWrite() calls with intermediate coil states
+#define MAX_PHASES 16
+uint32_t PhaseMasks[MAX_PHASES]; // per phase: bit n = GPIO n high, the other coils low
+uint8_t PhaseCount=4;
+uint8_t PhaseIndex=0;            // next phase to drive
+uint32_t CoilMask=0;             // bit n set for each coil pin n
 
 unsigned long ActTime=0;
 unsigned long ActMicros=0;
@@ -59,33 +93,64 @@ unsigned long LastPosTime=0;
 unsigned long LastTime=0;
 unsigned long VoltageLastTime=0;
 unsigned long LastStepTime=0;
-unsigned long LastPosSaveToEEPROMTime=0;
+unsigned long LastPosSaveTime=0;
+
+// Non-blocking step engine: Update() emits at most one coil phase per call,
+// spaced PhaseIntervalMicros apart.
+#define PHASES_PER_STEP 2 // coil phases per position step
+unsigned long NextPhaseMicros=0;
+unsigned long PhaseIntervalMicros=2000;
+int PendingPhases=0;   // phases still to emit for the current position step
+int PhaseDirection=0;  // +1 or -1
+
+// Trapezoidal motion profile: the speed of each step is planned from the
+// distance to go, accelerating to MaxSpeed and braking in time to stop at the target.
+long MaxSpeed=DEFAULT_MAX_SPEED;         // steps per second
+long Acceleration=DEFAULT_ACCELERATION;  // steps per second^2
+float CurrentSpeed=0;                    // speed of the step in progress, 0 when stopped
 
 public:
 
 
-ArduinoStepper(/* args */)
+/**
+ * @param axis Motor number, selects the persisted settings (0..STEPPER_MAX_AXES-1)
+ * @param pin1..pin4 Coil pins used until others are stored with setPins()
+ */
+explicit ArduinoStepper(uint8_t axis = 0, int pin1 = DEFAULT_ULN2003_Pin1, int pin2 = DEFAULT_ULN2003_Pin2,
+                        int pin3 = DEFAULT_ULN2003_Pin3, int pin4 = DEFAULT_ULN2003_Pin4)
+  : Axis(axis), NextAxis(axes()), DefaultPins{(uint8_t)pin1, (uint8_t)pin2, (uint8_t)pin3, (uint8_t)pin4}
 {    
-  EEPROM.begin(512); // Initialize EEPROM with 512 bytes of storage
+  axes() = this;
+  if(!persisted()){
+    LOG_WARN("Stepper axis " + String(axis) + " exceeds STEPPER_MAX_AXES, its settings will not be persisted");
+  }
+  persistentStore.begin();
     
-    // Load position from EEPROM
-    position = readFromEEPROM(EEPROM_POS_ADDRESS);
-    if(position < 0 || position > 20000){ // Sanity check for position value
-      position = 0;
+    // Load position
+    int32_t storedPosition = 0;
+    if(!persisted() || !persistentStore.get(storeKey(STORE_KEY_STEPPER_POSITION), storedPosition) ||
+       storedPosition < 0 || storedPosition > 20000){ // Sanity check for position value
+      storedPosition = 0;
     }
-    LastEEPROMPosition=position;
+    position = storedPosition;
+    LastSavedPosition=position;
     
-    // Load stepper mode from EEPROM
-    int modeValue = readFromEEPROM(EEPROM_MODE_ADDRESS);
+    // Load stepper mode
+    uint8_t modeValue = 0xFF;
+    if(persisted()){
+      persistentStore.get(storeKey(STORE_KEY_STEPPER_MODE), modeValue);
+    }
     if(modeValue >= FullStep && modeValue <= FullStep2Phase) {
       StepperMode = (eSTEPMODE) modeValue;
     } else {
       StepperMode = FullStep2Phase; // Default to FullStep2Phase if invalid
-      writeToEEPROM(EEPROM_MODE_ADDRESS, StepperMode);
     }
     
-    // Load pins from EEPROM with validation
-    loadPinsFromEEPROM();
+    // Load pins with validation
+    loadPins();
+
+    // Load motion profile with validation
+    loadMotion();
 
     // Configure pins as outputs
     pinMode(ULN2003_Pin1, OUTPUT);
@@ -95,7 +160,7 @@ ArduinoStepper(/* args */)
 
     setStepMode(StepperMode);
 
-    LOG_INFO("ArduinoStepper initialized with position: " + String(position) + " and step mode: " + String(StepperMode));
+    LOG_INFO("ArduinoStepper axis " + String(Axis) + " initialized with position: " + String(position) + " and step mode: " + String(StepperMode));
     LOG_INFO("Stepper pins - Pin1: " + String(ULN2003_Pin1) + " Pin2: " + String(ULN2003_Pin2) + 
              " Pin3: " + String(ULN2003_Pin3) + " Pin4: " + String(ULN2003_Pin4));
 }
@@ -103,48 +168,82 @@ ArduinoStepper(/* args */)
 
 ~ArduinoStepper()
 {   
+  for(ArduinoStepper **link = &axes(); *link != nullptr; link = &(*link)->NextAxis){
+    if(*link == this){
+      *link = NextAxis;
+      break;
+    }
+  }
+}
+
+ArduinoStepper(const ArduinoStepper &) = delete;
+ArduinoStepper &operator=(const ArduinoStepper &) = delete;
+
+/**
+ * @brief Run Update() of every motor
+ */
+static void updateAll()
+{
+  for(ArduinoStepper *axis = axes(); axis != nullptr; axis = axis->NextAxis){
+    axis->Update();
+  }
+}
+
+/**
+ * @brief Register the coil phase task of all motors, once however many devices call it
+ */
+static void registerTasks(TaskScheduler &scheduler)
+{
+  static bool registered = false;
+  if(!registered){
+    registered = true;
+    scheduler.every("stepper", 0, TASK_PRIORITY_CRITICAL, updateAll);
+  }
+}
+
+/**
+ * @brief The motor driving @p pin, other than @p except
+ * @return nullptr if no other motor uses the pin
+ */
+static ArduinoStepper *findByPin(int pin, const ArduinoStepper *except = nullptr)
+{
+  for(ArduinoStepper *axis = axes(); axis != nullptr; axis = axis->NextAxis){
+    if(axis != except && (pin == axis->ULN2003_Pin1 || pin == axis->ULN2003_Pin2 ||
+                          pin == axis->ULN2003_Pin3 || pin == axis->ULN2003_Pin4)){
+      return axis;
+    }
+  }
+  return nullptr;
 }
 
+uint8_t getAxis() { return Axis; }
+
 
 void Init()
 {
-delay(500);
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-          delay(500);
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-          delay(500);
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-         delay(500);
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, true);
-delay(500);
+  delay(500);
+  // Energize each coil on its own
+  for (uint8_t coil = 0; coil < 4; coil++) {
+    writeCoils(coilsToMask(1 << coil));
+    delay(500);
+  }
 }
 
 void setTarget(uint32_t newpos)
 {
   target = newpos;
+  HasNextTarget=false;
   bMoveToPos=true;
   
       bStop=false;
-  LOG_INFO("Target position set to: " + String(target) + " from current position: " + String(position));
+  LOG_DEFERRED_INFO("Axis %u target position set to: %u from current position: %u", Axis, target, position);
 }
 
 void setActualPosition(uint32_t newpos)
 {
   position = newpos;
-  saveToEEPROM(EEPROM_POS_ADDRESS,position); // Save position for later
-  LOG_INFO("Actual position set to: " + String(position));
+  savePosition(); // Save position for later
+  LOG_DEFERRED_INFO("Axis %u actual position set to: %u", Axis, position);
 }
 
 int getTarget()
@@ -163,53 +262,97 @@ bool isMoving()
   LOG_INFO("isMoving called - returning: " + String(bMoveToPos));
 }
 
+/**
+ * @brief Move to @p newpos, then on to @p thenpos without stopping the move
+ *
+ * isMoving() stays true until @p thenpos is reached. Used to overshoot a
+ * target and approach it back from one side.
+ */
+void setTarget(uint32_t newpos, uint32_t thenpos)
+{
+  setTarget(newpos);
+  NextTarget = thenpos;
+  HasNextTarget = newpos != thenpos;
+}
+
+/**
+ * @brief Drive @p steps extra coil steps at the start of the next move without counting them as position
+ *
+ * Takes up gear slack after a reversal, so the position keeps matching the
+ * load instead of the motor shaft.
+ */
+void takeUpSlack(uint32_t steps)
+{
+  SlackSteps = steps;
+}
+
 void halt()
 {
   bStop=true;
+  HasNextTarget=false;
 }   
 
 void Update() {
- //LOG_INFO("Update called - Current position: " + String(position) + " Target position: " + String(target) + " Is moving: " + String(bMoveToPos));
-    // move to target if it differs from position and move to pos is enabled
-    if(target < position && bMoveToPos && !bStop){
-        position-=1;
-        //delayMicroseconds(100);
-        step(-1);
-        //Serial.println("-1 Step");
-    }else if(target > position && bMoveToPos && !bStop) {
-        position+=1;
-        //delayMicroseconds(100);
-        step(1);
-    }else if(!bStop && bMoveToPos){
+    // Periodically record the position during long moves; the store
+    // coalesces these into at most one flash append per commit window
+    ActTime = millis();
+    if(ActTime - LastPosSaveTime > POSSAVETIME){
+      LastPosSaveTime=ActTime;
+      if(LastSavedPosition !=position){
+      savePosition();
+      }
+    }
+
+    // Continue with the second leg of setTarget(newpos, thenpos)
+    if(PendingPhases == 0 && bMoveToPos && !bStop && target == position && HasNextTarget){
+        target = NextTarget;
+        HasNextTarget = false;
+    }
+
+    // Start the next position step towards the target, or past it while braking
+    if(PendingPhases == 0 && bMoveToPos && !bStop && (target != position || overrunning())){
+        planStep();
+    }
+
+    // Emit the next coil phase once it is due, without blocking loop()
+    if(PendingPhases > 0){
+      unsigned long now = micros();
+      if((long)(now - NextPhaseMicros) < 0){
+        return;
+      }
+      outputPhase(PhaseDirection);
+      PendingPhases--;
+      // Keep the step cadence, but do not burst phases after a long loop() stall
+      NextPhaseMicros += PhaseIntervalMicros;
+      if((long)(now - NextPhaseMicros) >= 0){
+        NextPhaseMicros = now + PhaseIntervalMicros;
+      }
+      return;
+    }
+
+    CurrentSpeed = 0;
+    if(!bStop && bMoveToPos){
       // release drive            
-      saveToEEPROM(EEPROM_POS_ADDRESS,position); // Save position for later
-      //delay(50);
+      savePosition(); // Save position for later
       releaseDrive();
       bMoveToPos=false;
     }else if(bMoveToPos){      
-      saveToEEPROM(EEPROM_POS_ADDRESS,position); // Save position for later
-      //delay(50);
+      savePosition(); // Save position for later
       releaseDrive();
       bMoveToPos=false;
       bStop=false;
     }
-
-    if(LastPosSaveToEEPROMTime+POSSAVETOEEPROMTIME < ActTime){
-      LastPosSaveToEEPROMTime=ActTime;
-      if(LastEEPROMPosition !=position){
-      saveToEEPROM(EEPROM_POS_ADDRESS,position); // Save position for later
-      LastEEPROMPosition=position;
-      }
-    }
-
 }
 
 void setStepMode(eSTEPMODE mode){
-  StepPosition=1;
   StepperMode=mode;
-  // Save mode to EEPROM
-  writeToEEPROM(EEPROM_MODE_ADDRESS, mode);
-  LOG_INFO("Stepper mode set to: " + String(mode));
+  updatePhaseMasks();
+  PhaseIndex=0;
+  // Persist mode
+  if(persisted()){
+    persistentStore.put(storeKey(STORE_KEY_STEPPER_MODE), (uint8_t)mode);
+  }
+  LOG_INFO("Stepper axis " + String(Axis) + " mode set to: " + String(mode));
   }
   
   eSTEPMODE getStepMode() {
@@ -235,13 +378,48 @@ void setStepMode(eSTEPMODE mode){
     pinMode(ULN2003_Pin3, OUTPUT);
     pinMode(ULN2003_Pin4, OUTPUT);
     
-    // Save to EEPROM
-    savePinsToEEPROM();
+    updatePhaseMasks();
+
+    // Persist pins
+    savePins();
     
-    LOG_INFO("Stepper pins updated - Pin1: " + String(pin1) + " Pin2: " + String(pin2) + 
+    LOG_INFO("Stepper axis " + String(Axis) + " pins updated - Pin1: " + String(pin1) + " Pin2: " + String(pin2) + 
              " Pin3: " + String(pin3) + " Pin4: " + String(pin4));
   }
   
+  /**
+   * @brief Set the cruise speed of the motion profile and persist it
+   * @param stepsPerSecond 1..MAX_SPEED_LIMIT
+   * @return false if out of range
+   */
+  bool setMaxSpeed(long stepsPerSecond) {
+    if(stepsPerSecond < 1 || stepsPerSecond > MAX_SPEED_LIMIT) {
+      return false;
+    }
+    MaxSpeed = stepsPerSecond;
+    saveMotion();
+    LOG_INFO("Stepper max speed set to: " + String(MaxSpeed) + " steps/s");
+    return true;
+  }
+
+  /**
+   * @brief Set the acceleration/deceleration of the motion profile and persist it
+   * @param stepsPerSecond2 1..MAX_ACCELERATION_LIMIT
+   * @return false if out of range
+   */
+  bool setAcceleration(long stepsPerSecond2) {
+    if(stepsPerSecond2 < 1 || stepsPerSecond2 > MAX_ACCELERATION_LIMIT) {
+      return false;
+    }
+    Acceleration = stepsPerSecond2;
+    saveMotion();
+    LOG_INFO("Stepper acceleration set to: " + String(Acceleration) + " steps/s^2");
+    return true;
+  }
+
+  long getMaxSpeed() { return MaxSpeed; }
+  long getAcceleration() { return Acceleration; }
+
   int getPin1() { return ULN2003_Pin1; }
   int getPin2() { return ULN2003_Pin2; }
   int getPin3() { return ULN2003_Pin3; }
@@ -250,390 +428,289 @@ void setStepMode(eSTEPMODE mode){
 
 void releaseDrive(){
     //digitalWrite(PIN_ENABLE, true);
-  digitalWrite(ULN2003_Pin1, false);
-  digitalWrite(ULN2003_Pin2, false);
-  digitalWrite(ULN2003_Pin3, false);
-  digitalWrite(ULN2003_Pin4, false);
+  writeCoils(0);
 };
 
 
 private:
 
-void saveToEEPROM(int addr, long pos){
-  EEPROM.put(addr, pos);
-  EEPROM.commit(); // Ensure data is written to EEPROM
-};
+/**
+ * @brief Head of the list of all instances
+ */
+static ArduinoStepper *&axes()
+{
+  static ArduinoStepper *first = nullptr;
+  return first;
+}
 
-long readFromEEPROM(int addr ){
- long value;
- EEPROM.get(addr, value);
- return value;
-};
+/**
+ * @brief Whether this axis has store keys; axes from STEPPER_MAX_AXES on keep their settings in RAM only
+ */
+bool persisted() const
+{
+  return Axis < STEPPER_MAX_AXES;
+}
+
+/**
+ * @brief Store key of one of the STORE_KEY_STEPPER_* settings for this axis
+ * Only valid if persisted().
+ */
+uint8_t storeKey(PersistentStoreKey key) const
+{
+  if(Axis == 0){
+    return key;
+  }
+  return STORE_KEY_STEPPER_AXIS1 + (Axis - 1) * 4 + (key - STORE_KEY_STEPPER_POSITION);
+}
 
-void writeToEEPROM(int addr, long value){
-  EEPROM.put(addr, value);
-  EEPROM.commit();
+void savePosition(){
+  if(persisted()){
+    persistentStore.put(storeKey(STORE_KEY_STEPPER_POSITION), (int32_t)position);
+  }
+  LastSavedPosition=position;
 };
 
-void loadPinsFromEEPROM() {
-  // Check validation marker
-  byte validMarker = EEPROM.read(EEPROM_PINS_VALID_MARKER);
+void loadPins() {
+  uint8_t pins[4];
   
-  if(validMarker == 0xAA) {
-    // Valid pins stored in EEPROM
-    ULN2003_Pin1 = EEPROM.read(EEPROM_PINS_ADDRESS);
-    ULN2003_Pin2 = EEPROM.read(EEPROM_PINS_ADDRESS + 1);
-    ULN2003_Pin3 = EEPROM.read(EEPROM_PINS_ADDRESS + 2);
-    ULN2003_Pin4 = EEPROM.read(EEPROM_PINS_ADDRESS + 3);
+  if(persisted() && persistentStore.get(storeKey(STORE_KEY_STEPPER_PINS), pins, sizeof(pins))) {
+    ULN2003_Pin1 = pins[0];
+    ULN2003_Pin2 = pins[1];
+    ULN2003_Pin3 = pins[2];
+    ULN2003_Pin4 = pins[3];
     
     // Validate pin numbers (ESP8266 GPIO 0-16)
     if(ULN2003_Pin1 > 16 || ULN2003_Pin2 > 16 || ULN2003_Pin3 > 16 || ULN2003_Pin4 > 16) {
-      LOG_WARN("Invalid pin values in EEPROM, using defaults");
+      LOG_WARN("Invalid stored pin values, using defaults");
       setDefaultPins();
-      savePinsToEEPROM();
+      savePins();
     } else {
-      LOG_INFO("Loaded stepper pins from EEPROM");
+      LOG_INFO("Loaded stepper pins from persistent store");
     }
   } else {
-    LOG_INFO("No valid pins in EEPROM, using defaults");
+    LOG_INFO("No stored stepper pins, using defaults");
     setDefaultPins();
-    savePinsToEEPROM();
+    savePins();
   }
 }
 
 void setDefaultPins() {
-  ULN2003_Pin1 = DEFAULT_ULN2003_Pin1;
-  ULN2003_Pin2 = DEFAULT_ULN2003_Pin2;
-  ULN2003_Pin3 = DEFAULT_ULN2003_Pin3;
-  ULN2003_Pin4 = DEFAULT_ULN2003_Pin4;
+  ULN2003_Pin1 = DefaultPins[0];
+  ULN2003_Pin2 = DefaultPins[1];
+  ULN2003_Pin3 = DefaultPins[2];
+  ULN2003_Pin4 = DefaultPins[3];
 }
 
-void savePinsToEEPROM() {
-  EEPROM.write(EEPROM_PINS_ADDRESS, ULN2003_Pin1);
-  EEPROM.write(EEPROM_PINS_ADDRESS + 1, ULN2003_Pin2);
-  EEPROM.write(EEPROM_PINS_ADDRESS + 2, ULN2003_Pin3);
-  EEPROM.write(EEPROM_PINS_ADDRESS + 3, ULN2003_Pin4);
-  EEPROM.write(EEPROM_PINS_VALID_MARKER, 0xAA);
-  EEPROM.commit();
-  LOG_INFO("Saved stepper pins to EEPROM");
+void savePins() {
+  if(!persisted()){
+    return;
+  }
+  uint8_t pins[4] = {(uint8_t)ULN2003_Pin1, (uint8_t)ULN2003_Pin2, (uint8_t)ULN2003_Pin3, (uint8_t)ULN2003_Pin4};
+  persistentStore.put(storeKey(STORE_KEY_STEPPER_PINS), pins, sizeof(pins));
+  LOG_INFO("Saved stepper pins");
 }
 
-void move(long val)
-{
-  if(val > 0){
-    step(SPEED_FAST);
-  }else{
-    step(-SPEED_FAST);  
+void loadMotion() {
+  int32_t motion[2];
+
+  if(persisted() && persistentStore.get(storeKey(STORE_KEY_STEPPER_MOTION), motion, sizeof(motion)) &&
+     motion[0] >= 1 && motion[0] <= MAX_SPEED_LIMIT &&
+     motion[1] >= 1 && motion[1] <= MAX_ACCELERATION_LIMIT) {
+    MaxSpeed = motion[0];
+    Acceleration = motion[1];
+    LOG_INFO("Loaded stepper motion profile from persistent store");
+  } else {
+    LOG_INFO("No valid stored motion profile, using defaults");
+    MaxSpeed = DEFAULT_MAX_SPEED;
+    Acceleration = DEFAULT_ACCELERATION;
+    saveMotion();
   }
-};
+}
 
+void saveMotion() {
+  if(!persisted()){
+    return;
+  }
+  int32_t motion[2] = {(int32_t)MaxSpeed, (int32_t)Acceleration};
+  persistentStore.put(storeKey(STORE_KEY_STEPPER_MOTION), motion, sizeof(motion));
+}
 
-void step(int val)
+/**
+ * @brief Start speed sqrt(2a): the speed from which one step of braking stops the motor
+ */
+float startSpeed() const
 {
-  if (StepperMode == HalfStep)
-  {
-    MaxPositions = 8;
-  }
-  else if (StepperMode == EighthStep)
-  {
-    MaxPositions = 8;
+  return sqrtf(2.0f * Acceleration);
+}
+
+/**
+ * @brief Whether the motor is still fast enough to brake for another step
+ * True at the target only after a target change left too little distance to
+ * brake; Update() then keeps planning steps past the target.
+ */
+bool overrunning() const
+{
+  return CurrentSpeed * CurrentSpeed - 2.0f * Acceleration > 1.01f * 2.0f * Acceleration;
+}
+
+/**
+ * @brief Plan the next position step towards the target
+ *
+ * Speeds follow v^2 = v0^2 + 2*a*s, one step at a time: accelerate while the
+ * motor could still slow down to the start speed sqrt(2a) by the target,
+ * cruise at MaxSpeed, then decelerate so that the last step is taken at the
+ * start speed. Pending slack steps are driven first and count towards the
+ * distance to go, but not towards the position.
+ *
+ * If a target change leaves the target behind the motor, or closer than its
+ * braking distance, it keeps going in its current direction, braking at
+ * Acceleration, and reverses only once down to the start speed.
+ */
+void planStep()
+{
+  long distance = (long)target - (long)position;
+  int direction = distance < 0 ? -1 : 1;
+  long stepsToGo = labs(distance) + (long)SlackSteps;
+  float a2 = 2.0f * Acceleration;
+  float start = startSpeed();
+  float v2 = CurrentSpeed * CurrentSpeed;
+  int stepDirection = direction;
+
+  if (CurrentSpeed <= 0) {
+    CurrentSpeed = start;
+  } else if (distance == 0 || direction != PhaseDirection) {
+    // Target reached at speed or behind: brake before reversing, but never below position 0
+    if (v2 - a2 > start * start && !(PhaseDirection < 0 && position == 0)) {
+      CurrentSpeed = sqrtf(v2 - a2);
+      stepDirection = PhaseDirection;
+    } else if (distance == 0) {
+      CurrentSpeed = 0;
+      return;
+    } else {
+      CurrentSpeed = start;
+    }
+  } else {
+    // Highest speed after this step from which the motor still slows to the start speed by the target
+    float limit2 = start * start + a2 * (float)(stepsToGo - 1);
+    float faster2 = std::min(v2 + a2, (float)MaxSpeed * (float)MaxSpeed);
+    if (faster2 <= limit2) {
+      CurrentSpeed = sqrtf(faster2);
+    } else if (v2 > limit2) {
+      CurrentSpeed = sqrtf(std::max(v2 - a2, start * start));
+    }
   }
-  else if (StepperMode == QuaterStep)
-  {
-    MaxPositions = 16;
+  if (CurrentSpeed > MaxSpeed) {
+    CurrentSpeed = MaxSpeed;
   }
-  else 
-  {
-    MaxPositions = 4;
+
+  if (stepDirection == direction && distance != 0 && SlackSteps > 0) {
+    SlackSteps--;
+  } else {
+    position += stepDirection;
   }
+  PhaseDirection = stepDirection;
+  metrics.countSteps(1);
+  PendingPhases = PHASES_PER_STEP;
+  PhaseIntervalMicros = (unsigned long)(1000000.0f / (CurrentSpeed * PHASES_PER_STEP));
+}
 
-  for(int n = 0; n < abs(val)+1; n++) {
-
-    switch (StepperMode)
-    {
-      case FullStep:
-          //Serial.println("Fullstep");
-          SetOutputToDriveFullSteps(StepPosition);
-          break;
-      case FullStep2Phase:
-          SetOutputToDriveFullSteps2Phase(StepPosition);
-          break;
-      case HalfStep:
-          SetOutputToDriveHalfSteps(StepPosition);
-          break;
-      case QuaterStep:
-          SetOutputToDriveQuaterSteps(StepPosition);
-          break;
-      case EighthStep:
-          SetOutputToDriveEighthSteps(StepPosition);
-          break;
-      case SixteenthStep:
-          SetOutputToDriveSixteenthSteps(StepPosition);
-          break;
-    }
+/**
+ * @brief Drive the coils for the current phase and advance the phase index
+ * @param direction +1 or -1
+ */
+void outputPhase(int direction)
+{
+  writeCoils(PhaseMasks[PhaseIndex]);
 
-    if(val>0){
-    StepPosition++;
-    }else{
-      StepPosition--;
-    }
-    if(StepPosition > MaxPositions)
-    {
-      StepPosition = 1;
-    }else if(StepPosition < 1){
-      StepPosition=MaxPositions;
-    }
-    delayMicroseconds(pulseWidthMicrosULN2003);
+  if(direction>0){
+    PhaseIndex = PhaseIndex + 1 < PhaseCount ? PhaseIndex + 1 : 0;
+  }else{
+    PhaseIndex = PhaseIndex > 0 ? PhaseIndex - 1 : PhaseCount - 1;
   }
 };
 
-void SetOutputToDriveFullSteps(int step)
+/**
+ * @brief Coil sequence of a step mode, one entry per phase
+ *
+ * Bit 0..3 = coil on ULN2003_Pin1..4. The ULN2003 driver only switches
+ * coils on or off, so EighthStep reuses the half step sequence and
+ * SixteenthStep the single coil full step sequence.
+ */
+static const uint8_t *phaseTable(eSTEPMODE mode, uint8_t &count)
 {
-  switch (step)
-     {
-         case 1:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 2:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 3:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 4:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-     }
-};
+  // Single coil full steps
+  static const uint8_t FULL[] = {0x1, 0x2, 0x4, 0x8};
+  // Two coil full steps, more torque
+  static const uint8_t FULL_2PHASE[] = {0x3, 0x6, 0xC, 0x9};
+  static const uint8_t HALF[] = {0x1, 0x3, 0x2, 0x6, 0x4, 0xC, 0x8, 0x9};
+  // 16 positions per cycle, holding the two coil phases for two positions
+  static const uint8_t QUARTER[] = {0x1, 0x3, 0x3, 0x2, 0x6, 0x6, 0x4, 0xC,
+                                    0xC, 0x8, 0x9, 0x9, 0x1, 0x3, 0x2, 0x6};
+
+  switch (mode)
+  {
+    case FullStep2Phase:
+      count = sizeof(FULL_2PHASE);
+      return FULL_2PHASE;
+    case HalfStep:
+    case EighthStep:
+      count = sizeof(HALF);
+      return HALF;
+    case QuaterStep:
+      count = sizeof(QUARTER);
+      return QUARTER;
+    case FullStep:
+    case SixteenthStep:
+    default:
+      count = sizeof(FULL);
+      return FULL;
+  }
+}
+
+/**
+ * @brief GPIO mask of the coils set in @p coils (bit 0..3 = ULN2003_Pin1..4)
+ */
+uint32_t coilsToMask(uint8_t coils)
+{
+  const int pins[4] = {ULN2003_Pin1, ULN2003_Pin2, ULN2003_Pin3, ULN2003_Pin4};
+  uint32_t mask = 0;
+  for (uint8_t coil = 0; coil < 4; coil++) {
+    if (coils & (1 << coil)) {
+      mask |= 1UL << pins[coil];
+    }
+  }
+  return mask;
+}
 
+/**
+ * @brief Rebuild PhaseMasks and CoilMask after a step mode or pin change
+ */
+void updatePhaseMasks()
+{
+  const uint8_t *table = phaseTable(StepperMode, PhaseCount);
+  for (uint8_t i = 0; i < PhaseCount; i++) {
+    PhaseMasks[i] = coilsToMask(table[i]);
+  }
+  CoilMask = coilsToMask(0xF);
+  if (PhaseIndex >= PhaseCount) {
+    PhaseIndex = 0;
+  }
+}
 
- void SetOutputToDriveHalfSteps(int step)
- {
-     switch (step)
-     {
-         case 1:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 2:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 3:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 4:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 5:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 6:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         case 7:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         case 8:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         default:
-            // Console.WriteLine("SetOutputToDriveHalfSteps -> Unknown Step.");
-             break;
-
-     }
-
- };
-
- void SetOutputToDriveFullSteps2Phase(int step)
- {
-     switch (step)
-     {
-         case 1:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 2:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 3:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         case 4:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         default:
-            // Console.WriteLine("SetOutputToDriveFullSteps2Phase -> Unknown Step.");
-             break;
-
-     }
-
- };
-
- void SetOutputToDriveQuaterSteps(int step)
- {
-     // Quarter stepping: 16 positions per full cycle
-     switch (step)
-     {
-         case 1:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 2:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 3:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 4:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 5:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 6:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 7:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 8:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         case 9:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         case 10:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         case 11:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         case 12:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, true);
-             break;
-         case 13:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, false);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 14:
-             digitalWrite(ULN2003_Pin1, true);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 15:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, false);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         case 16:
-             digitalWrite(ULN2003_Pin1, false);
-             digitalWrite(ULN2003_Pin2, true);
-             digitalWrite(ULN2003_Pin3, true);
-             digitalWrite(ULN2003_Pin4, false);
-             break;
-         default:
-             break;
-     }
- };
-
- void SetOutputToDriveEighthSteps(int step)
- {
-     // Eighth stepping: uses same 8-position sequence as half step
-     // ULN2003 cannot do true microstepping beyond this
-     SetOutputToDriveHalfSteps(step);
- };
-
- void SetOutputToDriveSixteenthSteps(int step)
- {
-     // Sixteenth stepping: uses full step sequence
-     // ULN2003 binary driver limitation
-     SetOutputToDriveFullSteps(step);
- };
+/**
+ * @brief Drive the coils in @p mask high and the other coils low
+ *
+ * GPIO0..15 are switched with one write each to the clear and set
+ * registers. GPIO16 is not part of them and has its own output register.
+ */
+void writeCoils(uint32_t mask)
+{
+  GPOC = CoilMask & ~mask & 0xFFFF;
+  GPOS = mask & 0xFFFF;
+  if (CoilMask & (1UL << 16)) {
+    GP16O = (mask >> 16) & 1;
+  }
+}
 
 };
 
@@ -329,6 +329,15 @@ public:
     updateCalibrator();
   }
   
+  /**
+   * @brief Run update() from the task scheduler
+   * Cover and brightness ramps, every 20 ms
+   */
+  void registerTasks(TaskScheduler &scheduler) override {
+    AlpacaDeviceCoverCalibrator::registerTasks(scheduler);
+    scheduler.every("covercalibrator.update", 20000, TASK_PRIORITY_HIGH, [this]() { update(); });
+  }
+  
   /**
    * @brief Set cover movement duration
    * @param durationMs Duration in milliseconds
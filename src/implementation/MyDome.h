@@ -511,6 +511,15 @@ public:
     checkHomeSensor();
   }
   
+  /**
+   * @brief Run update() from the task scheduler
+   * Simulated azimuth and shutter motion, every 20 ms
+   */
+  void registerTasks(TaskScheduler &scheduler) override {
+    AlpacaDeviceDome::registerTasks(scheduler);
+    scheduler.every("dome.update", 20000, TASK_PRIORITY_HIGH, [this]() { update(); });
+  }
+  
   /**
    * @brief Set azimuth rotation speed
    * @param degreesPerSecond Speed in degrees per second
@@ -201,6 +201,15 @@ public:
     updateMovement();
   }
   
+  /**
+   * @brief Run update() from the task scheduler
+   * Simulated wheel motion, every 20 ms
+   */
+  void registerTasks(TaskScheduler &scheduler) override {
+    AlpacaDeviceFilterWheel::registerTasks(scheduler);
+    scheduler.every("filterwheel.update", 20000, TASK_PRIORITY_HIGH, [this]() { update(); });
+  }
+  
   /**
    * @brief Check if filter wheel is currently moving
    * @return true if moving, false if stationary
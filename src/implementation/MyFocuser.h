@@ -335,6 +335,15 @@ public:
     }
   }
   
+  /**
+   * @brief Run update() from the task scheduler
+   * Stepper pulses are timed in microseconds, so run on every tick
+   */
+  void registerTasks(TaskScheduler &scheduler) override {
+    AlpacaDeviceFocuser::registerTasks(scheduler);
+    scheduler.every("focuser.update", 0, TASK_PRIORITY_CRITICAL, [this]() { update(); });
+  }
+  
   /**
    * @brief Get the target position
    * @return Target position during movement
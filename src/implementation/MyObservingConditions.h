@@ -503,6 +503,15 @@ public:
     }
   }
   
+  /**
+   * @brief Run update() from the task scheduler
+   * Sensor refresh check, every 100 ms (the refresh interval is applied by update())
+   */
+  void registerTasks(TaskScheduler &scheduler) override {
+    AlpacaDeviceObservingConditions::registerTasks(scheduler);
+    scheduler.every("observingconditions.update", 100000, TASK_PRIORITY_LOW, [this]() { update(); });
+  }
+  
   /**
    * @brief Set auto-refresh interval
    * @param intervalMs Interval in milliseconds
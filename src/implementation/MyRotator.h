@@ -324,6 +324,15 @@ public:
     updateMovement();
   }
   
+  /**
+   * @brief Run update() from the task scheduler
+   * Stepper pulses are timed in microseconds, so run on every tick
+   */
+  void registerTasks(TaskScheduler &scheduler) override {
+    AlpacaDeviceRotator::registerTasks(scheduler);
+    scheduler.every("rotator.update", 0, TASK_PRIORITY_CRITICAL, [this]() { update(); });
+  }
+  
   /**
    * @brief Get current position in degrees
    * @return Current position (0-360)
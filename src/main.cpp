@@ -1,6 +1,6 @@
 // You can also set default log level by defining macro (default: INFO)
 #define DEBUGLOG_DEFAULT_LOG_LEVEL_INFO
-#include "DebugLog.h"
+#include "Log_Filter.h"
 
 #include <Arduino.h>
 #include <ESP8266WiFi.h>
@@ -11,14 +11,19 @@
 #include <WiFiClient.h>
 // #include <ESPAsyncWebServer.h>
 #include <ESP8266mDNS.h>
-#include <EEPROM.h>
 
-#include "DebugLog.h"
+#include "Log_Filter.h"
 
 #include "alpaca_api/Alpaca_Errors.h"
 #include "alpaca_api/Alpaca_Management.h"
 #include "alpaca_api/Alpaca_Discovery.h"
+#include "Persistent_Store.h"
+#include "Task_Scheduler.h"
 #include "WiFi_Config.h"
+#include "Mqtt_Bridge.h"
+#include "Deferred_Log.h"
+#include "Metrics.h"
+#include "Loop_Profiler.h"
 // #include "Alpaca_Device_Focuser.h"
 #include "implementation/ArduinoFocuser.h"
 
@@ -28,6 +33,14 @@ const char *ssid;
 const char *password;
 const char *hostname = HOSTNAME;
 
+// Subsystems the headers declare extern
+PersistentStore persistentStore; // settings in flash
+TaskScheduler taskScheduler; // runs the loop's periodic work
+MqttBridge mqttBridge; // device state to an MQTT broker
+DeferredLog deferredLog; // log lines drained to Serial by the loop
+Metrics metrics; // counters for /metrics
+LoopProfiler loopProfiler; // CPU time per section, /debug/profile
+
 AsyncWebServer server(80); // default HTTP port for Alpaca API is 80
 
 AlpacaManagement *management = new AlpacaManagement();
@@ -39,21 +52,43 @@ ArduinoFocuser *focuser = nullptr;
 
 const int ledPin = 2; // GPIO2 is the built-in LED on most ESP8266 boards
 
+void startDiscovery()
+{
+  try
+  {
+    LOG_INFO("Start discovery->begin();");
+    discovery = new AlpacaDiscovery(80);
+    if (discovery->begin())
+    {
+      LOG_INFO("Alpaca Discovery initialized successfully");
+    }
+    else
+    {
+      LOG_ERROR("Failed to initialize Alpaca Discovery");
+    }
+  }
+  catch (const std::exception &e)
+  {
+    LOG_ERROR("Error in discovery: %s", e.what());
+  }
+}
+
 void setup()
 {
   LOG_INFO("Start Setup");
   pinMode(ledPin, OUTPUT);
   Serial.begin(115200);
-  EEPROM.begin(512);
+  deferredLog.begin(Serial);
+  persistentStore.begin();
   
-  // Load WiFi credentials from EEPROM (if available)
+  // Load WiFi credentials from the persistent store (if available)
   String wifiSSID;
   String wifiPassword;
   
-  if (wifiConfig.loadFromEEPROM() && wifiConfig.hasConfig()) {
+  if (wifiConfig.load() && wifiConfig.hasConfig()) {
     wifiSSID = wifiConfig.getSSID();
     wifiPassword = wifiConfig.getPassword();
-    LOG_INFO("Using WiFi credentials from EEPROM");
+    LOG_INFO("Using stored WiFi credentials");
   
   
   WiFi.mode(WIFI_STA);
@@ -73,7 +108,7 @@ void setup()
   }
 }
   else {
-    LOG_WARN("No valid WiFi credentials found in EEPROM. Please connect to the device's Access Point and configure WiFi settings.");
+    LOG_WARN("No valid WiFi credentials stored. Please connect to the device's Access Point and configure WiFi settings.");
     wifiSSID = ""; // Empty SSID will trigger AP mode
   }
   // Check if connection was successful
@@ -123,6 +158,10 @@ void setup()
 
     LOG_INFO("Start management->registerDevice(...);");
     management->registerDevice(server, focuser->GetDeviceName(), focuser->GetDeviceType(), focuser->GetDeviceNumber(), focuser);
+    focuser->enableEventStream(server); // position/temperature push at /api/v1/focuser/0/events
+    focuser->enableTemperatureDiagnostics(server); // filter stages at /debug/focuser/0/temperature
+    focuser->registerTasks(taskScheduler);
+    mqttBridge.addDevice(focuser); // focuser/0 in <prefix>/state
     LOG_INFO("Done management->registerDevice(...);");
   }
   catch (const std::exception &e)
@@ -143,35 +182,36 @@ void setup()
     LOG_ERROR("Error starting server: %s", e.what());
   }
 
-  // Start Alpaca Discovery - must be after WiFi is fully connected
-  try
-  {
-    LOG_INFO("Start discovery->begin();");
-    delay(100); // Small delay to ensure WiFi is stable
-    discovery = new AlpacaDiscovery(80);
-    if (discovery->begin())
+  // Start Alpaca Discovery - must be after WiFi is fully connected,
+  // 100 ms later to ensure WiFi is stable
+  taskScheduler.after("discovery.begin", 100000, TASK_PRIORITY_NORMAL, startDiscovery);
+  taskScheduler.every("discovery", 10000, TASK_PRIORITY_NORMAL, []() {
+    // Handle Alpaca Discovery requests
+    if (discovery != nullptr)
     {
-      LOG_INFO("Alpaca Discovery initialized successfully");
+      discovery->handleDiscovery();
     }
-    else
-    {
-      LOG_ERROR("Failed to initialize Alpaca Discovery");
-    }
-  }
-  catch (const std::exception &e)
-  {
-    LOG_ERROR("Error in discovery: %s", e.what());
-  }
+  });
+  // Publish device state to the configured MQTT broker (if any)
+  mqttBridge.begin(hostname);
+  mqttBridge.registerTasks(taskScheduler);
+  // Commit changed settings/position once per coalescing window
+  taskScheduler.every("store.flush", 100000, TASK_PRIORITY_LOW, []() { persistentStore.loop(); });
+  // Print deferred log records when there is time left over
+  deferredLog.registerTasks(taskScheduler);
+#if LOOP_PROFILER_REPORT_SECONDS > 0
+  // Per-task CPU time on the serial console, only if built with a report interval
+  taskScheduler.every("profiler.report", LOOP_PROFILER_REPORT_SECONDS * 1000000UL, TASK_PRIORITY_LOW,
+                      []() { loopProfiler.report(Serial); });
+#endif
 }
 
 void loop(void)
 {
- focuser->update(); // Update focuser state (handles movement and temperature compensation)
- 
-  // Handle Alpaca Discovery requests
-  if (discovery != nullptr)
-  {
-    discovery->handleDiscovery();
-  }
-  //delay(2); // Small delay to prevent watchdog timer issues
+  // Runs the device tasks (motion, temperature), discovery and persistence
+  static const int profile = loopProfiler.section("loop");
+  LoopProfilerScope cycles(profile);
+  uint32_t started = micros();
+  taskScheduler.tick();
+  metrics.observeLoop(micros() - started);
 }
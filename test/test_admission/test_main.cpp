@@ -0,0 +1,132 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "alpaca_api/Alpaca_Admission.h"
+
+/**
+ * @file test_main.cpp
+ * @brief AlpacaAdmission: token buckets per remote IP
+ *
+ * The limits are set to 1 token per second, a bucket of 5 and a command
+ * reserve of 2, so the few milliseconds a test takes refill nothing that
+ * matters.
+ */
+
+static const uint32_t RATE = 1;
+static const uint32_t BURST = 5;
+static const uint32_t RESERVE = 2;
+
+static AlpacaAdmission admission;
+
+static AsyncClient client(uint8_t host) {
+    return AsyncClient(IPAddress(192, 168, 1, host));
+}
+
+static bool read(uint8_t host, const String &query = String()) {
+    AsyncWebServerRequest request(HTTP_GET, "/api/v1/focuser/0/position" + query, String(), client(host));
+    return admission.admit(&request, "position", 8);
+}
+
+static bool command(uint8_t host) {
+    AsyncWebServerRequest request(HTTP_PUT, "/api/v1/focuser/0/move", "Position=100", client(host));
+    return admission.admit(&request, "move", 4);
+}
+
+static bool halt(uint8_t host) {
+    AsyncWebServerRequest request(HTTP_PUT, "/api/v1/focuser/0/halt", String(), client(host));
+    return admission.admit(&request, "halt", 4);
+}
+
+void setUp(void) {
+    admission = AlpacaAdmission();
+    admission.configure(RATE, BURST, RESERVE);
+}
+
+void tearDown(void) {}
+
+void test_classify(void) {
+    TEST_ASSERT_EQUAL(ALPACA_REQUEST_READ, AlpacaAdmission::classify("halt", 4, HTTP_GET));
+    TEST_ASSERT_EQUAL(ALPACA_REQUEST_CONTROL, AlpacaAdmission::classify("halt", 4, HTTP_PUT));
+    TEST_ASSERT_EQUAL(ALPACA_REQUEST_CONTROL, AlpacaAdmission::classify("abortslew", 9, HTTP_PUT));
+    TEST_ASSERT_EQUAL(ALPACA_REQUEST_COMMAND, AlpacaAdmission::classify("halted", 6, HTTP_PUT));
+    TEST_ASSERT_EQUAL(ALPACA_REQUEST_COMMAND, AlpacaAdmission::classify("move", 4, HTTP_PUT));
+}
+
+void test_reads_leave_the_command_reserve(void) {
+    for (uint32_t i = 0; i < BURST - RESERVE; i++) {
+        TEST_ASSERT_TRUE(read(10));
+    }
+    TEST_ASSERT_FALSE(read(10));
+    // The reserve is still there for commands
+    for (uint32_t i = 0; i < RESERVE; i++) {
+        TEST_ASSERT_TRUE(command(10));
+    }
+    TEST_ASSERT_FALSE(command(10));
+    // A stop is never throttled
+    TEST_ASSERT_TRUE(halt(10));
+    TEST_ASSERT_EQUAL_UINT32(BURST, admission.admittedCount());
+    TEST_ASSERT_EQUAL_UINT32(2, admission.throttledCount());
+    TEST_ASSERT_EQUAL_UINT32(1, admission.controlCount());
+}
+
+void test_rotating_client_id_shares_the_bucket(void) {
+    uint32_t admitted = 0;
+    for (int id = 1; id <= 20; id++) {
+        admitted += read(10, "?ClientID=" + String(id) + "&ClientTransactionID=" + String(id)) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL_UINT32(BURST - RESERVE, admitted);
+    TEST_ASSERT_EQUAL_UINT32(1, admission.clientCount());
+}
+
+void test_clients_have_separate_buckets(void) {
+    while (read(10)) {
+    }
+    TEST_ASSERT_TRUE(read(11));
+    TEST_ASSERT_EQUAL_UINT32(2, admission.clientCount());
+}
+
+void test_eviction_does_not_refill(void) {
+    // Fill the table, then keep adding clients that evict the oldest
+    for (uint8_t host = 1; host <= ALPACA_ADMISSION_MAX_CLIENTS; host++) {
+        TEST_ASSERT_TRUE(read(host));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, admission.evictedCount());
+    uint32_t churnReads = 0;
+    for (uint8_t host = 1; host <= 3 * ALPACA_ADMISSION_MAX_CLIENTS; host++) {
+        churnReads += read(100 + host % (ALPACA_ADMISSION_MAX_CLIENTS + 1)) ? 1 : 0;
+    }
+    // Buckets replacing evicted ones start with the command reserve only
+    TEST_ASSERT_EQUAL_UINT32(0, churnReads);
+    TEST_ASSERT_TRUE(admission.evictedCount() > 0);
+    TEST_ASSERT_EQUAL_UINT32(ALPACA_ADMISSION_MAX_CLIENTS, admission.clientCount());
+    // ...which still lets such a client send a command
+    TEST_ASSERT_TRUE(command(200));
+}
+
+void test_bucket_refills_over_time(void) {
+    while (read(10)) {
+    }
+    delay(1100 / RATE);
+    TEST_ASSERT_TRUE(read(10));
+    TEST_ASSERT_FALSE(read(10));
+}
+
+void test_rate_zero_disables_limiting(void) {
+    admission.configure(0, BURST, RESERVE);
+    TEST_ASSERT_FALSE(admission.enabled());
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_TRUE(read(10));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, admission.throttledCount());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_classify);
+    RUN_TEST(test_reads_leave_the_command_reserve);
+    RUN_TEST(test_rotating_client_id_shares_the_bucket);
+    RUN_TEST(test_clients_have_separate_buckets);
+    RUN_TEST(test_eviction_does_not_refill);
+    RUN_TEST(test_bucket_refills_over_time);
+    RUN_TEST(test_rate_zero_disables_limiting);
+    return UNITY_END();
+}
@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+"""
+MQTT Telemetry Test Script
+
+This script stands in for a local mosquitto broker: it accepts one MQTT
+3.1.1 client (the board, or the native build), acknowledges the connection
+and pings, and prints every PUBLISH it receives. It checks that the bridge
+announces itself on <prefix>/status and publishes JSON state payloads on
+<prefix>/state.
+
+Usage:
+    python test_mqtt.py [--port 1883] [--timeout 10] [--min-states 2]
+
+Point the board at this machine on the focuser setup page (MQTT Broker
+Host), or run the native build with a compiled-in broker:
+    build_flags = -DMQTT_BRIDGE_DEFAULT_HOST=\\"127.0.0.1\\"
+"""
+
+import socket
+import json
+import argparse
+import sys
+import time
+
+CONNECT, CONNACK, PUBLISH, PINGREQ, PINGRESP, DISCONNECT = 1, 2, 3, 12, 13, 14
+
+
+def read_exact(conn, length):
+    """Read exactly length bytes or raise ConnectionError."""
+    data = b''
+    while len(data) < length:
+        chunk = conn.recv(length - len(data))
+        if not chunk:
+            raise ConnectionError('client closed the connection')
+        data += chunk
+    return data
+
+
+def read_packet(conn):
+    """
+    Read one MQTT control packet.
+
+    Returns:
+        (packet type, flags, body bytes)
+    """
+    header = read_exact(conn, 1)[0]
+    length, multiplier = 0, 1
+    while True:
+        digit = read_exact(conn, 1)[0]
+        length += (digit & 0x7F) * multiplier
+        multiplier *= 128
+        if not digit & 0x80:
+            break
+    return header >> 4, header & 0x0F, read_exact(conn, length)
+
+
+def read_string(body, offset):
+    """Read a length-prefixed UTF-8 string, return (string, next offset)."""
+    length = int.from_bytes(body[offset:offset + 2], 'big')
+    return body[offset + 2:offset + 2 + length].decode(), offset + 2 + length
+
+
+def parse_connect(body):
+    """Return client id and will topic/message of a CONNECT packet."""
+    protocol, offset = read_string(body, 0)
+    level, flags = body[offset], body[offset + 1]
+    offset += 4  # level, flags, keep alive
+    client_id, offset = read_string(body, offset)
+    will_topic = will_message = None
+    if flags & 0x04:
+        will_topic, offset = read_string(body, offset)
+        will_message, offset = read_string(body, offset)
+    return {
+        'protocol': f"{protocol} level {level}",
+        'client_id': client_id,
+        'will_topic': will_topic,
+        'will_message': will_message,
+    }
+
+
+def run_broker(port=1883, timeout=10, min_states=2):
+    """
+    Accept one client and collect its publishes.
+
+    Args:
+        port: TCP port to listen on
+        timeout: How long to collect publishes (seconds)
+        min_states: State payloads to wait for before finishing early
+
+    Returns:
+        (connect info, list of (topic, payload, retained))
+    """
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(('', port))
+    server.listen(1)
+    server.settimeout(timeout)
+
+    print(f"Listening for MQTT clients on port {port}")
+    print(f"Waiting {timeout} seconds for the bridge...\n")
+
+    info, messages = None, []
+    deadline = time.time() + timeout
+    try:
+        conn, addr = server.accept()
+    except socket.timeout:
+        server.close()
+        return info, messages
+
+    try:
+        while time.time() < deadline:
+            conn.settimeout(max(0.1, deadline - time.time()))
+            try:
+                kind, flags, body = read_packet(conn)
+            except socket.timeout:
+                break
+
+            if kind == CONNECT:
+                info = parse_connect(body)
+                print(f"✓ CONNECT from {addr[0]}: client id '{info['client_id']}' ({info['protocol']})")
+                print(f"  Last will: {info['will_topic']} = {info['will_message']}\n")
+                conn.sendall(bytes([CONNACK << 4, 2, 0, 0]))
+            elif kind == PUBLISH:
+                topic, offset = read_string(body, 0)
+                if (flags >> 1) & 0x03:
+                    offset += 2  # packet id, QoS > 0
+                payload = body[offset:].decode()
+                retained = bool(flags & 0x01)
+                messages.append((topic, payload, retained))
+                print(f"  {topic}{' (retained)' if retained else ''}: {payload}")
+                states = [m for m in messages if m[0].endswith('/state')]
+                if len(states) >= min_states:
+                    break
+            elif kind == PINGREQ:
+                conn.sendall(bytes([PINGRESP << 4, 0]))
+            elif kind == DISCONNECT:
+                print("  Client disconnected")
+                break
+    except ConnectionError as e:
+        print(f"⚠ {e}")
+    finally:
+        conn.close()
+        server.close()
+
+    return info, messages
+
+
+def check(info, messages):
+    """Validate the bridge's topics and payloads, return a list of errors."""
+    errors = []
+    if info is None:
+        return ['no client connected']
+    if not info['will_topic'] or not info['will_topic'].endswith('/status') or info['will_message'] != 'offline':
+        errors.append('last will is not <prefix>/status = offline')
+
+    status = [m for m in messages if m[0].endswith('/status')]
+    if not status or status[0][1] != 'online' or not status[0][2]:
+        errors.append('no retained "online" on <prefix>/status')
+
+    states = [m for m in messages if m[0].endswith('/state')]
+    if not states:
+        errors.append('no payload on <prefix>/state')
+    for topic, payload, retained in states:
+        try:
+            devices = json.loads(payload)
+        except json.JSONDecodeError as e:
+            errors.append(f"invalid JSON on {topic}: {e}")
+            continue
+        if not isinstance(devices, dict) or not all(isinstance(v, dict) and v for v in devices.values()):
+            errors.append(f"payload is not {{device: {{property: value}}}}: {payload}")
+    if states:
+        # The first payload after connecting carries the full state
+        first = json.loads(states[0][1]) if states[0][1].startswith('{') else {}
+        focuser = first.get('focuser/0')
+        if focuser is not None and not {'Position', 'IsMoving', 'Temperature'} <= set(focuser):
+            errors.append('first focuser/0 payload is not the full state')
+    return errors
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Test the MQTT telemetry bridge against a stand-in broker',
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  # Listen on the standard MQTT port
+  python test_mqtt.py
+
+  # Use an unprivileged port and wait for more payloads
+  python test_mqtt.py --port 18830 --min-states 5 --timeout 30
+        """
+    )
+    parser.add_argument(
+        '--port',
+        type=int,
+        default=1883,
+        help='TCP port to listen on (default: 1883)'
+    )
+    parser.add_argument(
+        '--timeout',
+        type=int,
+        default=10,
+        help='Timeout in seconds to wait for the bridge (default: 10)'
+    )
+    parser.add_argument(
+        '--min-states',
+        type=int,
+        default=2,
+        help='State payloads to collect before finishing (default: 2)'
+    )
+
+    args = parser.parse_args()
+
+    print("=" * 60)
+    print("MQTT Telemetry Test")
+    print("=" * 60)
+    print()
+
+    info, messages = run_broker(port=args.port, timeout=args.timeout, min_states=args.min_states)
+    errors = check(info, messages)
+
+    print()
+    print("=" * 60)
+    print(f"Received {len(messages)} publish(es).")
+    print("=" * 60)
+
+    if errors:
+        print("\n✗ MQTT bridge check failed:")
+        for error in errors:
+            print(f"  - {error}")
+        print("\nTroubleshooting:")
+        print("  1. Check the broker host/port on the focuser setup page")
+        print("  2. Check that the TCP port is not blocked by a firewall")
+        print("  3. Check the device's serial output for 'MQTT' messages")
+        return 1
+
+    print("\n✓ MQTT bridge publishes status and state as expected")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
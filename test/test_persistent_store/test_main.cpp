@@ -0,0 +1,225 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "Persistent_Store.h"
+
+/**
+ * @file test_main.cpp
+ * @brief PersistentStore on the shim's RAM flash
+ *
+ * A new PersistentStore on the same flash stands in for a restart.
+ */
+
+static const uint32_t FIRST_SECTOR = PERSISTENT_STORE_FIRST_SECTOR;
+
+static void eraseFlash() {
+    ESP.flashFailAfter(-1);
+    for (uint32_t sector = 0; sector < NATIVE_SHIM_FLASH_SECTORS; sector++) {
+        ESP.flashEraseSector(sector);
+    }
+}
+
+static int32_t storedPosition(PersistentStore &store) {
+    int32_t position = -1;
+    store.get(STORE_KEY_STEPPER_POSITION, position);
+    return position;
+}
+
+void setUp(void) {
+    eraseFlash();
+}
+
+void tearDown(void) {
+    ESP.flashFailAfter(-1);
+}
+
+void test_values_survive_restart(void) {
+    {
+        PersistentStore store;
+        store.begin();
+        store.put(STORE_KEY_STEPPER_POSITION, (int32_t)1234);
+        store.putString(STORE_KEY_WIFI_SSID, "observatory");
+        TEST_ASSERT_TRUE(store.commit());
+    }
+    PersistentStore store;
+    store.begin();
+    TEST_ASSERT_EQUAL_INT32(1234, storedPosition(store));
+    String ssid;
+    TEST_ASSERT_TRUE(store.getString(STORE_KEY_WIFI_SSID, ssid));
+    TEST_ASSERT_EQUAL_STRING("observatory", ssid.c_str());
+    // get() wants the exact length
+    int16_t narrow;
+    TEST_ASSERT_FALSE(store.get(STORE_KEY_STEPPER_POSITION, narrow));
+}
+
+void test_unchanged_value_is_not_written(void) {
+    PersistentStore store;
+    store.begin();
+    store.put(STORE_KEY_STEPPER_POSITION, (int32_t)10);
+    store.commit();
+    size_t logged = store.logBytes();
+    store.put(STORE_KEY_STEPPER_POSITION, (int32_t)10);
+    TEST_ASSERT_FALSE(store.isDirty());
+    store.put(STORE_KEY_STEPPER_POSITION, (int32_t)11);
+    store.put(STORE_KEY_STEPPER_POSITION, (int32_t)12);
+    store.commit();
+    // Two puts in one window append one record: 4-byte head + 4 bytes of data
+    TEST_ASSERT_EQUAL_UINT32(logged + 8, store.logBytes());
+}
+
+void test_removed_key_stays_removed(void) {
+    {
+        PersistentStore store;
+        store.begin();
+        store.putString(STORE_KEY_MQTT_HOST, "broker.local");
+        store.commit();
+        store.remove(STORE_KEY_MQTT_HOST);
+        store.commit();
+    }
+    PersistentStore store;
+    store.begin();
+    String host;
+    TEST_ASSERT_FALSE(store.getString(STORE_KEY_MQTT_HOST, host));
+}
+
+void test_compaction_rotates_through_the_ring(void) {
+    PersistentStore store;
+    store.begin();
+    store.putString(STORE_KEY_WIFI_SSID, "observatory");
+    unsigned long erases = store.eraseCount();
+    int32_t position = 0;
+    while (store.eraseCount() < erases + PERSISTENT_STORE_SECTORS) {
+        store.put(STORE_KEY_STEPPER_POSITION, ++position);
+        TEST_ASSERT_TRUE(store.commit());
+    }
+    // Every sector of the ring was erased once, none twice
+    TEST_ASSERT_EQUAL_UINT32(erases + PERSISTENT_STORE_SECTORS, store.eraseCount());
+
+    PersistentStore restarted;
+    restarted.begin();
+    TEST_ASSERT_EQUAL_INT32(position, storedPosition(restarted));
+    String ssid;
+    TEST_ASSERT_TRUE(restarted.getString(STORE_KEY_WIFI_SSID, ssid));
+    TEST_ASSERT_EQUAL_STRING("observatory", ssid.c_str());
+}
+
+void test_power_loss_during_compaction_keeps_values(void) {
+    PersistentStore store;
+    store.begin();
+    store.putString(STORE_KEY_WIFI_SSID, "observatory");
+    int32_t position = 0;
+    unsigned long erases = store.eraseCount();
+    // Fill the log up to the commit that will compact it
+    while (true) {
+        store.put(STORE_KEY_STEPPER_POSITION, ++position);
+        if (store.logBytes() + 8 > SPI_FLASH_SEC_SIZE) {
+            break;
+        }
+        store.commit();
+    }
+    TEST_ASSERT_EQUAL_UINT32(erases, store.eraseCount());
+    // Power fails right after the spare sector is erased, before any record lands
+    ESP.flashFailAfter(1);
+    TEST_ASSERT_FALSE(store.commit());
+    ESP.flashFailAfter(-1);
+
+    PersistentStore restarted;
+    restarted.begin();
+    // The last committed value, not the one lost with the power
+    TEST_ASSERT_EQUAL_INT32(position - 1, storedPosition(restarted));
+    String ssid;
+    TEST_ASSERT_TRUE(restarted.getString(STORE_KEY_WIFI_SSID, ssid));
+    TEST_ASSERT_EQUAL_STRING("observatory", ssid.c_str());
+}
+
+void test_power_loss_before_header_keeps_values(void) {
+    PersistentStore store;
+    store.begin();
+    store.putString(STORE_KEY_WIFI_SSID, "observatory");
+    int32_t position = 0;
+    while (true) {
+        store.put(STORE_KEY_STEPPER_POSITION, ++position);
+        if (store.logBytes() + 8 > SPI_FLASH_SEC_SIZE) {
+            break;
+        }
+        store.commit();
+    }
+    // Erase and both records succeed, the header write does not
+    ESP.flashFailAfter(3);
+    TEST_ASSERT_FALSE(store.commit());
+    ESP.flashFailAfter(-1);
+
+    PersistentStore restarted;
+    restarted.begin();
+    TEST_ASSERT_EQUAL_INT32(position - 1, storedPosition(restarted));
+
+    // The retried commit completes the compaction
+    TEST_ASSERT_TRUE(store.isDirty());
+    TEST_ASSERT_TRUE(store.commit());
+    PersistentStore compacted;
+    compacted.begin();
+    TEST_ASSERT_EQUAL_INT32(position, storedPosition(compacted));
+}
+
+void test_corrupt_record_ends_log(void) {
+    size_t corrupt;
+    {
+        PersistentStore store;
+        store.begin();
+        store.put(STORE_KEY_STEPPER_MODE, (uint8_t)3);
+        store.commit();
+        corrupt = store.logBytes();
+        store.put(STORE_KEY_STEPPER_POSITION, (int32_t)500);
+        store.commit();
+    }
+    // Clear bits in the data of the last record, as a torn write would
+    uint32_t zero = 0;
+    ESP.flashWrite(FIRST_SECTOR * SPI_FLASH_SEC_SIZE + corrupt + 4, &zero, 4);
+
+    PersistentStore store;
+    store.begin();
+    uint8_t mode = 0;
+    TEST_ASSERT_TRUE(store.get(STORE_KEY_STEPPER_MODE, mode));
+    TEST_ASSERT_EQUAL_UINT8(3, mode);
+    TEST_ASSERT_EQUAL_INT32(-1, storedPosition(store));
+    // The damaged log is compacted away on the next commit
+    TEST_ASSERT_TRUE(store.isDirty());
+    unsigned long erases = store.eraseCount();
+    TEST_ASSERT_TRUE(store.commit());
+    TEST_ASSERT_EQUAL_UINT32(erases + 1, store.eraseCount());
+}
+
+void test_single_sector_log_is_imported(void) {
+    // Log of the earlier single-sector store in the EEPROM sector: "APS1",
+    // then key 1 length 4 with its CRC-16 and the position 777
+    uint8_t data[4] = {0x09, 0x03, 0x00, 0x00};
+    uint8_t head[2] = {STORE_KEY_STEPPER_POSITION, 4};
+    uint16_t crc = 0xFFFF;
+    for (uint8_t byte : {head[0], head[1], data[0], data[1], data[2], data[3]}) {
+        crc ^= (uint16_t)byte << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    uint32_t log[3] = {0x31535041, (uint32_t)head[0] | head[1] << 8 | (uint32_t)crc << 16, 777};
+    ESP.flashWrite(PERSISTENT_STORE_LAST_SECTOR * SPI_FLASH_SEC_SIZE, log, sizeof(log));
+
+    PersistentStore store;
+    store.begin();
+    TEST_ASSERT_EQUAL_INT32(777, storedPosition(store));
+    PersistentStore restarted;
+    restarted.begin();
+    TEST_ASSERT_EQUAL_INT32(777, storedPosition(restarted));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_values_survive_restart);
+    RUN_TEST(test_unchanged_value_is_not_written);
+    RUN_TEST(test_removed_key_stays_removed);
+    RUN_TEST(test_compaction_rotates_through_the_ring);
+    RUN_TEST(test_power_loss_during_compaction_keeps_values);
+    RUN_TEST(test_power_loss_before_header_keeps_values);
+    RUN_TEST(test_corrupt_record_ends_log);
+    RUN_TEST(test_single_sector_log_is_imported);
+    return UNITY_END();
+}
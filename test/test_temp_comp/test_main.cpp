@@ -0,0 +1,127 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "Persistent_Store.h"
+#include "implementation/ArduinoFocuser_TempComp.h"
+
+/**
+ * @file test_main.cpp
+ * @brief FocuserTempComp: least squares fit, reference, deadband and cap
+ */
+
+PersistentStore persistentStore;
+
+static void eraseFlash() {
+    for (uint32_t sector = 0; sector < NATIVE_SHIM_FLASH_SECTORS; sector++) {
+        ESP.flashEraseSector(sector);
+    }
+}
+
+void setUp(void) {
+    eraseFlash();
+    persistentStore = PersistentStore();
+    persistentStore.begin();
+}
+
+void tearDown(void) {}
+
+void test_default_coefficient_until_fitted(void) {
+    FocuserTempComp model;
+    model.begin();
+    TEST_ASSERT_FALSE(model.fitted());
+    TEST_ASSERT_EQUAL_FLOAT(TEMPCOMP_DEFAULT_STEPS_PER_C, model.coefficient());
+    // Enough samples, but all at one temperature: the slope is undetermined
+    model.record(15.0f, 1000);
+    model.record(15.0f, 1010);
+    model.record(15.0f, 1020);
+    TEST_ASSERT_FALSE(model.fitted());
+    TEST_ASSERT_EQUAL_FLOAT(TEMPCOMP_DEFAULT_STEPS_PER_C, model.coefficient());
+}
+
+void test_least_squares_slope(void) {
+    FocuserTempComp model;
+    // position = 2000 - 12 * temperature
+    model.record(10.0f, 1880);
+    model.record(5.0f, 1940);
+    model.record(0.0f, 2000);
+    TEST_ASSERT_TRUE(model.fitted());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -12.0, model.coefficient());
+    // Scattered samples: the slope of the best fit line
+    model.reset();
+    model.record(0.0f, 100);
+    model.record(1.0f, 110);
+    model.record(2.0f, 130);
+    model.record(3.0f, 130);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 11.0, model.coefficient());
+}
+
+void test_oldest_sample_drops_out(void) {
+    FocuserTempComp model;
+    // A stray sample, then a full buffer on the line position = 500 + 4 * temperature
+    model.record(20.0f, 0);
+    for (int i = 0; i < TEMPCOMP_SAMPLES; i++) {
+        float temperature = (float)(i % 8);
+        model.record(temperature, 500 + 4 * (long)temperature);
+    }
+    TEST_ASSERT_EQUAL_UINT8(TEMPCOMP_SAMPLES, model.sampleCount());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 4.0, model.coefficient());
+}
+
+void test_samples_survive_restart(void) {
+    {
+        FocuserTempComp model;
+        model.record(10.0f, 1880);
+        model.record(5.0f, 1940);
+        model.record(0.0f, 2000);
+    }
+    FocuserTempComp model;
+    model.begin();
+    TEST_ASSERT_EQUAL_UINT8(3, model.sampleCount());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -12.0, model.coefficient());
+}
+
+void test_no_correction_without_reference(void) {
+    FocuserTempComp model;
+    long target = -1;
+    TEST_ASSERT_FALSE(model.correction(0.0f, 1000, target));
+    model.setReference(10.0f, 1000);
+    model.clearReference();
+    TEST_ASSERT_FALSE(model.correction(0.0f, 1000, target));
+}
+
+void test_deadband(void) {
+    FocuserTempComp model; // default coefficient
+    model.setReference(10.0f, 1000);
+    long target = -1;
+    float inside = 10.0f + (TEMPCOMP_DEADBAND_STEPS - 0.5f) / TEMPCOMP_DEFAULT_STEPS_PER_C;
+    TEST_ASSERT_FALSE(model.correction(inside, 1000, target));
+    float outside = 10.0f + (TEMPCOMP_DEADBAND_STEPS + 1.0f) / TEMPCOMP_DEFAULT_STEPS_PER_C;
+    TEST_ASSERT_TRUE(model.correction(outside, 1000, target));
+    TEST_ASSERT_EQUAL_INT32(1000 + TEMPCOMP_DEADBAND_STEPS + 1, target);
+    // Already there: nothing to do
+    TEST_ASSERT_FALSE(model.correction(outside, target, target));
+}
+
+void test_correction_capped_at_reference(void) {
+    FocuserTempComp model;
+    model.setReference(10.0f, 1000);
+    long target = -1;
+    // Far beyond the cap: the target stops at reference + cap...
+    TEST_ASSERT_TRUE(model.correction(110.0f, 1000, target));
+    TEST_ASSERT_EQUAL_INT32(1000 + TEMPCOMP_MAX_CORRECTION_STEPS, target);
+    // ...and repeated corrections do not walk past it
+    TEST_ASSERT_FALSE(model.correction(110.0f, target, target));
+    TEST_ASSERT_TRUE(model.correction(-90.0f, 1000 + TEMPCOMP_MAX_CORRECTION_STEPS, target));
+    TEST_ASSERT_EQUAL_INT32(1000 - TEMPCOMP_MAX_CORRECTION_STEPS, target);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_default_coefficient_until_fitted);
+    RUN_TEST(test_least_squares_slope);
+    RUN_TEST(test_oldest_sample_drops_out);
+    RUN_TEST(test_samples_survive_restart);
+    RUN_TEST(test_no_correction_without_reference);
+    RUN_TEST(test_deadband);
+    RUN_TEST(test_correction_capped_at_reference);
+    return UNITY_END();
+}
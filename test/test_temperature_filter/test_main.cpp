@@ -0,0 +1,122 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "implementation/ArduinoFocuser_TempFilter.h"
+
+/**
+ * @file test_main.cpp
+ * @brief TemperatureFilter: outliers, median, rate limit and EMA
+ */
+
+static const unsigned long READING_MS = 2000;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_first_reading_sets_every_stage(void) {
+    TemperatureFilter filter;
+    TEST_ASSERT_FALSE(filter.ready());
+    TEST_ASSERT_TRUE(filter.add(12.34f, 0));
+    TEST_ASSERT_TRUE(filter.ready());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.34f, filter.medianValue());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.34f, filter.limitedValue());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.34f, filter.value());
+}
+
+void test_single_outlier_is_dropped(void) {
+    TemperatureFilter filter;
+    unsigned long now = 0;
+    filter.add(10.0f, now);
+    TEST_ASSERT_FALSE(filter.add(85.0f, now += READING_MS));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 85.0f, filter.raw());
+    TEST_ASSERT_TRUE(filter.add(10.0f, now += READING_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, filter.outlierCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.0f, filter.value());
+}
+
+void test_sustained_jump_restarts(void) {
+    TemperatureFilter filter;
+    unsigned long now = 0;
+    filter.add(10.0f, now);
+    for (int i = 1; i < TEMP_FILTER_MEDIAN; i++) {
+        TEST_ASSERT_FALSE(filter.add(20.0f, now += READING_MS));
+    }
+    // The TEMP_FILTER_MEDIAN-th reading in a row is taken as real
+    TEST_ASSERT_TRUE(filter.add(20.0f, now += READING_MS));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.0f, filter.value());
+}
+
+void test_median_ignores_a_spike_within_range(void) {
+    TemperatureFilter filter;
+    unsigned long now = 0;
+    filter.add(10.0f, now);
+    filter.add(10.0f, now += READING_MS);
+    filter.add(10.0f, now += READING_MS);
+    // Within the outlier range, so accepted, but outvoted by the median
+    TEST_ASSERT_TRUE(filter.add(11.5f, now += READING_MS));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.0f, filter.medianValue());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.0f, filter.value());
+}
+
+void test_rate_limit_is_exact(void) {
+    TemperatureFilter filter;
+    unsigned long now = 0;
+    filter.add(10.0f, now);
+    // A step of 2 °C, read every 2 s for one minute
+    for (int i = 0; i < 30; i++) {
+        filter.add(12.0f, now += READING_MS);
+        // Never ahead of the configured rate
+        float allowed = 10.0f + TEMP_FILTER_MAX_RATE_CENTI_PER_MIN / 100.0f * now / 60000.0f;
+        TEST_ASSERT_TRUE(filter.limitedValue() <= allowed + 0.001f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.0f + TEMP_FILTER_MAX_RATE_CENTI_PER_MIN / 100.0f, filter.limitedValue());
+    TEST_ASSERT_TRUE(filter.rateLimitedCount() > 0);
+}
+
+void test_quiet_spell_does_not_save_up_rate(void) {
+    TemperatureFilter filter;
+    unsigned long now = 0;
+    filter.add(10.0f, now);
+    filter.add(10.0f, now += 600000);
+    filter.add(11.0f, now += READING_MS);
+    filter.add(11.0f, now += READING_MS);
+    // Ten quiet minutes allow no more than the rate over the last 4 s
+    float allowed = 10.0f + TEMP_FILTER_MAX_RATE_CENTI_PER_MIN / 100.0f * 2 * READING_MS / 60000.0f;
+    TEST_ASSERT_TRUE(filter.limitedValue() <= allowed + 0.011f);
+}
+
+void test_ema_converges(void) {
+    TemperatureFilter filter;
+    unsigned long now = 0;
+    filter.add(10.0f, now);
+    filter.add(10.5f, now += 60000);
+    filter.add(10.5f, now += 60000);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.5f, filter.limitedValue());
+    TEST_ASSERT_TRUE(filter.value() > 10.0f && filter.value() < 10.5f);
+    for (int i = 0; i < 40; i++) {
+        filter.add(10.5f, now += READING_MS);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.5f, filter.value());
+}
+
+void test_reset_starts_over(void) {
+    TemperatureFilter filter;
+    filter.add(10.0f, 0);
+    filter.reset();
+    TEST_ASSERT_FALSE(filter.ready());
+    filter.add(30.0f, READING_MS);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 30.0f, filter.value());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_reading_sets_every_stage);
+    RUN_TEST(test_single_outlier_is_dropped);
+    RUN_TEST(test_sustained_jump_restarts);
+    RUN_TEST(test_median_ignores_a_spike_within_range);
+    RUN_TEST(test_rate_limit_is_exact);
+    RUN_TEST(test_quiet_spell_does_not_save_up_rate);
+    RUN_TEST(test_ema_converges);
+    RUN_TEST(test_reset_starts_over);
+    return UNITY_END();
+}
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""
+Embed Web Assets
+
+Compresses the pages in web/ with gzip and writes them as PROGMEM byte
+arrays into C++ headers, so the firmware can serve them straight from flash
+with Content-Encoding: gzip (see alpaca_api/Alpaca_Setup_Page.h).
+
+Runs as a PlatformIO pre-build script (extra_scripts in platformio.ini) and
+can be run by hand:
+
+Usage:
+    python tools/embed_web_assets.py
+
+Headers are only rewritten when their content changes, and the gzip stream
+carries no timestamp, so the output is reproducible.
+"""
+
+import gzip
+import hashlib
+import os
+
+# (source page, generated header, C identifier, content type)
+ASSETS = [
+    ('web/focuser_setup.html', 'src/implementation/ArduinoFocuser_Setup_Page.h',
+     'ARDUINO_FOCUSER_SETUP_PAGE', 'text/html'),
+]
+
+
+def render_header(source, name, content_type, data):
+    """Return the header text for one compressed asset."""
+    compressed = gzip.compress(data, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(data).hexdigest()[:16]
+    lines = [
+        f"// Generated by tools/embed_web_assets.py from {source} - do not edit",
+        f"#ifndef {name}_H",
+        f"#define {name}_H",
+        "",
+        "#include <Arduino.h>",
+        '#include "alpaca_api/Alpaca_Setup_Page.h"',
+        "",
+        f"// {len(data)} bytes, {len(compressed)} bytes gzipped",
+        f"static const uint8_t {name}_GZ[] PROGMEM = {{",
+    ]
+    for offset in range(0, len(compressed), 16):
+        chunk = compressed[offset:offset + 16]
+        lines.append("  " + ", ".join(f"0x{b:02x}" for b in chunk) + ",")
+    lines += [
+        "};",
+        "",
+        f"static const AlpacaSetupAsset {name} = {{{name}_GZ, sizeof({name}_GZ), "
+        f"\"{content_type}\", \"\\\"{etag}\\\"\"}};",
+        "",
+        f"#endif // {name}_H",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def embed_all(root):
+    """Regenerate every asset header below root, return the number rewritten."""
+    written = 0
+    for source, header, name, content_type in ASSETS:
+        with open(os.path.join(root, source), 'rb') as f:
+            text = render_header(source, name, content_type, f.read())
+        path = os.path.join(root, header)
+        if os.path.exists(path):
+            with open(path, 'r', encoding='utf-8') as f:
+                if f.read() == text:
+                    continue
+        with open(path, 'w', encoding='utf-8', newline='\n') as f:
+            f.write(text)
+        print(f"Embedded {source} -> {header}")
+        written += 1
+    return written
+
+
+try:
+    Import("env")  # noqa: F821 - defined when run by PlatformIO
+    embed_all(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == '__main__':
+        embed_all(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))